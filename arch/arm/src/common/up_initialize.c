@@ -44,6 +44,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/sched_profile.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/drivers/drivers.h>
 #include <nuttx/fs/loop.h>
@@ -226,6 +227,10 @@ void up_initialize(void)
   note_register();      /* Non-standard /dev/note */
 #endif
 
+#if defined(CONFIG_DRIVER_PROFILE)
+  profile_register();   /* Non-standard /dev/profile */
+#endif
+
   /* Initialize the serial device driver */
 
 #ifdef USE_SERIALDRIVER
@@ -60,3 +60,19 @@ bool up_interrupt_context(void)
 {
   return CURRENT_REGS != NULL;
 }
+
+/****************************************************************************
+ * Name: up_profile_pc
+ *
+ * Description: Return the program counter interrupted by the system timer
+ * interrupt for the sampling profiler.
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE
+uintptr_t up_profile_pc(void)
+{
+  FAR volatile uint32_t *regs = CURRENT_REGS;
+
+  return regs != NULL ? (uintptr_t)regs[REG_PC] : 0;
+}
+#endif
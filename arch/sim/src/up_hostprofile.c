@@ -0,0 +1,123 @@
+/****************************************************************************
+ * arch/sim/src/up_hostprofile.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#define _GNU_SOURCE 1
+
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/time.h>
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+void sched_profile_sample(uintptr_t pc);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_profile_handler
+ *
+ * Description:
+ *   SIGPROF handler.  The simulation processes the system timer only from
+ *   the IDLE loop, so the timer tick cannot see what the tasks are doing.
+ *   Instead, the host profiling timer interrupts whatever is running and
+ *   the interrupted program counter is taken from the signal context.
+ *
+ ****************************************************************************/
+
+static void up_profile_handler(int signo, siginfo_t *info, void *context)
+{
+  ucontext_t *uc = (ucontext_t *)context;
+  uintptr_t pc = 0;
+
+#if defined(__linux__) && defined(__x86_64__)
+  pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__linux__) && defined(__i386__)
+  pc = (uintptr_t)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__linux__) && defined(__arm__)
+  pc = (uintptr_t)uc->uc_mcontext.arm_pc;
+#elif defined(__APPLE__) && defined(__x86_64__)
+  pc = (uintptr_t)uc->uc_mcontext->__ss.__rip;
+#else
+  (void)uc;
+#endif
+
+  sched_profile_sample(pc);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_profile_start
+ *
+ * Description:
+ *   Start the host profiling timer.  It expires each usec microseconds of
+ *   CPU time consumed by the simulation, so time spent sleeping in the IDLE
+ *   loop is not sampled.
+ *
+ ****************************************************************************/
+
+int up_profile_start(unsigned int usec)
+{
+  struct sigaction act;
+  struct itimerval timer;
+
+  memset(&act, 0, sizeof(act));
+  act.sa_sigaction = up_profile_handler;
+  act.sa_flags     = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&act.sa_mask);
+
+  if (sigaction(SIGPROF, &act, NULL) < 0)
+    {
+      return -1;
+    }
+
+  timer.it_interval.tv_sec  = usec / 1000000;
+  timer.it_interval.tv_usec = usec % 1000000;
+  timer.it_value            = timer.it_interval;
+
+  return setitimer(ITIMER_PROF, &timer, NULL);
+}
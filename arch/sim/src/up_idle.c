@@ -171,7 +171,13 @@ void up_idle(void)
    * correct rate.
    */
 
+#if defined(CONFIG_ONESHOT) && defined(CONFIG_SIM_WALLTIME)
+  /* The host clock oneshot timer may expire while we wait */
+
+  up_oneshot_idle(1000000 / CLK_TCK);
+#else
   (void)up_hostusleep(1000000 / CLK_TCK);
+#endif
 
   /* Handle X11-related events */
 
@@ -43,6 +43,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/sched_profile.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/drivers/drivers.h>
 #include <nuttx/fs/loop.h>
@@ -236,6 +237,16 @@ void up_initialize(void)
   note_register();          /* Non-standard /dev/note */
 #endif
 
+#if defined(CONFIG_DRIVER_PROFILE)
+  profile_register();       /* Non-standard /dev/profile */
+#endif
+
+#ifdef CONFIG_SCHED_PROFILE
+  /* Start the host timer that takes the profiler samples */
+
+  (void)up_profile_start(CONFIG_USEC_PER_TICK);
+#endif
+
 #if defined(USE_DEVCONSOLE)
   /* Start the sumulated UART device */
 
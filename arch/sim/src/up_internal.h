@@ -166,6 +166,15 @@
 #  define SIM_HEAP_SIZE (4*1024*1024)
 #endif
 
+/* Oneshot Timer Channels ***************************************************/
+/* Channel 0 is simulated with a watchdog timer and so has only system
+ * tick resolution.  With CONFIG_SIM_WALLTIME, channel 1 follows the host
+ * clock.  It expires at sub-tick resolution from the IDLE loop.
+ */
+
+#define SIM_ONESHOT_WDOG    0
+#define SIM_ONESHOT_HOSTCLK 1
+
 /* File System Definitions **************************************************/
 /* These definitions characterize the compressed filesystem image */
 
@@ -250,12 +259,32 @@ void sim_cpu_pause(int cpu, FAR volatile spinlock_t *wait,
 void sim_smp_hook(void);
 #endif
 
+/* up_hostusleep.c ********************************************************/
+
+int up_hostusleep(unsigned int usec);
+
+/* up_hostperf.c **********************************************************/
+
+uint64_t up_hostclock(void);
+
+/* up_oneshot.c ***********************************************************/
+
+#if defined(CONFIG_ONESHOT) && defined(CONFIG_SIM_WALLTIME)
+void up_oneshot_idle(unsigned int usec);
+#endif
+
 /* up_tickless.c **********************************************************/
 
 #ifdef CONFIG_SCHED_TICKLESS
 void up_timer_update(void);
 #endif
 
+/* up_hostprofile.c *******************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE
+int up_profile_start(unsigned int usec);
+#endif
+
 /* up_devconsole.c ********************************************************/
 
 void up_devconsole(void);
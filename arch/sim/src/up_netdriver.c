@@ -48,25 +48,61 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sched.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
 
 #include <net/ethernet.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
 
-#ifdef CONFIG_NET_PKT
-#  include <nuttx/net/pkt.h>
-#endif
-
 #include "up_internal.h"
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define BUF ((struct eth_hdr_s *)g_sim_dev.d_buf)
+#ifndef CONFIG_SIM_NET_LOSSRATE
+#  define CONFIG_SIM_NET_LOSSRATE 0
+#endif
+
+#if CONFIG_SIM_NET_LOSSRATE > 0
+#  define sim_lossy() ((rand() % 1000) < CONFIG_SIM_NET_LOSSRATE)
+#else
+#  define sim_lossy() (false)
+#endif
+
+/* The largest number of frames read from the host before they are passed to
+ * the network, and the largest number of frames collected by one poll.
+ */
+
+#define SIM_RXBATCH 4
+#define SIM_TXBATCH 8
+
+/* The largest TCP super-segment accepted from the network.  These are
+ * split into frames by netdev_iob_poll().
+ */
+
+#ifdef CONFIG_NET_TCP_GSO
+#  define SIM_GSOMAX (16 * 1024)
+#endif
+
+/* If a whole frame fits into one I/O buffer, then frames are read into and
+ * sent from the I/O buffers directly and the network works on them in
+ * place.  Otherwise, frames are staged in g_pktbuf.
+ */
+
+#ifdef SIM_GSOMAX
+#  define SIM_PKTSIZE (SIM_GSOMAX + CONFIG_NET_GUARDSIZE)
+#else
+#  define SIM_PKTSIZE (MAX_NET_DEV_MTU + CONFIG_NET_GUARDSIZE)
+#endif
+
+#if CONFIG_IOB_BUFSIZE >= SIM_PKTSIZE
+#  define SIM_ZEROCOPY 1
+#endif
 
 /****************************************************************************
  * Private Types
@@ -84,9 +120,13 @@ struct timer
 
 static struct timer g_periodic_timer;
 
-/* A single packet buffer is used */
+#ifndef SIM_ZEROCOPY
+/* A single packet buffer is used to stage frames and as the network packet
+ * buffer.  These uses never overlap.
+ */
 
-static uint8_t g_pktbuf[MAX_NET_DEV_MTU + CONFIG_NET_GUARDSIZE];
+static uint8_t g_pktbuf[SIM_PKTSIZE];
+#endif
 
 /* Ethernet peripheral state */
 
@@ -121,204 +161,162 @@ static inline int up_comparemac(uint8_t *paddr1, struct ether_addr *paddr2)
 }
 #endif
 
-static int sim_txpoll(struct net_driver_s *dev)
+/****************************************************************************
+ * Name: sim_transmit
+ *
+ * Description:
+ *   Send each frame in the queue to the host and free it.
+ *
+ ****************************************************************************/
+
+static void sim_transmit(FAR struct iob_queue_s *txq)
 {
-  /* If the polling resulted in data that should be sent out on the network,
-   * the field d_len is set to a value > 0.
-   */
+  FAR struct iob_s *iob;
 
-  if (g_sim_dev.d_len > 0)
+  while ((iob = iob_remove_queue(txq)) != NULL)
     {
-      /* Look up the destination MAC address and add it to the Ethernet
-       * header.
-       */
-
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-      if (IFF_IS_IPv4(&g_sim_dev))
-#endif
+      if (!sim_lossy())
         {
-          arp_out(&g_sim_dev);
-        }
-#endif /* CONFIG_NET_IPv4 */
-
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-      else
+#ifdef SIM_ZEROCOPY
+          if (iob->io_flink == NULL)
+            {
+              netdev_send(&iob->io_data[iob->io_offset], iob->io_len);
+            }
+          else
 #endif
-        {
-          neighbor_out(&g_sim_dev);
-        }
-#endif /* CONFIG_NET_IPv6 */
+            {
+#ifdef SIM_ZEROCOPY
+              uint8_t pktbuf[SIM_PKTSIZE];
+#else
+              FAR uint8_t *pktbuf = g_pktbuf;
+#endif
+              int len;
 
-      /* Send the packet */
+              len = iob_copyout(pktbuf, iob, iob->io_pktlen, 0);
+              netdev_send(pktbuf, len);
+            }
+        }
 
-      netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
+      iob_free_chain(iob);
     }
-
-  /* If zero is returned, the polling will continue until all connections have
-   * been examined.
-   */
-
-  return 0;
 }
 
 /****************************************************************************
- * Public Functions
+ * Name: sim_receive
+ *
+ * Description:
+ *   Read up to SIM_RXBATCH frames from the host and add each frame that
+ *   is addressed to us to the end of the queue.
+ *
+ * Returned Value:
+ *   The number of frames added to the queue.
+ *
  ****************************************************************************/
 
-void netdriver_loop(void)
+static int sim_receive(FAR struct iob_queue_s *rxq)
 {
   FAR struct eth_hdr_s *eth;
+  FAR struct iob_s *iob;
+  FAR uint8_t *pktbuf;
+  unsigned int len;
+  int nrx = 0;
+  int i;
 
-  /* Check for new frames.  If so, then poll the network for new XMIT data */
-
-  net_lock();
-  (void)devif_poll(&g_sim_dev, sim_txpoll);
-  net_unlock();
-
-  /* netdev_read will return 0 on a timeout event and >0 on a data received event */
-
-  g_sim_dev.d_len = netdev_read((FAR unsigned char *)g_sim_dev.d_buf,
-                                CONFIG_NET_ETH_MTU);
-
-  /* Disable preemption through to the following so that it behaves a little more
-   * like an interrupt (otherwise, the following logic gets pre-empted an behaves
-   * oddly.
-   */
-
-  sched_lock();
-  if (g_sim_dev.d_len > 0)
+  for (i = 0; i < SIM_RXBATCH; i++)
     {
-      /* Data received event.  Check for valid Ethernet header with destination == our
-       * MAC address
-       */
-
-      eth = BUF;
-      if (g_sim_dev.d_len > ETH_HDRLEN)
+      iob = iob_tryalloc(false);
+      if (iob == NULL)
         {
-         int is_ours;
-
-         /* Figure out if this ethernet frame is addressed to us.  This affects
-           * what we're willing to receive.   Note that in promiscuous mode, the
-           * up_comparemac will always return 0.
-           */
-
-         is_ours = (up_comparemac(eth->dest, &g_sim_dev.d_mac.ether) == 0);
-
-#ifdef CONFIG_NET_PKT
-          /* When packet sockets are enabled, feed the frame into the packet
-           * tap.
-           */
+          break;
+        }
 
-          if (is_ours)
-            {
-              pkt_input(&g_sim_dev);
-            }
-#endif /* CONFIG_NET_PKT */
+#ifdef SIM_ZEROCOPY
+      pktbuf = iob->io_data;
+#else
+      pktbuf = g_pktbuf;
+#endif
 
-          /* We only accept IP packets of the configured type and ARP packets */
+      /* netdev_read will return 0 on a timeout event and >0 on a data
+       * received event.
+       */
 
-#ifdef CONFIG_NET_IPv4
-          if (eth->type == HTONS(ETHTYPE_IP) && is_ours)
-            {
-              ninfo("IPv4 frame\n");
+      len = netdev_read((FAR unsigned char *)pktbuf, CONFIG_NET_ETH_MTU);
+      if (len == 0)
+        {
+          iob_free(iob);
+          break;
+        }
 
-              /* Handle ARP on input then give the IPv4 packet to the network
-               * layer
-               */
+      /* Check for valid Ethernet header with destination == our MAC
+       * address.  Note that in promiscuous mode, the up_comparemac will
+       * always return 0.  ARP packets are always accepted.
+       */
 
-              arp_ipin(&g_sim_dev);
-              ipv4_input(&g_sim_dev);
+      eth = (FAR struct eth_hdr_s *)pktbuf;
+      if (len <= ETH_HDRLEN || sim_lossy() ||
+          (eth->type != HTONS(ETHTYPE_ARP) &&
+           up_comparemac(eth->dest, &g_sim_dev.d_mac.ether) != 0))
+        {
+          iob_free(iob);
+          continue;
+        }
 
-              /* If the above function invocation resulted in data that
-               * should be sent out on the network, the global variable
-               * d_len is set to a value > 0.
-               */
+#ifdef SIM_ZEROCOPY
+      iob->io_len    = len;
+      iob->io_pktlen = len;
+#else
+      if (iob_trycopyin(iob, pktbuf, len, 0, false) < 0)
+        {
+          iob_free_chain(iob);
+          break;
+        }
+#endif
 
-              if (g_sim_dev.d_len > 0)
-                {
-                  /* Update the Ethernet header with the correct MAC address */
+      if (iob_tryadd_queue(iob, rxq) < 0)
+        {
+          iob_free_chain(iob);
+          break;
+        }
 
-#ifdef CONFIG_NET_IPv6
-                  if (IFF_IS_IPv4(g_sim_dev.d_flags))
-#endif
-                    {
-                      arp_out(&g_sim_dev);
-                    }
-#ifdef CONFIG_NET_IPv6
-                  else
-                    {
-                      neighbor_out(&g_sim_dev);
-                    }
-#endif
+      nrx++;
+    }
 
-                  /* And send the packet */
+  return nrx;
+}
 
-                  netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
-                }
-            }
-          else
-#endif /* CONFIG_NET_IPv4 */
-#ifdef CONFIG_NET_IPv6
-          if (eth->type == HTONS(ETHTYPE_IP6) && is_ours)
-            {
-              ninfo("Iv6 frame\n");
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-              /* Give the IPv6 packet to the network layer */
+void netdriver_loop(void)
+{
+  struct iob_queue_s rxq;
+  struct iob_queue_s txq;
 
-              ipv6_input(&g_sim_dev);
+  IOB_QINIT(&rxq);
+  IOB_QINIT(&txq);
 
-              /* If the above function invocation resulted in data that
-               * should be sent out on the network, the global variable
-               * d_len is set to a value > 0.
-               */
+  /* Poll the network for new XMIT data */
 
-              if (g_sim_dev.d_len > 0)
-               {
-                  /* Update the Ethernet header with the correct MAC address */
+  (void)netdev_iob_poll(&g_sim_dev, &txq, SIM_TXBATCH);
+  sim_transmit(&txq);
 
-#ifdef CONFIG_NET_IPv4
-                  if (IFF_IS_IPv4(g_sim_dev.d_flags))
-                    {
-                      arp_out(&g_sim_dev);
-                    }
-                  else
-#endif
-#ifdef CONFIG_NET_IPv6
-                    {
-                      neighbor_out(&g_sim_dev);
-                    }
-#endif /* CONFIG_NET_IPv6 */
+  /* Check for new frames */
 
-                  /* And send the packet */
+  (void)sim_receive(&rxq);
 
-                  netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
-                }
-            }
-          else
-#endif/* CONFIG_NET_IPv6 */
-#ifdef CONFIG_NET_ARP
-          if (eth->type == htons(ETHTYPE_ARP))
-            {
-              arp_arpin(&g_sim_dev);
+  /* Disable preemption through to the following so that it behaves a little more
+   * like an interrupt (otherwise, the following logic gets pre-empted an behaves
+   * oddly.
+   */
 
-              /* If the above function invocation resulted in data that
-               * should be sent out on the network, the global variable
-               * d_len is set to a value > 0.
-               */
+  sched_lock();
+  if (!IOB_QEMPTY(&rxq))
+    {
+      /* Pass the whole batch to the network and send any responses */
 
-              if (g_sim_dev.d_len > 0)
-                {
-                  netdev_send(g_sim_dev.d_buf, g_sim_dev.d_len);
-                }
-            }
-          else
-#endif
-           {
-             nwarn("WARNING: Unsupported Ethernet type %u\n", eth->type);
-           }
-        }
+      (void)netdev_iob_input(&g_sim_dev, &rxq, &txq);
+      sim_transmit(&txq);
     }
 
   /* Otherwise, it must be a timeout event */
@@ -326,7 +324,8 @@ void netdriver_loop(void)
   else if (timer_expired(&g_periodic_timer))
     {
       timer_reset(&g_periodic_timer);
-      devif_timer(&g_sim_dev, sim_txpoll);
+      (void)netdev_iob_timer(&g_sim_dev, &txq, SIM_TXBATCH);
+      sim_transmit(&txq);
     }
 
   sched_unlock();
@@ -353,7 +352,14 @@ int netdriver_init(void)
 
   /* Set callbacks */
 
+#ifdef SIM_ZEROCOPY
+  g_sim_dev.d_buf    = NULL;             /* Packet buffers are I/O buffers */
+#else
   g_sim_dev.d_buf    = g_pktbuf;         /* Single packet buffer */
+#endif
+#ifdef SIM_GSOMAX
+  g_sim_dev.d_gsomax = SIM_GSOMAX;       /* Accept TCP super-segments */
+#endif
   g_sim_dev.d_ifup   = netdriver_ifup;
   g_sim_dev.d_ifdown = netdriver_ifdown;
 
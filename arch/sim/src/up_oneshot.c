@@ -40,16 +40,20 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <time.h>
 #include <limits.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/timers/oneshot.h>
 
+#include "up_internal.h"
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -71,12 +75,17 @@ struct sim_oneshot_lowerhalf_s
   WDOG_ID wdog;                   /* Simulates oneshot timer */
   oneshot_callback_t callback;    /* internal handler that receives callback */
   FAR void *arg;                  /* Argument that is passed to the handler */
+#ifdef CONFIG_SIM_WALLTIME
+  bool hostclk;                   /* True: Host clock channel, no wdog */
+  uint64_t deadline;              /* Host clock expiration time (ns) */
+#endif
 };
 
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
+static void sim_oneshot_expire(FAR struct sim_oneshot_lowerhalf_s *priv);
 static void sim_oneshot_handler(int argc, wdparm_t arg1, ...);
 
 static int sim_max_delay(FAR struct oneshot_lowerhalf_s *lower,
@@ -86,6 +95,8 @@ static int sim_start(FAR struct oneshot_lowerhalf_s *lower,
                      FAR const struct timespec *ts);
 static int sim_cancel(FAR struct oneshot_lowerhalf_s *lower,
                       FAR struct timespec *ts);
+static int sim_current(FAR struct oneshot_lowerhalf_s *lower,
+                       FAR struct timespec *ts);
 
 /****************************************************************************
  * Private Data
@@ -98,36 +109,40 @@ static const struct oneshot_operations_s g_oneshot_ops =
   .max_delay = sim_max_delay,
   .start     = sim_start,
   .cancel    = sim_cancel,
+  .current   = sim_current,
 };
 
+#ifdef CONFIG_SIM_WALLTIME
+/* The host clock channel.  There is only one; it is serviced by
+ * up_oneshot_idle().
+ */
+
+static FAR struct sim_oneshot_lowerhalf_s *g_hostclk_oneshot;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: sim_oneshot_handler
+ * Name: sim_oneshot_expire
  *
  * Description:
- *   Timer expiration handler
+ *   Perform the callback of an expired oneshot timer.
  *
  * Input Parameters:
- *   arg - Should be the same argument provided when sim_oneshot_start()
- *         was called.
+ *   priv - The expired oneshot timer.
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static void sim_oneshot_handler(int argc, wdparm_t arg1, ...)
+static void sim_oneshot_expire(FAR struct sim_oneshot_lowerhalf_s *priv)
 {
-  FAR struct sim_oneshot_lowerhalf_s *priv =
-    (FAR struct sim_oneshot_lowerhalf_s *)arg1;
   oneshot_callback_t callback;
   FAR void *cbarg;
 
-  DEBUGASSERT(argc == 1 && priv != NULL);
-
   /* Perhaps the callback was nullified in a race condition with
    * sim_cancel?
    */
@@ -149,6 +164,30 @@ static void sim_oneshot_handler(int argc, wdparm_t arg1, ...)
     }
 }
 
+/****************************************************************************
+ * Name: sim_oneshot_handler
+ *
+ * Description:
+ *   Timer expiration handler
+ *
+ * Input Parameters:
+ *   arg - Should be the same argument provided when sim_oneshot_start()
+ *         was called.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void sim_oneshot_handler(int argc, wdparm_t arg1, ...)
+{
+  FAR struct sim_oneshot_lowerhalf_s *priv =
+    (FAR struct sim_oneshot_lowerhalf_s *)arg1;
+
+  DEBUGASSERT(argc == 1 && priv != NULL);
+  sim_oneshot_expire(priv);
+}
+
 /****************************************************************************
  * Name: sim_max_delay
  *
@@ -212,6 +251,25 @@ static int sim_start(FAR struct oneshot_lowerhalf_s *lower,
 
   nsec = (int64_t)ts->tv_sec * NSEC_PER_SEC +
          (int64_t)ts->tv_nsec;
+
+#ifdef CONFIG_SIM_WALLTIME
+  if (priv->hostclk)
+    {
+      irqstate_t flags;
+
+      /* Just record the host clock deadline.  up_oneshot_idle() will
+       * perform the callback.
+       */
+
+      flags          = enter_critical_section();
+      priv->deadline = up_hostclock() + (uint64_t)nsec;
+      priv->callback = callback;
+      priv->arg      = arg;
+      leave_critical_section(flags);
+      return OK;
+    }
+#endif
+
   ticks = (systime_t)((nsec + NSEC_PER_TICK - 1) / NSEC_PER_TICK);
 
   /* Save the callback information and start the timer */
@@ -256,6 +314,37 @@ static int sim_cancel(FAR struct oneshot_lowerhalf_s *lower,
 
   DEBUGASSERT(priv != NULL);
 
+#ifdef CONFIG_SIM_WALLTIME
+  if (priv->hostclk)
+    {
+      irqstate_t flags;
+      uint64_t now;
+      uint64_t remaining = 0;
+
+      flags = enter_critical_section();
+      if (priv->callback != NULL)
+        {
+          now = up_hostclock();
+          if (priv->deadline > now)
+            {
+              remaining = priv->deadline - now;
+            }
+        }
+
+      priv->callback = NULL;
+      priv->arg      = NULL;
+      leave_critical_section(flags);
+
+      if (ts != NULL)
+        {
+          ts->tv_sec  = (time_t)(remaining / NSEC_PER_SEC);
+          ts->tv_nsec = (long)(remaining % NSEC_PER_SEC);
+        }
+
+      return OK;
+    }
+#endif
+
   /* Cancel the timer */
 
   ret            = wd_cancel(priv->wdog);
@@ -265,6 +354,48 @@ static int sim_cancel(FAR struct oneshot_lowerhalf_s *lower,
   return ret;
 }
 
+/****************************************************************************
+ * Name: sim_current
+ *
+ * Description:
+ *   Return the current value of the clock that the oneshot delays are
+ *   measured against.  Only the host clock channel has such a clock; the
+ *   watchdog channel counts system ticks.
+ *
+ * Input Parameters:
+ *   lower   Caller allocated instance of the oneshot state structure.  This
+ *           structure must have been previously initialized via a call to
+ *           oneshot_initialize();
+ *   ts      The location in which to return the current time.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOSYS is returned for the watchdog
+ *   channel.
+ *
+ ****************************************************************************/
+
+static int sim_current(FAR struct oneshot_lowerhalf_s *lower,
+                       FAR struct timespec *ts)
+{
+#ifdef CONFIG_SIM_WALLTIME
+  FAR struct sim_oneshot_lowerhalf_s *priv =
+    (FAR struct sim_oneshot_lowerhalf_s *)lower;
+
+  DEBUGASSERT(priv != NULL && ts != NULL);
+
+  if (priv->hostclk)
+    {
+      uint64_t now = up_hostclock();
+
+      ts->tv_sec  = (time_t)(now / NSEC_PER_SEC);
+      ts->tv_nsec = (long)(now % NSEC_PER_SEC);
+      return OK;
+    }
+#endif
+
+  return -ENOSYS;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -277,7 +408,9 @@ static int sim_cancel(FAR struct oneshot_lowerhalf_s *lower,
  *   instance.
  *
  * Input Parameters:
- *   chan       Timer counter channel to be used.
+ *   chan       Timer counter channel to be used:  SIM_ONESHOT_WDOG or,
+ *              with CONFIG_SIM_WALLTIME, SIM_ONESHOT_HOSTCLK.  Only one
+ *              host clock instance may be created.
  *   resolution The required resolution of the timer in units of
  *              microseconds.  NOTE that the range is restricted to the
  *              range of uint16_t (excluding zero).
@@ -308,6 +441,22 @@ FAR struct oneshot_lowerhalf_s *oneshot_initialize(int chan,
 
   priv->lh.ops = &g_oneshot_ops;
 
+#ifdef CONFIG_SIM_WALLTIME
+  if (chan == SIM_ONESHOT_HOSTCLK)
+    {
+      if (g_hostclk_oneshot != NULL)
+        {
+          tmrerr("ERROR: Host clock oneshot already in use\n");
+          kmm_free(priv);
+          return NULL;
+        }
+
+      priv->hostclk     = true;
+      g_hostclk_oneshot = priv;
+      return &priv->lh;
+    }
+#endif
+
   /* Initialize the contained watchdog timer */
 
   priv->wdog = wd_create();
@@ -319,4 +468,73 @@ FAR struct oneshot_lowerhalf_s *oneshot_initialize(int chan,
     }
 
   return &priv->lh;
-}
\ No newline at end of file
+}
+
+/****************************************************************************
+ * Name: up_oneshot_idle
+ *
+ * Description:
+ *   Called from the IDLE loop in place of up_hostusleep() when
+ *   CONFIG_SIM_WALLTIME is selected.  Sleep for 'usec' microseconds of
+ *   host time, but wake up to perform the callback of the host clock
+ *   oneshot timer if it expires in that interval.  This gives the host
+ *   clock channel sub-tick resolution without changing the tick rate.
+ *
+ * Input Parameters:
+ *   usec - The time to sleep in microseconds.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_WALLTIME
+void up_oneshot_idle(unsigned int usec)
+{
+  FAR struct sim_oneshot_lowerhalf_s *priv = g_hostclk_oneshot;
+  irqstate_t flags;
+  uint64_t end;
+  uint64_t now;
+  uint64_t wakeup;
+
+  now = up_hostclock();
+  end = now + (uint64_t)usec * NSEC_PER_USEC;
+
+  while (now < end)
+    {
+      /* Sleep until the end of the interval or until the oneshot expires,
+       * whichever comes first.
+       */
+
+      wakeup = end;
+
+      flags = enter_critical_section();
+      if (priv != NULL && priv->callback != NULL && priv->deadline < end)
+        {
+          wakeup = priv->deadline;
+        }
+
+      leave_critical_section(flags);
+
+      if (wakeup > now)
+        {
+          (void)up_hostusleep((unsigned int)
+                              ((wakeup - now + NSEC_PER_USEC - 1) /
+                               NSEC_PER_USEC));
+        }
+
+      /* Perform the callback if the oneshot has expired.  The callback may
+       * restart the oneshot.
+       */
+
+      now   = up_hostclock();
+      flags = enter_critical_section();
+      if (priv != NULL && priv->callback != NULL && priv->deadline <= now)
+        {
+          sim_oneshot_expire(priv);
+        }
+
+      leave_critical_section(flags);
+    }
+}
+#endif
@@ -111,6 +111,18 @@ int sim_bringup(void);
 int sim_zoneinfo(int minor);
 #endif
 
+/****************************************************************************
+ * Name: sim_spinbench
+ *
+ * Description:
+ *   Start the spinlock microbenchmark.  Results are reported via syslog.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_SPINBENCH
+int sim_spinbench(void);
+#endif
+
 /****************************************************************************
  * Name: sim_gpio_initialize
  *
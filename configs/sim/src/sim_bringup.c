@@ -46,6 +46,7 @@
 
 #include <nuttx/board.h>
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/video/fb.h>
 #include <nuttx/timers/oneshot.h>
 #include <nuttx/wireless/pktradio.h>
@@ -97,6 +98,9 @@ int sim_bringup(void)
 {
 #ifdef CONFIG_ONESHOT
   FAR struct oneshot_lowerhalf_s *oneshot;
+#endif
+#if defined(CONFIG_ONESHOT) && defined(CONFIG_HRTIMER)
+  FAR struct oneshot_lowerhalf_s *hrtimer;
 #endif
   int ret;
 
@@ -115,7 +119,7 @@ int sim_bringup(void)
 #ifdef CONFIG_ONESHOT
   /* Get an instance of the simulated oneshot timer */
 
-  oneshot = oneshot_initialize(0, 0);
+  oneshot = oneshot_initialize(SIM_ONESHOT_WDOG, 0);
   if (oneshot == NULL)
     {
       syslog(LOG_ERR, "ERROR: oneshot_initialize faile\n");
@@ -140,6 +144,29 @@ int sim_bringup(void)
     }
 #endif
 
+#if defined(CONFIG_ONESHOT) && defined(CONFIG_HRTIMER)
+  /* Drive the high resolution timers with a separate oneshot timer.  With
+   * CONFIG_SIM_WALLTIME, this is the host clock channel which expires at
+   * sub-tick resolution.  Otherwise, simulated time has no relation to
+   * host time and a watchdog based channel must be used.  The high
+   * resolution timers are then quantized to system ticks.
+   */
+
+#ifdef CONFIG_SIM_WALLTIME
+  hrtimer = oneshot_initialize(SIM_ONESHOT_HOSTCLK, 0);
+#else
+  hrtimer = oneshot_initialize(SIM_ONESHOT_WDOG, 0);
+#endif
+  if (hrtimer == NULL)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to initialize the hrtimer oneshot\n");
+    }
+  else
+    {
+      hrtimer_initialize(hrtimer);
+    }
+#endif
+
 #ifdef CONFIG_AJOYSTICK
   /* Initialize the simulated analog joystick input device */
 
@@ -193,6 +220,16 @@ int sim_bringup(void)
     }
 #endif
 
+#ifdef CONFIG_SIM_SPINBENCH
+  /* Start the spinlock microbenchmark */
+
+  ret = sim_spinbench();
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: sim_spinbench() failed: %d\n", ret);
+    }
+#endif
+
   UNUSED(ret);
   return OK;
 }
@@ -0,0 +1,362 @@
+/****************************************************************************
+ * configs/sim/src/sim_spinbench.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
+
+#include "sim.h"
+
+#ifdef CONFIG_SIM_SPINBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SPINBENCH_NWORKERS CONFIG_SMP_NCPUS
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The lock algorithms that can be measured */
+
+enum spinbench_type_e
+{
+  SPINBENCH_TESTSET = 0,    /* spin_lock() / spin_unlock() */
+#ifdef CONFIG_SPINLOCK_TICKET
+  SPINBENCH_TICKET,         /* spin_ticket_lock() / spin_ticket_unlock() */
+#endif
+  SPINBENCH_NTYPES
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const char *g_spinbench_names[SPINBENCH_NTYPES] =
+{
+  "testset",
+#ifdef CONFIG_SPINLOCK_TICKET
+  "ticket",
+#endif
+};
+
+/* The locks under test */
+
+static volatile spinlock_t g_spinbench_testset SP_SECTION = SP_UNLOCKED;
+#ifdef CONFIG_SPINLOCK_TICKET
+static struct spin_ticket_s g_spinbench_ticket = SPIN_TICKET_INITIALIZER;
+#endif
+
+/* Benchmark state shared by the runner and the workers */
+
+static sem_t g_spinbench_start;
+static sem_t g_spinbench_done;
+static volatile int g_spinbench_type;
+static volatile bool g_spinbench_stop;
+static volatile bool g_spinbench_exit;
+static volatile uint32_t g_spinbench_shared;
+static uint32_t g_spinbench_count[SPINBENCH_NWORKERS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spinbench_worker
+ *
+ * Description:
+ *   One benchmark worker, pinned to one CPU.  Take and release the lock
+ *   under test as often as possible until told to stop.  Exit when the
+ *   runner starts a pass with g_spinbench_exit set.
+ *
+ ****************************************************************************/
+
+static int spinbench_worker(int argc, FAR char *argv[])
+{
+  uint32_t count;
+  int ndx;
+
+  DEBUGASSERT(argc == 2);
+  ndx = atoi(argv[1]);
+
+  for (; ; )
+    {
+      /* Wait for the runner to start the next pass */
+
+      while (nxsem_wait(&g_spinbench_start) < 0);
+
+      if (g_spinbench_exit)
+        {
+          break;
+        }
+
+      count = 0;
+      while (!g_spinbench_stop)
+        {
+#ifdef CONFIG_SPINLOCK_TICKET
+          if (g_spinbench_type == SPINBENCH_TICKET)
+            {
+              spin_ticket_lock(&g_spinbench_ticket);
+              g_spinbench_shared++;
+              spin_ticket_unlock(&g_spinbench_ticket);
+            }
+          else
+#endif
+            {
+              spin_lock(&g_spinbench_testset);
+              g_spinbench_shared++;
+              spin_unlock(&g_spinbench_testset);
+            }
+
+          count++;
+        }
+
+      g_spinbench_count[ndx] = count;
+      nxsem_post(&g_spinbench_done);
+    }
+
+  nxsem_post(&g_spinbench_done);
+  return EXIT_SUCCESS;
+}
+
+/****************************************************************************
+ * Name: spinbench_exit
+ *
+ * Description:
+ *   Tell the first 'nworkers' workers to exit and wait until they have.
+ *
+ ****************************************************************************/
+
+static void spinbench_exit(int nworkers)
+{
+  int i;
+
+  g_spinbench_exit = true;
+
+  for (i = 0; i < nworkers; i++)
+    {
+      nxsem_post(&g_spinbench_start);
+    }
+
+  for (i = 0; i < nworkers; i++)
+    {
+      while (nxsem_wait(&g_spinbench_done) < 0);
+    }
+}
+
+/****************************************************************************
+ * Name: spinbench_pass
+ *
+ * Description:
+ *   Run all workers against one lock type for CONFIG_SIM_SPINBENCH_MSEC
+ *   milliseconds and report throughput and fairness.
+ *
+ ****************************************************************************/
+
+static void spinbench_pass(int type)
+{
+  systime_t start;
+  systime_t elapsed;
+  uint32_t total;
+  uint32_t min;
+  uint32_t max;
+  int i;
+
+  g_spinbench_type   = type;
+  g_spinbench_stop   = false;
+  g_spinbench_shared = 0;
+
+  start = clock_systimer();
+  for (i = 0; i < SPINBENCH_NWORKERS; i++)
+    {
+      nxsem_post(&g_spinbench_start);
+    }
+
+  (void)nxsig_usleep(1000 * CONFIG_SIM_SPINBENCH_MSEC);
+  g_spinbench_stop = true;
+
+  for (i = 0; i < SPINBENCH_NWORKERS; i++)
+    {
+      while (nxsem_wait(&g_spinbench_done) < 0);
+    }
+
+  elapsed = clock_systimer() - start;
+
+  /* Throughput is the total number of acquisitions.  Fairness is the
+   * ratio of the least to the most successful CPU.
+   */
+
+  total = 0;
+  min   = UINT32_MAX;
+  max   = 0;
+
+  for (i = 0; i < SPINBENCH_NWORKERS; i++)
+    {
+      total += g_spinbench_count[i];
+      if (g_spinbench_count[i] < min)
+        {
+          min = g_spinbench_count[i];
+        }
+
+      if (g_spinbench_count[i] > max)
+        {
+          max = g_spinbench_count[i];
+        }
+    }
+
+  syslog(LOG_INFO,
+         "spinbench: %-8s %lu ms: %lu acquisitions, min/max per CPU "
+         "%lu/%lu%s\n",
+         g_spinbench_names[type], (unsigned long)TICK2MSEC(elapsed),
+         (unsigned long)total, (unsigned long)min, (unsigned long)max,
+         total == g_spinbench_shared ? "" : " MISMATCH");
+}
+
+/****************************************************************************
+ * Name: spinbench_main
+ *
+ * Description:
+ *   The benchmark runner thread.  Start one worker per CPU, measure each
+ *   lock type in turn, then stop the workers.
+ *
+ ****************************************************************************/
+
+static int spinbench_main(int argc, FAR char *argv[])
+{
+  FAR char *args[2];
+  char arg[8];
+  cpu_set_t cpuset;
+  int type;
+  int pid;
+  int i;
+
+  nxsem_init(&g_spinbench_start, 0, 0);
+  nxsem_init(&g_spinbench_done, 0, 0);
+  g_spinbench_exit = false;
+
+  spin_stats_register(&g_spinbench_testset, "b_testset");
+#ifdef CONFIG_SPINLOCK_TICKET
+  spin_stats_register(&g_spinbench_ticket, "b_ticket");
+#endif
+
+  /* Start one worker per CPU.  The workers run at a lower priority than
+   * this thread so that it can always stop them.
+   */
+
+  for (i = 0; i < SPINBENCH_NWORKERS; i++)
+    {
+      snprintf(arg, sizeof(arg), "%d", i);
+      args[0] = arg;
+      args[1] = NULL;
+
+      pid = kthread_create("spinbench_worker",
+                           CONFIG_SIM_SPINBENCH_PRIORITY - 1,
+                           CONFIG_SIM_SPINBENCH_STACKSIZE,
+                           (main_t)spinbench_worker,
+                           (FAR char * const *)args);
+      if (pid < 0)
+        {
+          syslog(LOG_ERR, "ERROR: Failed to start worker %d: %d\n", i, pid);
+          spinbench_exit(i);
+          goto errout;
+        }
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(i, &cpuset);
+      (void)sched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+    }
+
+  for (type = 0; type < SPINBENCH_NTYPES; type++)
+    {
+      spinbench_pass(type);
+    }
+
+  spinbench_exit(SPINBENCH_NWORKERS);
+  nxsem_destroy(&g_spinbench_start);
+  nxsem_destroy(&g_spinbench_done);
+  return EXIT_SUCCESS;
+
+errout:
+  nxsem_destroy(&g_spinbench_start);
+  nxsem_destroy(&g_spinbench_done);
+  return EXIT_FAILURE;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_spinbench
+ *
+ * Description:
+ *   Start the spinlock microbenchmark.  One worker thread is pinned to each
+ *   CPU; all workers contend for the same lock.  The results are reported
+ *   via syslog and, if CONFIG_SPINLOCK_STATS is enabled, in
+ *   /proc/spinlocks.
+ *
+ ****************************************************************************/
+
+int sim_spinbench(void)
+{
+  int pid;
+
+  pid = kthread_create("spinbench", CONFIG_SIM_SPINBENCH_PRIORITY,
+                       CONFIG_SIM_SPINBENCH_STACKSIZE,
+                       (main_t)spinbench_main, NULL);
+  return pid < 0 ? pid : OK;
+}
+
+#endif /* CONFIG_SIM_SPINBENCH */
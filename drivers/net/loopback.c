@@ -520,6 +520,9 @@ int localhost_initialize(void)
 #endif
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
+#ifdef CONFIG_NETDEV_CHKSUM_OFFLOAD
+  priv->lo_dev.d_offload = NETDEV_OFFLOAD_RXCSUM | NETDEV_OFFLOAD_TXCSUM;
+#endif
 
   /* Create a watchdog for timing polling for and timing of transmissions */
 
@@ -0,0 +1,169 @@
+/****************************************************************************
+ * drivers/syslog/profile_driver.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/sched_profile.h>
+#include <nuttx/fs/fs.h>
+
+#ifdef CONFIG_DRIVER_PROFILE
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+static int     profile_ioctl(FAR struct file *filep, int cmd,
+                             unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations profile_fops =
+{
+  0,             /* open */
+  0,             /* close */
+  profile_read,  /* read */
+  0,             /* write */
+  0,             /* seek */
+  profile_ioctl  /* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+  , 0            /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , 0            /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_read
+ *
+ * Description:
+ *   Return as many whole samples as will fit into the user buffer.  Zero
+ *   (end-of-file) is returned when no samples are buffered.
+ *
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  size_t nsamples;
+
+  DEBUGASSERT(filep != 0 && buffer != NULL);
+
+  nsamples = buflen / sizeof(struct profile_sample_s);
+  if (nsamples == 0)
+    {
+      return -EINVAL;
+    }
+
+  nsamples = sched_profile_get((FAR struct profile_sample_s *)buffer,
+                               nsamples);
+  return nsamples * sizeof(struct profile_sample_s);
+}
+
+/****************************************************************************
+ * Name: profile_ioctl
+ ****************************************************************************/
+
+static int profile_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  switch (cmd)
+    {
+      case PROFIOC_START:
+        sched_profile_start();
+        return OK;
+
+      case PROFIOC_STOP:
+        sched_profile_stop();
+        return OK;
+
+      case PROFIOC_DROPPED:
+        {
+          FAR unsigned long *dropped = (FAR unsigned long *)((uintptr_t)arg);
+
+          if (dropped == NULL)
+            {
+              return -EINVAL;
+            }
+
+          *dropped = sched_profile_dropped();
+          return OK;
+        }
+
+      default:
+        return -ENOTTY;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_register
+ *
+ * Description:
+ *   Register a driver at /dev/profile that can be used by an application
+ *   to read the profiler samples.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int profile_register(void)
+{
+  return register_driver("/dev/profile", &profile_fops, 0444, NULL);
+}
+
+#endif /* CONFIG_DRIVER_PROFILE */
@@ -63,6 +63,16 @@
 
 #ifdef CONFIG_RAMLOG
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* In streaming mode, data is copied to the reader in chunks of this size so
+ * that interrupts are not disabled for too long.
+ */
+
+#define RAMLOG_READCHUNK 64
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -89,7 +99,32 @@ struct ramlog_dev_s
 #ifndef CONFIG_DISABLE_POLL
   FAR struct pollfd *rl_fds[CONFIG_RAMLOG_NPOLLWAITERS];
 #endif
+
+#ifdef CONFIG_RAMLOG_STREAMING
+  /* In streaming mode, rl_tail is the index of the first byte of the oldest
+   * record retained in the buffer.  Readers do not modify it.  The following
+   * are free-running counts that are used to detect readers that have been
+   * overtaken by the writer.
+   */
+
+  volatile uint32_t rl_headpos;      /* Total number of bytes written */
+  volatile uint32_t rl_tailpos;      /* Position of the oldest record */
+  volatile uint32_t rl_headseq;      /* Sequence number of the record being written */
+  volatile uint32_t rl_tailseq;      /* Sequence number of the oldest record */
+#endif
+};
+
+#ifdef CONFIG_RAMLOG_STREAMING
+/* In streaming mode, each open file has its own read position */
+
+struct ramlog_reader_s
+{
+  uint32_t          rr_pos;          /* Position of the next byte to read */
+  uint32_t          rr_seq;          /* Sequence number of the next record */
+  uint32_t          rr_nlost;        /* Number of records lost */
+  uint16_t          rr_ndx;          /* Index of the next byte to read */
 };
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
@@ -107,14 +142,33 @@ static int ramlog_flush(void);
 static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                               pollevent_t eventset);
 #endif
+#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
+static void ramlog_readnotify(FAR struct ramlog_dev_s *priv);
+#endif
 static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+#ifdef CONFIG_RAMLOG_STREAMING
+static void ramlog_discard(FAR struct ramlog_dev_s *priv);
+static void ramlog_readersync(FAR struct ramlog_dev_s *priv,
+                              FAR struct ramlog_reader_s *reader);
+static ssize_t ramlog_copyout(FAR struct ramlog_dev_s *priv,
+                              FAR struct ramlog_reader_s *reader,
+                              FAR char *buffer, size_t len);
+#endif
 
 /* Character driver methods */
 
+#ifdef CONFIG_RAMLOG_STREAMING
+static int     ramlog_open(FAR struct file *filep);
+static int     ramlog_close(FAR struct file *filep);
+#endif
 static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer,
                            size_t buflen);
 static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer,
                             size_t buflen);
+#ifdef CONFIG_RAMLOG_STREAMING
+static int     ramlog_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+#endif
 #ifndef CONFIG_DISABLE_POLL
 static int     ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
@@ -142,12 +196,21 @@ static const struct syslog_channel_s g_ramlog_syslog_channel =
 
 static const struct file_operations g_ramlogfops =
 {
+#ifdef CONFIG_RAMLOG_STREAMING
+  ramlog_open,  /* open */
+  ramlog_close, /* close */
+#else
   NULL,         /* open */
   NULL,         /* close */
+#endif
   ramlog_read,  /* read */
   ramlog_write, /* write */
   NULL,         /* seek */
+#ifdef CONFIG_RAMLOG_STREAMING
+  ramlog_ioctl  /* ioctl */
+#else
   NULL          /* ioctl */
+#endif
 #ifndef CONFIG_DISABLE_POLL
   , ramlog_poll /* poll */
 #endif
@@ -232,6 +295,45 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
 #  define ramlog_pollnotify(priv,event)
 #endif
 
+/****************************************************************************
+ * Name: ramlog_readnotify
+ *
+ * Description:
+ *   New data was added to the buffer.  Wake up all readers blocked in
+ *   ramlog_read() and all poll/select waiters.  This function may be
+ *   called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
+static void ramlog_readnotify(FAR struct ramlog_dev_s *priv)
+{
+  irqstate_t flags;
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  int i;
+#endif
+
+  /* Are there threads waiting for read data? */
+
+  flags = enter_critical_section();
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  for (i = 0; i < priv->rl_nwaiters; i++)
+    {
+      /* Yes.. Notify all of the waiting readers that more data is available */
+
+      nxsem_post(&priv->rl_waitsem);
+    }
+#endif
+
+  /* Notify all poll/select waiters that they can read from the FIFO */
+
+  ramlog_pollnotify(priv, POLLIN);
+  leave_critical_section(flags);
+}
+#else
+#  define ramlog_readnotify(priv)
+#endif
+
 /****************************************************************************
  * Name: ramlog_addchar
  ****************************************************************************/
@@ -257,19 +359,228 @@ static int ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
 
   if (nexthead == priv->rl_tail)
     {
+#ifdef CONFIG_RAMLOG_STREAMING
+      /* Yes... Discard the oldest record to make space */
+
+      ramlog_discard(priv);
+#else
       /* Yes... Return an indication that nothing was saved in the buffer. */
 
       leave_critical_section(flags);
       return -EBUSY;
+#endif
     }
 
   /* No... copy the byte and re-enable interrupts */
 
   priv->rl_buffer[priv->rl_head] = ch;
   priv->rl_head = nexthead;
+
+#ifdef CONFIG_RAMLOG_STREAMING
+  priv->rl_headpos++;
+  if (ch == '\n')
+    {
+      priv->rl_headseq++;
+    }
+#endif
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ramlog_discard
+ *
+ * Description:
+ *   Remove the oldest record from the circular buffer.  If there is no
+ *   complete record in the buffer, all of the buffered data is removed.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static void ramlog_discard(FAR struct ramlog_dev_s *priv)
+{
+  char ch;
+
+  do
+    {
+      ch = priv->rl_buffer[priv->rl_tail];
+      if (++priv->rl_tail >= priv->rl_bufsize)
+        {
+          priv->rl_tail = 0;
+        }
+
+      priv->rl_tailpos++;
+    }
+  while (ch != '\n' && priv->rl_tail != priv->rl_head);
+
+  if (ch == '\n')
+    {
+      priv->rl_tailseq++;
+    }
+  else
+    {
+      /* What remains is the tail end of the record being written */
+
+      priv->rl_tailseq = priv->rl_headseq;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_readersync
+ *
+ * Description:
+ *   If the data at the reader's position has been overwritten, account for
+ *   the lost records and move the reader to the oldest retained record.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static void ramlog_readersync(FAR struct ramlog_dev_s *priv,
+                              FAR struct ramlog_reader_s *reader)
+{
+  /* The reader is valid if it lies between the tail and the head.  If it
+   * is behind the tail, the unsigned difference will wrap and be larger
+   * than the amount of buffered data.
+   */
+
+  if ((uint32_t)(reader->rr_pos - priv->rl_tailpos) >
+      (uint32_t)(priv->rl_headpos - priv->rl_tailpos))
+    {
+      reader->rr_nlost += priv->rl_tailseq - reader->rr_seq;
+      reader->rr_pos    = priv->rl_tailpos;
+      reader->rr_ndx    = priv->rl_tail;
+      reader->rr_seq    = priv->rl_tailseq;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_copyout
+ *
+ * Description:
+ *   Copy buffered data to the reader without removing it from the buffer.
+ *
+ * Returned Value:
+ *   The number of bytes copied.  Zero means that there is no data
+ *   available for this reader.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static ssize_t ramlog_copyout(FAR struct ramlog_dev_s *priv,
+                              FAR struct ramlog_reader_s *reader,
+                              FAR char *buffer, size_t len)
+{
+  irqstate_t flags;
+  uint32_t navail;
+  uint32_t i;
+  char ch;
+
+  /* Copy at most RAMLOG_READCHUNK bytes with interrupts disabled */
+
+  if (len > RAMLOG_READCHUNK)
+    {
+      len = RAMLOG_READCHUNK;
+    }
+
+  flags = enter_critical_section();
+  ramlog_readersync(priv, reader);
+
+  navail = priv->rl_headpos - reader->rr_pos;
+  if (navail > len)
+    {
+      navail = len;
+    }
+
+  for (i = 0; i < navail; i++)
+    {
+      ch = priv->rl_buffer[reader->rr_ndx];
+      if (++reader->rr_ndx >= priv->rl_bufsize)
+        {
+          reader->rr_ndx = 0;
+        }
+
+      if (ch == '\n')
+        {
+          reader->rr_seq++;
+        }
+
+      buffer[i] = ch;
+    }
+
+  reader->rr_pos += navail;
   leave_critical_section(flags);
+  return navail;
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_open
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static int ramlog_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv;
+  FAR struct ramlog_reader_s *reader;
+  irqstate_t flags;
+
+  DEBUGASSERT(inode && inode->i_private);
+  priv = (FAR struct ramlog_dev_s *)inode->i_private;
+
+  /* Only readers need a read position */
+
+  filep->f_priv = NULL;
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return OK;
+    }
+
+  reader = (FAR struct ramlog_reader_s *)
+    kmm_zalloc(sizeof(struct ramlog_reader_s));
+  if (reader == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Start reading at the oldest record in the buffer */
+
+  flags = enter_critical_section();
+  reader->rr_pos = priv->rl_tailpos;
+  reader->rr_ndx = priv->rl_tail;
+  reader->rr_seq = priv->rl_tailseq;
+  leave_critical_section(flags);
+
+  filep->f_priv = reader;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_close
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static int ramlog_close(FAR struct file *filep)
+{
+  if (filep->f_priv != NULL)
+    {
+      kmm_free(filep->f_priv);
+      filep->f_priv = NULL;
+    }
+
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: ramlog_read
@@ -279,8 +590,12 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
-  ssize_t nread;
+#ifdef CONFIG_RAMLOG_STREAMING
+  FAR struct ramlog_reader_s *reader;
+#else
   char ch;
+#endif
+  ssize_t nread;
   int ret;
 
   /* Some sanity checking */
@@ -288,6 +603,14 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct ramlog_dev_s *)inode->i_private;
 
+#ifdef CONFIG_RAMLOG_STREAMING
+  reader = (FAR struct ramlog_reader_s *)filep->f_priv;
+  if (reader == NULL)
+    {
+      return -EBADF;
+    }
+#endif
+
   /* If the circular buffer is empty, then wait for something to be written
    * to it.  This function may NOT be called from an interrupt handler.
    */
@@ -308,7 +631,11 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
     {
       /* Get the next byte from the buffer */
 
+#ifdef CONFIG_RAMLOG_STREAMING
+      if (reader->rr_pos == priv->rl_headpos)
+#else
       if (priv->rl_head == priv->rl_tail)
+#endif
         {
           /* The circular buffer is empty. */
 
@@ -399,6 +726,14 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
         }
       else
         {
+#ifdef CONFIG_RAMLOG_STREAMING
+          /* Copy the data at this reader's position, leaving it in the
+           * buffer for other readers.
+           */
+
+          nread += ramlog_copyout(priv, reader, &buffer[nread],
+                                  len - nread);
+#else
           /* The circular buffer is not empty, get the next byte from the
            * tail index.
            */
@@ -416,6 +751,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
           buffer[nread] = ch;
           nread++;
+#endif
         }
     }
 
@@ -429,7 +765,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 errout_without_sem:
 #endif
 
-#ifndef CONFIG_DISABLE_POLL
+#if !defined(CONFIG_DISABLE_POLL) && !defined(CONFIG_RAMLOG_STREAMING)
   if (nread > 0)
     {
       ramlog_pollnotify(priv, POLLOUT);
@@ -514,32 +850,10 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
 
   /* Was anything written? */
 
-#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
   if (nwritten > 0)
     {
-      irqstate_t flags;
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      int i;
-#endif
-
-      /* Are there threads waiting for read data? */
-
-      flags = enter_critical_section();
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      for (i = 0; i < priv->rl_nwaiters; i++)
-        {
-          /* Yes.. Notify all of the waiting readers that more data is available */
-
-          nxsem_post(&priv->rl_waitsem);
-        }
-#endif
-
-      /* Notify all poll/select waiters that they can write to the FIFO */
-
-      ramlog_pollnotify(priv, POLLIN);
-      leave_critical_section(flags);
+      ramlog_readnotify(priv);
     }
-#endif
 
   /* We always have to return the number of bytes requested and NOT the
    * number of bytes that were actually written.  Otherwise, callers
@@ -549,6 +863,63 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
   return len;
 }
 
+/****************************************************************************
+ * Name: ramlog_ioctl
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_STREAMING
+static int ramlog_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv;
+  FAR struct ramlog_reader_s *reader;
+  FAR struct ramlog_status_s *status;
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(inode && inode->i_private);
+  priv   = (FAR struct ramlog_dev_s *)inode->i_private;
+  reader = (FAR struct ramlog_reader_s *)filep->f_priv;
+
+  switch (cmd)
+    {
+      /* RAMLOGIOC_GETSTATUS - Get the status of this open file's read
+       *   position.
+       *
+       *   ioctl argument:  A pointer to a writable instance of struct
+       *   ramlog_status_s.
+       */
+
+      case RAMLOGIOC_GETSTATUS:
+        {
+          status = (FAR struct ramlog_status_s *)((uintptr_t)arg);
+          if (status == NULL || reader == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          flags = enter_critical_section();
+          ramlog_readersync(priv, reader);
+
+          status->rs_seq      = reader->rr_seq;
+          status->rs_headseq  = priv->rl_headseq;
+          status->rs_firstseq = priv->rl_tailseq;
+          status->rs_nlost    = reader->rr_nlost;
+          status->rs_navail   = priv->rl_headpos - reader->rr_pos;
+          leave_critical_section(flags);
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: ramlog_poll
  ****************************************************************************/
@@ -558,8 +929,12 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
-  pollevent_t eventset;
+#ifdef CONFIG_RAMLOG_STREAMING
+  FAR struct ramlog_reader_s *reader;
+#else
   size_t ndx;
+#endif
+  pollevent_t eventset;
   int ret;
   int i;
 
@@ -611,6 +986,17 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
       eventset = 0;
 
+#ifdef CONFIG_RAMLOG_STREAMING
+      /* Writes never block.  Is there data for this reader? */
+
+      eventset |= POLLOUT;
+
+      reader = (FAR struct ramlog_reader_s *)filep->f_priv;
+      if (reader != NULL && reader->rr_pos != priv->rl_headpos)
+       {
+         eventset |= POLLIN;
+       }
+#else
       ndx = priv->rl_head + 1;
       if (ndx >= priv->rl_bufsize)
         {
@@ -628,6 +1014,7 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
        {
          eventset |= POLLIN;
        }
+#endif
 
       if (eventset)
         {
@@ -813,6 +1200,13 @@ int ramlog_putc(int ch)
       return ret;
     }
 
+  /* Wake up the readers at the end of each line */
+
+  if (ch == '\n')
+    {
+      ramlog_readnotify(priv);
+    }
+
   /* Return the character added on success */
 
   return ch;
@@ -44,6 +44,25 @@
 
 #include <stdbool.h>
 
+#include <nuttx/streams.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+/* This is the stream used to format one SYSLOG record before it is copied
+ * into the per-CPU deferred SYSLOG buffer.
+ */
+
+struct syslog_deferstream_s
+{
+  struct lib_outstream_s public;
+  size_t ds_len;                                 /* Bytes in ds_buffer */
+  char ds_buffer[CONFIG_SYSLOG_DEFERRED_RECSIZE]; /* Formatted record */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -367,6 +386,66 @@ int syslog_dev_putc(int ch);
 int syslog_dev_flush(void);
 #endif
 
+/****************************************************************************
+ * Name: syslog_deferred_initialize
+ *
+ * Description:
+ *   Start the low priority thread that drains the deferred SYSLOG buffers
+ *   to the SYSLOG channel.  Called from syslog_initialize().
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferred_initialize(void);
+#endif
+
+/****************************************************************************
+ * Name: syslog_deferstream_create
+ *
+ * Description:
+ *   Initialize a stream that formats one SYSLOG record into a local
+ *   buffer.
+ *
+ * Input Parameters:
+ *   stream - User allocated, uninitialized instance of struct
+ *            syslog_deferstream_s to be initialized.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+void syslog_deferstream_create(FAR struct syslog_deferstream_s *stream);
+#endif
+
+/****************************************************************************
+ * Name: syslog_deferstream_commit
+ *
+ * Description:
+ *   Copy the formatted record into the deferred SYSLOG buffer of the
+ *   current CPU.  This never blocks; if there is no space, the record is
+ *   dropped and counted.  The buffered records are written to the SYSLOG
+ *   channel later by a low priority drain thread.
+ *
+ * Input Parameters:
+ *   stream - The stream containing the formatted record.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if the record was dropped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferstream_commit(FAR struct syslog_deferstream_s *stream);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,391 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/kthread.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/streams.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_SYSLOG_DEFERRED_BUFSIZE & (CONFIG_SYSLOG_DEFERRED_BUFSIZE - 1)) != 0
+#  error CONFIG_SYSLOG_DEFERRED_BUFSIZE must be a power of two
+#endif
+
+#if CONFIG_SYSLOG_DEFERRED_RECSIZE > CONFIG_SYSLOG_DEFERRED_BUFSIZE
+#  error CONFIG_SYSLOG_DEFERRED_RECSIZE exceeds CONFIG_SYSLOG_DEFERRED_BUFSIZE
+#endif
+
+#define DEFERRED_MASK    (CONFIG_SYSLOG_DEFERRED_BUFSIZE - 1)
+#define DEFERRED_KICKLEN (CONFIG_SYSLOG_DEFERRED_BUFSIZE / 2)
+#define DEFERRED_PERIOD  MSEC2TICK(CONFIG_SYSLOG_DEFERRED_PERIOD)
+
+#ifdef CONFIG_SMP
+#  define DEFERRED_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define DEFERRED_NCPUS 1
+#endif
+
+/* Memory barriers are provided by arch/spinlock.h only if CONFIG_SPINLOCK
+ * is selected.  They are not needed otherwise.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This is the per-CPU ring buffer.  Each ring has exactly one producer (the
+ * CPU that owns it, with local interrupts disabled) and exactly one
+ * consumer (the drain thread), so no lock is needed to access it.  The
+ * head and tail indices are free-running and are masked on each access.
+ */
+
+struct syslog_ring_s
+{
+  volatile uint32_t sr_head;     /* Next byte to write (producer only) */
+  volatile uint32_t sr_tail;     /* Next byte to drain (consumer only) */
+  volatile uint32_t sr_ndropped; /* Records dropped (producer only) */
+  uint32_t sr_nreported;         /* Dropped records reported (consumer only) */
+  volatile bool sr_kicked;       /* The drain thread has been awakened */
+  char sr_buffer[CONFIG_SYSLOG_DEFERRED_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_ring_s g_syslog_rings[DEFERRED_NCPUS];
+static sem_t g_syslog_drainsem = SEM_INITIALIZER(0);
+static bool g_syslog_drainstarted;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferstream_putc
+ ****************************************************************************/
+
+static void syslog_deferstream_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct syslog_deferstream_s *stream =
+    (FAR struct syslog_deferstream_s *)this;
+
+  /* Discard carriage returns (the channel will add them back if needed) and
+   * silently truncate records that are too long.
+   */
+
+  if (ch != '\r' && stream->ds_len < CONFIG_SYSLOG_DEFERRED_RECSIZE)
+    {
+      stream->ds_buffer[stream->ds_len++] = ch;
+      this->nput++;
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_drain_ring
+ *
+ * Description:
+ *   Write everything in one ring buffer to the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+static void syslog_drain_ring(FAR struct syslog_ring_s *ring)
+{
+  char msg[40];
+  uint32_t ndropped;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t chunk;
+  int len;
+
+  ring->sr_kicked = false;
+
+  head = ring->sr_head;
+  SP_DMB();
+  tail = ring->sr_tail;
+
+  while (tail != head)
+    {
+      /* Write up to the end of the buffer (or the head) in one operation */
+
+      chunk = head - tail;
+      if (chunk > CONFIG_SYSLOG_DEFERRED_BUFSIZE - (tail & DEFERRED_MASK))
+        {
+          chunk = CONFIG_SYSLOG_DEFERRED_BUFSIZE - (tail & DEFERRED_MASK);
+        }
+
+      (void)syslog_write(&ring->sr_buffer[tail & DEFERRED_MASK], chunk);
+
+      /* Release the space to the producer */
+
+      tail += chunk;
+      SP_DMB();
+      ring->sr_tail = tail;
+    }
+
+  /* Report any records that were dropped since the last report */
+
+  ndropped = ring->sr_ndropped;
+  if (ndropped != ring->sr_nreported)
+    {
+      len = snprintf(msg, sizeof(msg), "[%lu syslog records dropped]\n",
+                     (unsigned long)(ndropped - ring->sr_nreported));
+      (void)syslog_write(msg, len);
+      ring->sr_nreported = ndropped;
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_drain_thread
+ *
+ * Description:
+ *   The low priority thread that periodically flushes the ring buffers to
+ *   the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+static int syslog_drain_thread(int argc, FAR char *argv[])
+{
+  int cpu;
+
+  for (; ; )
+    {
+      /* Wait for the drain period to elapse or for a producer to report
+       * that a ring buffer is filling up.
+       */
+
+      (void)nxsem_tickwait(&g_syslog_drainsem, clock_systimer(),
+                           DEFERRED_PERIOD);
+
+      for (cpu = 0; cpu < DEFERRED_NCPUS; cpu++)
+        {
+          syslog_drain_ring(&g_syslog_rings[cpu]);
+        }
+    }
+
+  return OK; /* Can't get here */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred_initialize
+ *
+ * Description:
+ *   Start the drain thread.  Records are buffered in the ring buffers
+ *   until this thread is started.  This is called once from
+ *   syslog_initialize() in the SYSLOG_INIT_LATE phase.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int syslog_deferred_initialize(void)
+{
+  int pid;
+
+  if (g_syslog_drainstarted)
+    {
+      return OK;
+    }
+
+  pid = kthread_create("syslogd", CONFIG_SYSLOG_DEFERRED_PRIORITY,
+                       CONFIG_SYSLOG_DEFERRED_STACKSIZE,
+                       syslog_drain_thread, NULL);
+  if (pid < 0)
+    {
+      return pid;
+    }
+
+  g_syslog_drainstarted = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syslog_deferstream_create
+ *
+ * Description:
+ *   Initialize a stream that formats one SYSLOG record into a local
+ *   buffer.
+ *
+ * Input Parameters:
+ *   stream - User allocated, uninitialized instance of struct
+ *            syslog_deferstream_s to be initialized.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void syslog_deferstream_create(FAR struct syslog_deferstream_s *stream)
+{
+  DEBUGASSERT(stream != NULL);
+
+  stream->public.put   = syslog_deferstream_putc;
+  stream->public.flush = lib_noflush;
+  stream->public.nput  = 0;
+  stream->ds_len       = 0;
+}
+
+/****************************************************************************
+ * Name: syslog_deferstream_commit
+ *
+ * Description:
+ *   Copy the formatted record into the ring buffer of the current CPU.  The
+ *   record is copied as a whole or, if there is insufficient space, it is
+ *   dropped and counted.  This function never blocks and never takes a
+ *   lock shared with other CPUs; it may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   stream - The stream containing the formatted record.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if the record was dropped.
+ *
+ ****************************************************************************/
+
+int syslog_deferstream_commit(FAR struct syslog_deferstream_s *stream)
+{
+  FAR struct syslog_ring_s *ring;
+  irqstate_t flags;
+  uint32_t head;
+  uint32_t used;
+  uint32_t len;
+  uint32_t ndx;
+  uint32_t chunk;
+  bool kick = false;
+  int ret = OK;
+
+  len = stream->ds_len;
+  if (len == 0)
+    {
+      return OK;
+    }
+
+  /* Disable local interrupts only.  That prevents any other producer from
+   * running on this CPU (and this thread from migrating to another CPU)
+   * while the record is copied.
+   */
+
+  flags = up_irq_save();
+  ring  = &g_syslog_rings[up_cpu_index()];
+
+  head  = ring->sr_head;
+  used  = head - ring->sr_tail;
+
+  if (len > CONFIG_SYSLOG_DEFERRED_BUFSIZE - used)
+    {
+      ring->sr_ndropped++;
+      ret = -ENOSPC;
+    }
+  else
+    {
+      /* Copy the record, handling wrap-around */
+
+      ndx   = head & DEFERRED_MASK;
+      chunk = CONFIG_SYSLOG_DEFERRED_BUFSIZE - ndx;
+      if (chunk > len)
+        {
+          chunk = len;
+        }
+
+      memcpy(&ring->sr_buffer[ndx], stream->ds_buffer, chunk);
+      if (chunk < len)
+        {
+          memcpy(ring->sr_buffer, &stream->ds_buffer[chunk], len - chunk);
+        }
+
+      /* Publish the record to the consumer */
+
+      SP_DMB();
+      ring->sr_head = head + len;
+      used += len;
+    }
+
+  /* Wake the drain thread early if the buffer is filling up */
+
+  if ((used >= DEFERRED_KICKLEN || ret < 0) && !ring->sr_kicked)
+    {
+      ring->sr_kicked = true;
+      kick = true;
+    }
+
+  up_irq_restore(flags);
+
+  if (kick)
+    {
+      (void)nxsem_post(&g_syslog_drainsem);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
@@ -109,6 +109,15 @@ int syslog_initialize(enum syslog_init_e phase)
 
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  if (ret == OK && phase == SYSLOG_INIT_LATE)
+    {
+      /* Start the thread that drains the deferred SYSLOG buffers */
+
+      ret = syslog_deferred_initialize();
+    }
+#endif
+
   return ret;
 }
 
@@ -47,8 +47,11 @@
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/streams.h>
+#include <nuttx/sched_note.h>
 #include <nuttx/syslog/syslog.h>
 
+#include "syslog.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -68,12 +71,31 @@
 
 int _vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 {
+  FAR struct lib_outstream_s *outstream;
+#ifdef CONFIG_SYSLOG_DEFERRED
+  struct syslog_deferstream_s deferstream;
+#endif
   struct lib_syslogstream_s stream;
   int ret;
 
 #ifdef CONFIG_SYSLOG_TIMESTAMP
   struct timespec ts;
+#endif
+
+#ifdef CONFIG_SYSLOG_BINARY
+  /* Just record the format string address and the raw arguments in the
+   * instrumentation buffer.  The message is formatted when the buffer is
+   * read out.  Emergency output is always formatted immediately.
+   */
+
+  if (priority != LOG_EMERG)
+    {
+      sched_note_vbprintf((uint8_t)priority, fmt, *ap);
+      return OK;
+    }
+#endif
 
+#ifdef CONFIG_SYSLOG_TIMESTAMP
   /* Get the current time.  Since debug output may be generated very early
    * in the start-up sequence, hardware timer support may not yet be
    * available.
@@ -120,26 +142,45 @@ int _vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
       /* Use the SYSLOG emergency stream */
 
       emergstream(&stream.public);
+      outstream = &stream.public;
     }
   else
     {
+#ifdef CONFIG_SYSLOG_DEFERRED
+      /* Format the record locally; it will be copied into the per-CPU
+       * deferred buffer when complete.
+       */
+
+      syslog_deferstream_create(&deferstream);
+      outstream = &deferstream.public;
+#else
       /* Use the normal SYSLOG stream */
 
       syslogstream_create(&stream);
+      outstream = &stream.public;
+#endif
     }
 
 #if defined(CONFIG_SYSLOG_TIMESTAMP)
   /* Pre-pend the message with the current time, if available */
 
-  (void)lib_sprintf(&stream.public, "[%6d.%06d]",
+  (void)lib_sprintf(outstream, "[%6d.%06d]",
                     ts.tv_sec, ts.tv_nsec/1000);
 #endif
 
   /* Generate the output */
 
-  ret = lib_vsprintf(&stream.public, fmt, *ap);
+  ret = lib_vsprintf(outstream, fmt, *ap);
+
+#if defined(CONFIG_SYSLOG_DEFERRED)
+  /* Hand the complete record to the deferred SYSLOG buffer */
+
+  if (priority != LOG_EMERG)
+    {
+      (void)syslog_deferstream_commit(&deferstream);
+    }
 
-#ifdef CONFIG_SYSLOG_BUFFER
+#elif defined(CONFIG_SYSLOG_BUFFER)
   /* Flush and destroy the syslog stream buffer */
 
   if (priority != LOG_EMERG)
@@ -80,6 +80,9 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations spinlock_operations;
+extern const struct procfs_operations latency_operations;
+extern const struct procfs_operations taskstats_operations;
 extern const struct procfs_operations uptime_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
@@ -124,6 +127,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "cpuload",       &cpuload_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_LATENCY) && !defined(CONFIG_FS_PROCFS_EXCLUDE_LATENCY)
+  { "latency",       &latency_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",        &meminfo_operations,        PROCFS_FILE_TYPE   },
 #endif
@@ -165,6 +172,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "partitions",    &part_procfsoperations,      PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SPINLOCK_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SPINLOCKS)
+  { "spinlocks",     &spinlock_operations,        PROCFS_FILE_TYPE   },
+#endif
+
+#if !defined(CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS)
+  { "taskstats",     &taskstats_operations,       PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -56,6 +56,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -87,7 +88,7 @@
  * to handle the longest line generated by this logic.
  */
 
-#define STATUS_LINELEN 32
+#define STATUS_LINELEN 40
 
 /****************************************************************************
  * Private Type Definitions
@@ -103,6 +104,9 @@ enum proc_node_e
   PROC_CMDLINE,                       /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   PROC_LOADAVG,                       /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+  PROC_LATENCY,                       /* Latency histograms */
 #endif
   PROC_STACK,                         /* Task stack info */
   PROC_GROUP,                         /* Group directory */
@@ -168,6 +172,11 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -250,6 +259,13 @@ static const struct proc_node_s g_loadavg =
 };
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY
+static const struct proc_node_s g_latency =
+{
+  "latency",       "latency", (uint8_t)PROC_LATENCY,     DTYPE_FILE        /* Latency histograms */
+};
+#endif
+
 static const struct proc_node_s g_stack =
 {
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
@@ -278,6 +294,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
   &g_cmdline,      /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   &g_loadavg,      /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+  &g_latency,      /* Latency histograms */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -294,6 +313,9 @@ static const struct proc_node_s * const g_level0info[] =
   &g_cmdline,      /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   &g_loadavg,      /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+  &g_latency,      /* Latency histograms */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -379,6 +401,7 @@ static FAR const struct proc_node_s *proc_findnode(FAR const char *relpath)
  *   PPID:       xxxxx              Parent thread ID
  *   Group:      xxxxx              Group ID
  *   CPU:        xxx                CPU (CONFIG_SMP only)
+ *   Migrations: nnn                Decimal (CONFIG_SCHED_BALANCE only)
  *   State:      xxxxxxxx,xxxxxxxxx {Invalid, Waiting, Ready, Running, Inactive},
  *                                  {Unlock, Semaphore, Signal, MQ empty, MQ full}
  *   Flags:      xxx                N,P,X
@@ -397,6 +420,9 @@ static ssize_t proc_status(FAR struct proc_file_s *procfile,
 #endif
   FAR const char *policy;
   FAR const char *name;
+#ifdef CONFIG_SCHED_CPUTIME
+  uint64_t cputime;
+#endif
   size_t remaining;
   size_t linesize;
   size_t copysize;
@@ -483,10 +509,27 @@ static ssize_t proc_status(FAR struct proc_file_s *procfile,
   buffer    += copysize;
   remaining -= copysize;
 
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+#ifdef CONFIG_SCHED_BALANCE
+  /* Show the number of times that the load balancer moved the thread */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Migrations:", (unsigned long)tcb->nmigrations);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
   if (totalsize >= buflen)
     {
       return totalsize;
     }
+#endif
 #endif
 
   /* Show the thread state */
@@ -504,6 +547,29 @@ static ssize_t proc_status(FAR struct proc_file_s *procfile,
       return totalsize;
     }
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Show the exact CPU time used by the thread (seconds.nanoseconds) */
+
+  if (clock_cputime(tcb->pid, &cputime) < 0)
+    {
+      cputime = 0;
+    }
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu.%09lu\n",
+                        "CPU time:", (unsigned long)(cputime / NSEC_PER_SEC),
+                        (unsigned long)(cputime % NSEC_PER_SEC));
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+#endif
+
   /* Show task flags */
 
   linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%c%c%c\n", "Flags:",
@@ -702,6 +768,74 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_latency
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                            FAR struct tcb_s *tcb, FAR char *buffer,
+                            size_t buflen, off_t offset)
+{
+  struct latency_hist_s hist[2];
+  char line[PROCFS_LATENCY_LINELEN];
+  FAR const char *title;
+  size_t remaining;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+  int j;
+
+  /* Take a consistent snapshot of both histograms */
+
+  if (sched_latency(tcb->pid, &hist[0], &hist[1]) < 0)
+    {
+      return 0;
+    }
+
+  remaining = buflen;
+  totalsize = 0;
+
+  for (i = 0; i < 2; i++)
+    {
+      title      = i == 0 ? "Wake-up latency (usec):\n" :
+                            "Semaphore wait (usec):\n";
+      linesize   = strlen(title);
+      copysize   = procfs_memcpy(title, linesize, buffer, remaining,
+                                 &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      remaining -= copysize;
+
+      if (totalsize >= buflen)
+        {
+          return totalsize;
+        }
+
+      for (j = 0; j <= CONFIG_SCHED_LATENCY_NBUCKETS; j++)
+        {
+          linesize   = procfs_latencyline(&hist[i], j, line,
+                                          PROCFS_LATENCY_LINELEN);
+          copysize   = procfs_memcpy(line, linesize, buffer, remaining,
+                                     &offset);
+
+          totalsize += copysize;
+          buffer    += copysize;
+          remaining -= copysize;
+
+          if (totalsize >= buflen)
+            {
+              return totalsize;
+            }
+        }
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -1175,6 +1309,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
     case PROC_LOADAVG: /* Average CPU utilization */
       ret = proc_loadavg(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+    case PROC_LATENCY: /* Latency histograms */
+      ret = proc_latency(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
 #endif
     case PROC_STACK: /* Task stack info */
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
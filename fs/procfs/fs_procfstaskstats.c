@@ -0,0 +1,484 @@
+/****************************************************************************
+ * fs/procfs/fs_procfstaskstats.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct taskstats_file_s
+{
+  struct procfs_file_s base;         /* Base open file structure */
+  size_t snapsize;                   /* Number of valid bytes in the snapshot */
+  struct procfs_taskstats_hdr_s hdr; /* Snapshot header */
+  struct procfs_taskstat_s rec[CONFIG_MAX_TASKS]; /* Snapshot records */
+#ifdef CONFIG_STACK_COLORATION
+  FAR void *stack[CONFIG_MAX_TASKS]; /* Stack of each record's task */
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Helpers */
+
+static void    taskstats_enum(FAR struct tcb_s *tcb, FAR void *arg);
+#ifdef CONFIG_STACK_COLORATION
+static void    taskstats_stackused(FAR struct taskstats_file_s *attr);
+#endif
+static void    taskstats_snapshot(FAR struct taskstats_file_s *attr);
+
+/* File system methods */
+
+static int     taskstats_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     taskstats_close(FAR struct file *filep);
+static ssize_t taskstats_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     taskstats_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     taskstats_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations taskstats_operations =
+{
+  taskstats_open,    /* open */
+  taskstats_close,   /* close */
+  taskstats_read,    /* read */
+  NULL,              /* write */
+
+  taskstats_dup,     /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  taskstats_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: taskstats_enum
+ *
+ * Description:
+ *   sched_foreach() callback that fills in one task record.  This runs with
+ *   interrupts disabled and so collects only the information that can be
+ *   obtained quickly.
+ *
+ ****************************************************************************/
+
+static void taskstats_enum(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct taskstats_file_s *attr = (FAR struct taskstats_file_s *)arg;
+  FAR struct procfs_taskstat_s *rec;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  FAR struct task_group_s *group;
+  int i;
+#endif
+
+  if (attr->hdr.th_ntasks >= CONFIG_MAX_TASKS)
+    {
+      return;
+    }
+
+#ifdef CONFIG_STACK_COLORATION
+  /* Only remember the stack.  It is scanned later, outside of the critical
+   * section.
+   */
+
+  attr->stack[attr->hdr.th_ntasks] = tcb->stack_alloc_ptr;
+#endif
+
+  rec = &attr->rec[attr->hdr.th_ntasks++];
+  memset(rec, 0, sizeof(struct procfs_taskstat_s));
+
+  rec->ts_pid          = tcb->pid;
+  rec->ts_state        = tcb->task_state;
+  rec->ts_priority     = tcb->sched_priority;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  rec->ts_basepriority = tcb->base_priority;
+#else
+  rec->ts_basepriority = tcb->sched_priority;
+#endif
+#ifdef CONFIG_SMP
+  rec->ts_cpu          = tcb->cpu;
+#endif
+  rec->ts_flags        = tcb->flags;
+  rec->ts_stacksize    = tcb->adj_stack_size;
+#ifdef CONFIG_SCHED_SWITCHCOUNT
+  rec->ts_nswitches    = tcb->nswitches;
+#endif
+
+#ifdef CONFIG_SCHED_CPULOAD
+  if (clock_cpuload(tcb->pid, &cpuload) == OK)
+    {
+      rec->ts_cputicks      = cpuload.active;
+      attr->hdr.th_cputotal = cpuload.total;
+    }
+#endif
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  group = tcb->group;
+  if (group != NULL)
+    {
+      FAR struct file *file = group->tg_filelist.fl_files;
+
+      for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++, file++)
+        {
+          if (file->f_inode != NULL)
+            {
+              rec->ts_nfds++;
+            }
+        }
+    }
+#endif
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  strncpy(rec->ts_name, tcb->name, PROCFS_TASKSTATS_NAMELEN - 1);
+#endif
+}
+
+/****************************************************************************
+ * Name: taskstats_stackused
+ *
+ * Description:
+ *   Measure the stack high water mark of each task in the snapshot.  The
+ *   stacks are scanned outside of the critical section so that interrupt
+ *   latency does not grow with the number and size of the stacks.  The
+ *   scheduler is locked instead and each task is looked up again by pid:
+ *   A task that exited, or whose pid was reused, since the snapshot is
+ *   skipped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_STACK_COLORATION
+static void taskstats_stackused(FAR struct taskstats_file_s *attr)
+{
+  FAR struct procfs_taskstat_s *rec;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < attr->hdr.th_ntasks; i++)
+    {
+      rec = &attr->rec[i];
+
+      sched_lock();
+      tcb = sched_gettcb(rec->ts_pid);
+      if (tcb != NULL && tcb->stack_alloc_ptr == attr->stack[i] &&
+          tcb->stack_alloc_ptr != NULL)
+        {
+          rec->ts_stackused = up_check_tcbstack(tcb);
+        }
+
+      sched_unlock();
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: taskstats_snapshot
+ *
+ * Description:
+ *   Sample the statistics of all tasks into the open file's snapshot
+ *   buffer.
+ *
+ ****************************************************************************/
+
+static void taskstats_snapshot(FAR struct taskstats_file_s *attr)
+{
+#ifndef CONFIG_BUILD_KERNEL
+  struct mallinfo mem;
+#endif
+
+  memset(&attr->hdr, 0, sizeof(struct procfs_taskstats_hdr_s));
+  attr->hdr.th_version = PROCFS_TASKSTATS_VERSION;
+  attr->hdr.th_hdrsize = sizeof(struct procfs_taskstats_hdr_s);
+  attr->hdr.th_recsize = sizeof(struct procfs_taskstat_s);
+  attr->hdr.th_systime = clock_systimer();
+
+  /* Collect the per-task information with interrupts disabled.  Then
+   * measure the stack usage with interrupts enabled.
+   */
+
+  sched_foreach(taskstats_enum, attr);
+#ifdef CONFIG_STACK_COLORATION
+  taskstats_stackused(attr);
+#endif
+
+#ifndef CONFIG_BUILD_KERNEL
+  /* Add the user heap usage */
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+  mem = kumm_mallinfo();
+#else
+  (void)kumm_mallinfo(&mem);
+#endif
+
+  attr->hdr.th_heapsize = mem.arena;
+  attr->hdr.th_heapused = mem.uordblks;
+#endif
+
+  attr->snapsize = sizeof(struct procfs_taskstats_hdr_s) +
+                   attr->hdr.th_ntasks * sizeof(struct procfs_taskstat_s);
+}
+
+/****************************************************************************
+ * Name: taskstats_open
+ ****************************************************************************/
+
+static int taskstats_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct taskstats_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "taskstats" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "taskstats") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct taskstats_file_s *)
+    kmm_zalloc(sizeof(struct taskstats_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_close
+ ****************************************************************************/
+
+static int taskstats_close(FAR struct file *filep)
+{
+  FAR struct taskstats_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct taskstats_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_read
+ ****************************************************************************/
+
+static ssize_t taskstats_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct taskstats_file_s *attr;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct taskstats_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* If f_pos is zero, then take a new snapshot.  Otherwise, continue
+   * returning data from the snapshot taken by the previous read() so that
+   * the data remains consistent if the caller reads in small pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      taskstats_snapshot(attr);
+    }
+
+  /* Transfer the snapshot to the user receive buffer.  The header and the
+   * records are contiguous in the file structure.
+   */
+
+  offset = filep->f_pos;
+  ret    = procfs_memcpy((FAR const char *)&attr->hdr, attr->snapsize,
+                         buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: taskstats_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int taskstats_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct taskstats_file_s *oldattr;
+  FAR struct taskstats_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct taskstats_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct taskstats_file_s *)
+    kmm_malloc(sizeof(struct taskstats_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct taskstats_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: taskstats_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int taskstats_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "taskstats" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "taskstats") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "taskstats" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_PROCFS_EXCLUDE_TASKSTATS */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
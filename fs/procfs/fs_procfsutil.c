@@ -40,8 +40,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdio.h>
 #include <string.h>
+#include <assert.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/fs/procfs.h>
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
@@ -134,4 +137,68 @@ size_t procfs_memcpy(FAR const char *src, size_t srclen,
   return copysize;
 }
 
+/****************************************************************************
+ * Name: procfs_latencyline
+ *
+ * Description:
+ *   Format one line of a latency histogram (CONFIG_SCHED_LATENCY):  The
+ *   range of latencies and the count for bucket 'ndx' or, if 'ndx' is
+ *   CONFIG_SCHED_LATENCY_NBUCKETS, the longest latency.
+ *
+ * Input Parameters:
+ *   hist    - The histogram to format
+ *   ndx     - The bucket index
+ *   line    - The buffer to receive the line
+ *   linelen - The size of the buffer.  PROCFS_LATENCY_LINELEN bytes hold
+ *             the widest line.
+ *
+ * Returned Value:
+ *   The length of the formatted line.  This is at most linelen - 1 even if
+ *   the line had to be truncated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+size_t procfs_latencyline(FAR const struct latency_hist_s *hist, int ndx,
+                          FAR char *line, size_t linelen)
+{
+  unsigned long lower;
+  int len;
+
+  DEBUGASSERT(linelen > 0);
+
+  if (ndx >= CONFIG_SCHED_LATENCY_NBUCKETS)
+    {
+      len = snprintf(line, linelen, "%-15s %10lu\n", "Max:",
+                     (unsigned long)hist->lh_max);
+    }
+  else
+    {
+      lower = ndx > 0 ? 1ul << (ndx - 1) : 0;
+
+      if (ndx == CONFIG_SCHED_LATENCY_NBUCKETS - 1)
+        {
+          len = snprintf(line, linelen, "%7lu+%7s %10lu\n", lower, "",
+                         (unsigned long)hist->lh_count[ndx]);
+        }
+      else
+        {
+          len = snprintf(line, linelen, "%7lu-%-7lu %10lu\n", lower,
+                         1ul << ndx, (unsigned long)hist->lh_count[ndx]);
+        }
+    }
+
+  /* snprintf() returns the length that the line would have had.  Never
+   * count the NUL terminator of a truncated line.
+   */
+
+  if (len < 0)
+    {
+      return 0;
+    }
+
+  return (size_t)len < linelen ? (size_t)len : linelen - 1;
+}
+#endif
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -401,6 +401,20 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = bytesleft;
     }
 
+  /* In XIP mode, the file data is directly addressable and contiguous.
+   * There is no need to break the transfer up into sectors.
+   */
+
+  if (rm->rm_xipbase)
+    {
+      offset = rf->rf_startoffset + filep->f_pos;
+      memcpy(userbuffer, rm->rm_xipbase + offset, buflen);
+
+      filep->f_pos += buflen;
+      romfs_semgive(rm);
+      return buflen;
+    }
+
   /* Loop until either (1) all data has been transferred, or (2) an
    * error occurs.
    */
@@ -1015,6 +1029,18 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       goto errout_with_buffer;
     }
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  /* Build the directory index.  This is an optimization only:  If the index
+   * cannot be built, lookups will use the linear directory search.
+   */
+
+  ret = romfs_buildhash(rm);
+  if (ret < 0)
+    {
+      fwarn("WARNING: romfs_buildhash failed: %d\n", ret);
+    }
+#endif
+
   /* Mounted! */
 
   *handle = (FAR void *)rm;
@@ -1105,6 +1131,10 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           kmm_free(rm->rm_buffer);
         }
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+      romfs_freehash(rm);
+#endif
+
       nxsem_destroy(&rm->rm_sem);
       kmm_free(rm);
       return OK;
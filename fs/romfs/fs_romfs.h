@@ -125,10 +125,33 @@
 
 #define ROMF_MAX_LINKS 64
 
+/* Directory hash index definitions */
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+#  define ROMFS_HASH_NIL      ((uint32_t)-1) /* Marks the end of a hash chain */
+#  define ROMFS_HASH_MINALLOC 32             /* Initial size of the entry table */
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+/* This structure describes one entry in the hashed directory index.  Every
+ * directory entry in the volume (including hard links such as '.' and '..')
+ * has one such entry, keyed by the offset to the first entry of the
+ * containing directory and the name of the entry.
+ */
+
+struct romfs_hashent_s
+{
+  uint32_t he_hash;                 /* Hash of the parent offset and name */
+  uint32_t he_parent;               /* Offset to the first entry in the parent */
+  uint32_t he_offset;               /* Offset to this entry's file header */
+  uint32_t he_next;                 /* Index of the next entry in the chain */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a fat32 filesystem.
@@ -149,6 +172,12 @@ struct romfs_mountpt_s
   uint32_t rm_cachesector;          /* Current sector in the rm_buffer */
   uint8_t *rm_xipbase;              /* Base address of directly accessible media */
   uint8_t *rm_buffer;               /* Device sector buffer, allocated if rm_xipbase==0 */
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  uint32_t rm_nentries;             /* Number of entries in rm_hashtab */
+  uint32_t rm_nbuckets;             /* Number of hash buckets (power of two) */
+  FAR uint32_t *rm_buckets;         /* Index of the first entry in each bucket */
+  FAR struct romfs_hashent_s *rm_hashtab; /* Directory index, NULL if none */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -223,6 +252,10 @@ int  romfs_parsefilename(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR char *pname);
 int  romfs_datastart(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR uint32_t *start);
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+int  romfs_buildhash(FAR struct romfs_mountpt_s *rm);
+void romfs_freehash(FAR struct romfs_mountpt_s *rm);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -277,6 +277,136 @@ static int romfs_followhardlinks(struct romfs_mountpt_s *rm, uint32_t offset,
   return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_namehash
+ *
+ * Desciption:
+ *   Return the FNV-1a hash of the name of an entry and the offset of the
+ *   first entry of the directory that contains it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+static uint32_t romfs_namehash(uint32_t parent, FAR const char *name,
+                               int namelen)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      hash ^= (parent >> (i << 3)) & 0xff;
+      hash *= 16777619u;
+    }
+
+  for (i = 0; i < namelen; i++)
+    {
+      hash ^= (uint8_t)name[i];
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_hashsearch
+ *
+ * Desciption:
+ *   This is the hashed alternative to the linear romfs_searchdir() logic.
+ *   The index holds every entry in the volume so a miss in the index means
+ *   that there is no entry with that name.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+static int romfs_hashsearch(FAR struct romfs_mountpt_s *rm,
+                            FAR const char *entryname, int entrylen,
+                            FAR struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_hashent_s *entry;
+  uint32_t parent;
+  uint32_t hash;
+  uint32_t ndx;
+  int ret;
+
+  parent = dirinfo->rd_dir.fr_firstoffset;
+  hash   = romfs_namehash(parent, entryname, entrylen);
+
+  for (ndx = rm->rm_buckets[hash & (rm->rm_nbuckets - 1)];
+       ndx != ROMFS_HASH_NIL;
+       ndx = entry->he_next)
+    {
+      entry = &rm->rm_hashtab[ndx];
+      if (entry->he_hash == hash && entry->he_parent == parent)
+        {
+          /* Probably a match.  romfs_checkentry() will compare the full
+           * name and fill in the directory information.
+           */
+
+          ret = romfs_checkentry(rm, entry->he_offset, entryname, entrylen,
+                                 dirinfo);
+          if (ret != -ENOENT)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_addhash
+ *
+ * Desciption:
+ *   Append one directory entry to the (still unhashed) entry table, growing
+ *   the table as necessary.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+static int romfs_addhash(FAR struct romfs_mountpt_s *rm,
+                         FAR uint32_t *nalloc, uint32_t parent,
+                         uint32_t offset)
+{
+  FAR struct romfs_hashent_s *entry;
+  char name[NAME_MAX+1];
+  int ret;
+
+  if (rm->rm_nentries >= *nalloc)
+    {
+      FAR struct romfs_hashent_s *newtab;
+      uint32_t newalloc = *nalloc ? *nalloc << 1 : ROMFS_HASH_MINALLOC;
+
+      newtab = (FAR struct romfs_hashent_s *)
+        kmm_realloc(rm->rm_hashtab,
+                    newalloc * sizeof(struct romfs_hashent_s));
+      if (newtab == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      rm->rm_hashtab = newtab;
+      *nalloc        = newalloc;
+    }
+
+  ret = romfs_parsefilename(rm, offset, name);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  entry            = &rm->rm_hashtab[rm->rm_nentries++];
+  entry->he_hash   = romfs_namehash(parent, name, strlen(name));
+  entry->he_parent = parent;
+  entry->he_offset = offset;
+  entry->he_next   = ROMFS_HASH_NIL;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -295,6 +425,15 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm,
   int16_t  ndx;
   int      ret;
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  /* Use the directory index if one was built when the volume was mounted */
+
+  if (rm->rm_hashtab != NULL)
+    {
+      return romfs_hashsearch(rm, entryname, entrylen, dirinfo);
+    }
+#endif
+
   /* Then loop through the current directory until the directory
    * with the matching name is found.  Or until all of the entries
    * the directory have been examined.
@@ -968,3 +1107,170 @@ int romfs_datastart(struct romfs_mountpt_s *rm, uint32_t offset,
 
   return -EINVAL; /* Won't get here */
 }
+
+/****************************************************************************
+ * Name: romfs_buildhash
+ *
+ * Desciption:
+ *   This function is called as part of the ROMFS mount operation.  It walks
+ *   every directory in the volume and builds a hashed index of all directory
+ *   entries so that path lookups do not have to scan directories linearly.
+ *   On failure, no index is retained and lookups fall back to the linear
+ *   directory search.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+int romfs_buildhash(FAR struct romfs_mountpt_s *rm)
+{
+  FAR struct romfs_hashent_s *entry;
+  uint32_t nalloc = 0;
+  uint32_t parent;
+  uint32_t offset;
+  uint32_t next;
+  uint32_t info;
+  uint32_t scan;
+  uint32_t ndx;
+  int16_t  secndx;
+  int      ret;
+
+  rm->rm_hashtab  = NULL;
+  rm->rm_buckets  = NULL;
+  rm->rm_nentries = 0;
+
+  /* Add the entries of the root directory.  The table then serves as the
+   * work queue:  The entries of each directory are appended as the
+   * directory is encountered in the table.
+   */
+
+  parent = rm->rm_rootoffset;
+  offset = parent;
+  scan   = 0;
+
+  for (; ; )
+    {
+      /* Add every entry in the directory beginning at 'offset' */
+
+      while (offset != 0)
+        {
+          if (offset >= rm->rm_volsize)
+            {
+              ret = -EIO;
+              goto errout;
+            }
+
+          ret = romfs_addhash(rm, &nalloc, parent, offset);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          secndx = romfs_devcacheread(rm, offset);
+          if (secndx < 0)
+            {
+              ret = secndx;
+              goto errout;
+            }
+
+          offset = romfs_devread32(rm, secndx + ROMFS_FHDR_NEXT) &
+                   RFNEXT_OFFSETMASK;
+        }
+
+      /* Find the next real (i.e., not hard-linked) sub-directory in the
+       * table.  Hard links like '.' and '..' are not followed so that each
+       * directory is visited only once.
+       */
+
+      for (; scan < rm->rm_nentries; scan++)
+        {
+          secndx = romfs_devcacheread(rm, rm->rm_hashtab[scan].he_offset);
+          if (secndx < 0)
+            {
+              ret = secndx;
+              goto errout;
+            }
+
+          next = romfs_devread32(rm, secndx + ROMFS_FHDR_NEXT);
+          info = romfs_devread32(rm, secndx + ROMFS_FHDR_INFO);
+          if (IS_DIRECTORY(next) && info != 0)
+            {
+              break;
+            }
+        }
+
+      if (scan >= rm->rm_nentries)
+        {
+          break;
+        }
+
+      parent = info;
+      offset = info;
+      scan++;
+    }
+
+  /* Size the bucket array to the next power of two at or above the number
+   * of entries and link each entry into its bucket.
+   */
+
+  for (rm->rm_nbuckets = 1; rm->rm_nbuckets < rm->rm_nentries; )
+    {
+      rm->rm_nbuckets <<= 1;
+    }
+
+  rm->rm_buckets = (FAR uint32_t *)
+    kmm_malloc(rm->rm_nbuckets * sizeof(uint32_t));
+  if (rm->rm_buckets == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  memset(rm->rm_buckets, 0xff, rm->rm_nbuckets * sizeof(uint32_t));
+
+  for (ndx = 0; ndx < rm->rm_nentries; ndx++)
+    {
+      uint32_t bucket;
+
+      entry                  = &rm->rm_hashtab[ndx];
+      bucket                 = entry->he_hash & (rm->rm_nbuckets - 1);
+      entry->he_next         = rm->rm_buckets[bucket];
+      rm->rm_buckets[bucket] = ndx;
+    }
+
+  finfo("%lu entries in %lu buckets\n",
+        (unsigned long)rm->rm_nentries, (unsigned long)rm->rm_nbuckets);
+  return OK;
+
+errout:
+  romfs_freehash(rm);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_freehash
+ *
+ * Desciption:
+ *   Release the directory index (if any).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+void romfs_freehash(FAR struct romfs_mountpt_s *rm)
+{
+  if (rm->rm_buckets != NULL)
+    {
+      kmm_free(rm->rm_buckets);
+      rm->rm_buckets = NULL;
+    }
+
+  if (rm->rm_hashtab != NULL)
+    {
+      kmm_free(rm->rm_hashtab);
+      rm->rm_hashtab = NULL;
+    }
+
+  rm->rm_nentries = 0;
+  rm->rm_nbuckets = 0;
+}
+#endif
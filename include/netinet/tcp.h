@@ -52,6 +52,12 @@
 
 #define TCP_NODELAY  __SO_PROTOCOL /* Avoid coalescing of small segments. */
 
+/* Non-standard TCP options.  arg: pointer to integer containing a boolean
+ * value.
+ */
+
+#define TCP_QUICKACK (__SO_PROTOCOL + 1) /* Disable delayed ACKs (get/set) */
+
 /* "The macro shall be defined in the header. The implementation need not
  *  allow the value of the option to be set via setsockopt() or retrieved via
  *  getsockopt()."  -- OpenGroup.org
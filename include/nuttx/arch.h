@@ -1621,6 +1621,61 @@ int up_timer_cancel(FAR struct timespec *ts);
 int up_timer_start(FAR const struct timespec *ts);
 #endif
 
+/****************************************************************************
+ * Name: up_perf_gettime and up_perf_getfreq
+ *
+ * Description:
+ *   If CONFIG_ARCH_HAVE_PERF_EVENTS is selected, then the platform provides
+ *   a free-running, high-resolution counter that is used for fine-grained
+ *   timestamps in the OS instrumentation.  up_perf_gettime() returns the
+ *   current value of the counter and up_perf_getfreq() returns the
+ *   frequency at which it increments (in Hz).
+ *
+ *   The counter is 32-bits wide and wraps around silently.  Users must
+ *   only rely on differences between counter values modulo 2**32.  On SMP
+ *   platforms, the counter should be synchronized between CPUs.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The counter value or the counter frequency.
+ *
+ * Assumptions:
+ *   May be called from any context, including from interrupt handlers and
+ *   with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+uint32_t up_perf_gettime(void);
+uint32_t up_perf_getfreq(void);
+#endif
+
+/****************************************************************************
+ * Name: up_profile_pc
+ *
+ * Description:
+ *   If CONFIG_ARCH_HAVE_PROFILE is selected, then the platform provides
+ *   this function for use by the sampling profiler.  It is called from
+ *   sched_process_timer() and returns the program counter of the code that
+ *   was interrupted by the system timer interrupt.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The interrupted program counter or zero if it is not known.
+ *
+ * Assumptions:
+ *   Called from the system timer interrupt handler.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_PROFILE) && defined(CONFIG_ARCH_HAVE_PROFILE)
+uintptr_t up_profile_pc(void);
+#endif
+
 /****************************************************************************
  * TLS support
  ****************************************************************************/
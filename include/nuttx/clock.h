@@ -201,6 +201,9 @@ struct cpuload_s
 {
   volatile uint32_t total;   /* Total number of clock ticks */
   volatile uint32_t active;  /* Number of ticks while this thread was active */
+#ifdef CONFIG_SCHED_CPUTIME
+  uint64_t runtime;          /* Exact CPU time used by the thread (nanoseconds) */
+#endif
 };
 #endif
 
@@ -382,6 +385,25 @@ int clock_systimespec(FAR struct timespec *ts);
 int clock_cpuload(int pid, FAR struct cpuload_s *cpuload);
 #endif
 
+/****************************************************************************
+ * Name:  clock_cputime
+ *
+ * Description:
+ *   Return the exact CPU time used by a thread (CONFIG_SCHED_CPUTIME).
+ *
+ * Parameters:
+ *   pid - The task ID of the thread of interest.  pid == 0 is the IDLE thread.
+ *   nsec - The location to return the CPU time in nanoseconds
+ *
+ * Return Value:
+ *   OK (0) on success; -ESRCH if 'pid' does not refer to a valid thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUTIME
+int clock_cputime(int pid, FAR uint64_t *nsec);
+#endif
+
 /****************************************************************************
  * Name:  sched_oneshot_extclk
  *
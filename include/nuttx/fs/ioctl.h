@@ -90,6 +90,9 @@
 #define _MAC802154BASE  (0x2500) /* 802.15.4 MAC ioctl commands */
 #define _PWRBASE        (0x2600) /* Power-related ioctl commands */
 #define _FBIOCBASE      (0x2700) /* Frame buffer character driver ioctl commands */
+#define _RAMLOGBASE     (0x2800) /* RAMLOG driver ioctl commands */
+#define _PROFIOCBASE    (0x2900) /* Sampling profiler ioctl commands */
+#define _NOTEIOCBASE    (0x2a00) /* Scheduler note driver ioctl commands */
 
 /* boardctl() commands share the same number space */
 
@@ -449,6 +452,24 @@
 #define _FBIOCVALID(c)   (_IOC_TYPE(c)==_FBIOCBASE)
 #define _FBIOC(nr)       _IOC(_FBIOCBASE,nr)
 
+/* RAMLOG driver ioctl definitions ******************************************/
+/* (see nuttx/syslog/ramlog.h) */
+
+#define _RAMLOGIOCVALID(c) (_IOC_TYPE(c)==_RAMLOGBASE)
+#define _RAMLOGIOC(nr)     _IOC(_RAMLOGBASE,nr)
+
+/* Sampling profiler driver ioctl definitions *******************************/
+/* (see nuttx/sched_profile.h) */
+
+#define _PROFIOCVALID(c)  (_IOC_TYPE(c)==_PROFIOCBASE)
+#define _PROFIOC(nr)      _IOC(_PROFIOCBASE,nr)
+
+/* Scheduler note driver ioctl definitions **********************************/
+/* (see nuttx/sched_note.h) */
+
+#define _NOTEIOCVALID(c)  (_IOC_TYPE(c)==_NOTEIOCBASE)
+#define _NOTEIOC(nr)      _IOC(_NOTEIOCBASE,nr)
+
 /* boardctl() command definitions *******************************************/
 
 #define _BOARDIOCVALID(c) (_IOC_TYPE(c)==_BOARDBASE)
@@ -41,6 +41,9 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdint.h>
+
 #include <nuttx/fs/fs.h>
 
 /****************************************************************************
@@ -133,6 +136,46 @@ struct procfs_dir_priv_s
   FAR const struct procfs_entry_s *procfsentry; /* Pointer to procfs handler entry */
 };
 
+/* Binary task statistics ***************************************************/
+
+/* The procfs 'taskstats' file returns a binary snapshot of all tasks in one
+ * read:  A struct procfs_taskstats_hdr_s followed by th_ntasks instances of
+ * struct procfs_taskstat_s (each th_recsize bytes in size).  A new snapshot
+ * is taken whenever the file is read at file position zero so a monitor may
+ * keep the file open and simply lseek() back to the beginning to resample.
+ */
+
+#define PROCFS_TASKSTATS_VERSION  1
+#define PROCFS_TASKSTATS_NAMELEN  16
+
+struct procfs_taskstats_hdr_s
+{
+  uint16_t th_version;    /* PROCFS_TASKSTATS_VERSION */
+  uint16_t th_hdrsize;    /* sizeof(struct procfs_taskstats_hdr_s) */
+  uint16_t th_recsize;    /* sizeof(struct procfs_taskstat_s) */
+  uint16_t th_ntasks;     /* Number of task records that follow */
+  uint32_t th_systime;    /* System time (ticks) when the snapshot was taken */
+  uint32_t th_cputotal;   /* CPU load total ticks (0 if no CONFIG_SCHED_CPULOAD) */
+  uint32_t th_heapsize;   /* Total size of the (user) heap */
+  uint32_t th_heapused;   /* Bytes allocated from the (user) heap */
+};
+
+struct procfs_taskstat_s
+{
+  int32_t  ts_pid;        /* Task/thread ID */
+  uint8_t  ts_state;      /* Task state (enum tstate_e) */
+  uint8_t  ts_priority;   /* Current priority */
+  uint8_t  ts_basepriority; /* Base priority (before priority inheritance) */
+  uint8_t  ts_cpu;        /* CPU (CONFIG_SMP only) */
+  uint16_t ts_flags;      /* TCB flags (type, policy, ...) */
+  uint16_t ts_nfds;       /* Number of open file descriptors in the group */
+  uint32_t ts_cputicks;   /* CPU load ticks (0 if no CONFIG_SCHED_CPULOAD) */
+  uint32_t ts_stacksize;  /* Size of the stack */
+  uint32_t ts_stackused;  /* Stack high water mark (0 if no CONFIG_STACK_COLORATION) */
+  uint32_t ts_nswitches;  /* Context switches in (0 if no CONFIG_SCHED_SWITCHCOUNT) */
+  char     ts_name[PROCFS_TASKSTATS_NAMELEN]; /* Task name (may be truncated) */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -190,6 +233,39 @@ size_t procfs_memcpy(FAR const char *src, size_t srclen,
                      FAR char *dest, size_t destlen,
                      off_t *offset);
 
+/****************************************************************************
+ * Name: procfs_latencyline
+ *
+ * Description:
+ *   Format one line of a latency histogram (CONFIG_SCHED_LATENCY):  The
+ *   range of latencies and the count for bucket 'ndx' or, if 'ndx' is
+ *   CONFIG_SCHED_LATENCY_NBUCKETS, the longest latency.
+ *
+ * Input Parameters:
+ *   hist    - The histogram to format
+ *   ndx     - The bucket index
+ *   line    - The buffer to receive the line
+ *   linelen - The size of the buffer.  PROCFS_LATENCY_LINELEN bytes hold
+ *             the widest line.
+ *
+ * Returned Value:
+ *   The length of the formatted line.  This is at most linelen - 1 even if
+ *   the line had to be truncated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+/* The widest histogram line is a range of two 10 digit bounds followed by
+ * a count of up to 20 digits and a newline.
+ */
+
+#define PROCFS_LATENCY_LINELEN 48
+
+struct latency_hist_s;
+size_t procfs_latencyline(FAR const struct latency_hist_s *hist, int ndx,
+                          FAR char *line, size_t linelen);
+#endif
+
 /****************************************************************************
  * Name: procfs_register
  *
@@ -0,0 +1,218 @@
+/****************************************************************************
+ * include/nuttx/hrtimer.h
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HRTIMER_H
+#define __INCLUDE_NUTTX_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/tree.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_init
+ *
+ * Description:
+ *   Initialize a high resolution timer structure before its first use.
+ *
+ ****************************************************************************/
+
+#define hrtimer_init(t) do { (t)->active = false; } while (0)
+
+/****************************************************************************
+ * Name: hrtimer_isactive
+ *
+ * Description:
+ *   Return true if the high resolution timer is queued and waiting to
+ *   expire.
+ *
+ ****************************************************************************/
+
+#define hrtimer_isactive(t) ((t)->active)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the form of the function that is called when the high resolution
+ * timer expires.  It is called from the context of the oneshot timer
+ * interrupt handler with the hrtimer that expired.  The callback may
+ * restart the same hrtimer (for example, to implement a periodic timer).
+ */
+
+struct hrtimer_s;
+typedef CODE void (*hrtimer_cb_t)(FAR struct hrtimer_s *hrtimer);
+
+/* This structure describes one high resolution timer.  The structure is
+ * allocated by the caller (typically as part of some larger structure or
+ * on the stack of the thread that will wait for it) and must persist for
+ * as long as the timer is active.
+ */
+
+struct hrtimer_s
+{
+  RB_ENTRY(hrtimer_s) node;        /* Node in the tree of active timers */
+  uint64_t            expired;     /* Absolute expiration time (ns) */
+  hrtimer_cb_t        func;        /* Function to call on expiration */
+  FAR void           *arg;         /* Argument available to the callback */
+  bool                active;      /* True: The timer is queued */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Bind the high resolution timer subsystem to a oneshot timer as
+ *   described in include/nuttx/timers/oneshot.h.  This must be called by
+ *   board-specific logic.  Until it is called, hrtimer_start() will fail
+ *   with -ENODEV and the OS will fall back to tick-based watchdog timers.
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot timer interface.  The oneshot timer
+ *           is then owned by the hrtimer subsystem.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+struct oneshot_lowerhalf_s;
+void hrtimer_initialize(FAR struct oneshot_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the current value of the monotonic clock that is used to
+ *   interpret hrtimer expiration times.  This is the time since power-up
+ *   in nanoseconds.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The current time in nanoseconds.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void);
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start (or restart) a high resolution timer.  If the timer is already
+ *   active, it is first cancelled.  If the expiration time has already
+ *   passed, the callback will be invoked from the oneshot interrupt as soon
+ *   as possible.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to start
+ *   func    - The function to call when the timer expires
+ *   arg     - An opaque argument stored in hrtimer->arg
+ *   expired - The absolute expiration time as returned by
+ *             hrtimer_gettime() (ns)
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure:
+ *
+ *   ENODEV - No oneshot timer has been bound by hrtimer_initialize().
+ *
+ * Assumptions:
+ *   May be called from interrupt level logic.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, hrtimer_cb_t func,
+                  FAR void *arg, uint64_t expired);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.  This is harmless if the timer is not
+ *   active (for example, if it has already expired).
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to cancel
+ *
+ * Returned Value:
+ *   The time remaining before the timer would have expired (ns) or zero if
+ *   the timer was not active.
+ *
+ * Assumptions:
+ *   May be called from interrupt level logic.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_cancel(FAR struct hrtimer_s *hrtimer);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_HRTIMER_H */
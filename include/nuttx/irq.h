@@ -46,6 +46,9 @@
 # include <stdint.h>
 # include <assert.h>
 # include <arch/irq.h>
+# if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+#   include <nuttx/spinlock.h>
+# endif
 #endif
 
 /****************************************************************************
@@ -227,30 +230,39 @@ void leave_critical_section(irqstate_t flags);
  *
  * Description:
  *   If SMP and SPINLOCK_IRQ are enabled:
- *     Disable local interrupts and take the global spinlock (g_irq_spin)
- *     if the call counter (g_irq_spin_count[cpu]) equals to 0. Then the
- *     counter on the CPU is increment to allow nested call.
+ *     If the argument lock is not specified (i.e. NULL), disable local
+ *     interrupts and take the global spinlock (g_irq_spin) if the call
+ *     counter (g_irq_spin_count[cpu]) equals to 0. Then the counter on the
+ *     CPU is increment to allow nested call.
+ *
+ *     If the argument lock is specified, disable local interrupts and take
+ *     the lock spinlock.  This is not nestable.  Subsystems use their own
+ *     lock in this way to protect their private data without taking the
+ *     global critical section lock (g_cpu_irqlock).
  *
  *     NOTE: This API is very simple to protect data (e.g. H/W register
  *     or internal data structure) in SMP mode. But do not use this API
  *     with kernel APIs which suspend a caller thread. (e.g. nxsem_wait)
  *
  *   If SMP and SPINLOCK_IRQ are not enabled:
- *     This function is equivalent to enter_critical_section().
+ *     This function is equivalent to enter_critical_section() and the lock
+ *     argument is ignored.
  *
  * Input Parameters:
- *   None
+ *   lock - Caller specific spinlock, or NULL to use the global spinlock.
+ *          This is a kspinlock_t:  a ticket lock if
+ *          CONFIG_SPINLOCK_KERNEL_TICKET is selected.
  *
  * Returned Value:
  *   An opaque, architecture-specific value that represents the state of
- *   the interrupts prior to the call to spin_lock_irqsave();
+ *   the interrupts prior to the call to spin_lock_irqsave(lock);
  *
  ****************************************************************************/
 
 #if defined (CONFIG_SMP) && defined (CONFIG_SPINLOCK_IRQ)
-irqstate_t spin_lock_irqsave(void);
+irqstate_t spin_lock_irqsave(FAR kspinlock_t *lock);
 #else
-#  define spin_lock_irqsave(f) enter_critical_section(f)
+#  define spin_lock_irqsave(l) enter_critical_section()
 #endif
 
 /****************************************************************************
@@ -258,17 +270,23 @@ irqstate_t spin_lock_irqsave(void);
  *
  * Description:
  *   If SMP and SPINLOCK_IRQ are enabled:
- *     Decrement the call counter (g_irq_spin_count[cpu]) and if it
- *     decrements to zero then release the spinlock (g_irq_spin) and
- *     restore the interrupt state as it was prior to the previous call to
- *     spin_lock_irqsave().
+ *     If the argument lock is not specified (i.e. NULL), decrement the call
+ *     counter (g_irq_spin_count[cpu]) and if it decrements to zero then
+ *     release the spinlock (g_irq_spin) and restore the interrupt state as
+ *     it was prior to the previous call to spin_lock_irqsave(NULL).
+ *
+ *     If the argument lock is specified, release the lock and restore the
+ *     interrupt state as it was prior to the previous call to
+ *     spin_lock_irqsave(lock).
  *
  *   If SMP and SPINLOCK_IRQ are not enabled:
- *     This function is equivalent to leave_critical_section().
+ *     This function is equivalent to leave_critical_section() and the lock
+ *     argument is ignored.
  *
  * Input Parameters:
+ *   lock  - Caller specific spinlock, or NULL to use the global spinlock.
  *   flags - The architecture-specific value that represents the state of
- *           the interrupts prior to the call to spin_lock_irqsave();
+ *           the interrupts prior to the call to spin_lock_irqsave(lock);
  *
  * Returned Value:
  *   None
@@ -276,9 +294,9 @@ irqstate_t spin_lock_irqsave(void);
  ****************************************************************************/
 
 #if defined (CONFIG_SMP) && defined (CONFIG_SPINLOCK_IRQ)
-void spin_unlock_irqrestore(irqstate_t flags);
+void spin_unlock_irqrestore(FAR kspinlock_t *lock, irqstate_t flags);
 #else
-#  define spin_unlock_irqrestore(f) leave_critical_section(f)
+#  define spin_unlock_irqrestore(l,f) leave_critical_section(f)
 #endif
 
 #undef EXTERN
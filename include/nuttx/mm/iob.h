@@ -172,6 +172,16 @@ void iob_initialize(void);
 
 FAR struct iob_s *iob_alloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers that are currently free.
+ *
+ ****************************************************************************/
+
+int iob_navail(void);
+
 /****************************************************************************
  * Name: iob_tryalloc
  *
@@ -51,6 +51,7 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <net/if.h>
 
 #include <net/ethernet.h>
@@ -141,6 +142,36 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Checksum offload capabilities.  A driver sets these in d_offload when its
+ * hardware handles the IPv4 header, TCP, and UDP checksums:
+ *
+ *   NETDEV_OFFLOAD_RXCSUM - The hardware verifies the checksums of received
+ *     packets and discards packets with bad checksums.
+ *   NETDEV_OFFLOAD_TXCSUM - The hardware inserts the checksums of outgoing
+ *     packets.  The network leaves the checksum fields zero.
+ */
+
+#define NETDEV_OFFLOAD_RXCSUM   (1 << 0)
+#define NETDEV_OFFLOAD_TXCSUM   (1 << 1)
+
+#ifdef CONFIG_NETDEV_CHKSUM_OFFLOAD
+#  define NETDEV_RXCSUM_OFFLOAD(dev) \
+     (((dev)->d_offload & NETDEV_OFFLOAD_RXCSUM) != 0)
+#  define NETDEV_TXCSUM_OFFLOAD(dev) \
+     (((dev)->d_offload & NETDEV_OFFLOAD_TXCSUM) != 0)
+#else
+#  define NETDEV_RXCSUM_OFFLOAD(dev) (false)
+#  define NETDEV_TXCSUM_OFFLOAD(dev) (false)
+#endif
+
+/* True if the packet in d_buf is a TCP super-segment (see d_gsosize) */
+
+#ifdef CONFIG_NET_TCP_GSO
+#  define NETDEV_GSO(dev) ((dev)->d_gsosize > 0)
+#else
+#  define NETDEV_GSO(dev) (false)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -205,6 +236,7 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference See iob.h */
 
 struct net_driver_s
 {
@@ -232,6 +264,21 @@ struct net_driver_s
   uint8_t d_lltype;             /* See enum net_lltype_e */
   uint8_t d_llhdrlen;           /* Link layer header size */
   uint16_t d_mtu;               /* Maximum packet size */
+#ifdef CONFIG_NETDEV_CHKSUM_OFFLOAD
+  uint8_t d_offload;            /* See NETDEV_OFFLOAD_* definitions */
+#endif
+#ifdef CONFIG_NET_TCP_GSO
+  /* TCP segmentation offload.  A driver that can accept TCP segments that
+   * carry more than one MSS of data sets d_gsomax to the size of the
+   * largest such frame (including the link layer header) that d_buf can
+   * hold.  When the packet in d_buf is such a super-segment, d_gsosize
+   * holds the amount of TCP data to put in each frame on the wire and the
+   * IPv4 header and TCP checksums have not been calculated.
+   */
+
+  uint16_t d_gsomax;            /* Largest TCP super-segment frame, 0=none */
+  uint16_t d_gsosize;           /* TCP data per segment of the super-segment */
+#endif
 #ifdef CONFIG_NET_TCP
   uint16_t d_recvwndo;          /* TCP receive window size */
 #endif
@@ -285,6 +332,14 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB
+  /* The I/O buffer that holds d_buf when the driver lets the I/O buffer
+   * interface provide the packet buffer (see netdev_iob_input()).
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -463,7 +518,6 @@ int ipv6_input(FAR struct net_driver_s *dev);
 
 #ifdef CONFIG_NET_6LOWPAN
 struct radio_driver_s;   /* Forward reference.  See radiodev.h */
-struct iob_s;            /* Forward reference See iob.h */
 
 int sixlowpan_input(FAR struct radio_driver_s *ieee,
                     FAR struct iob_s *framelist, FAR const void *metadata);
@@ -525,6 +579,43 @@ int sixlowpan_input(FAR struct radio_driver_s *ieee,
 int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 
+/****************************************************************************
+ * Name: netdev_iob_input, netdev_iob_poll, and netdev_iob_timer
+ *
+ * Description:
+ *   The I/O buffer driver interface.  These exchange batches of link layer
+ *   frames, each held in an I/O buffer chain, between the driver and the
+ *   network:
+ *
+ *   netdev_iob_input() - Pass each frame in 'rxq' to the network and add
+ *     any responses to the end of 'txq'.  All of 'rxq' is consumed.
+ *   netdev_iob_poll() - Like devif_poll(), but collect up to 'maxframes'
+ *     outgoing frames in 'txq'.
+ *   netdev_iob_timer() - Like devif_timer(), but collect up to 'maxframes'
+ *     outgoing frames in 'txq'.
+ *
+ *   The network is locked once for the whole batch.  Outgoing frames are
+ *   complete:  arp_out() and neighbor_out() have already been called.  The
+ *   driver owns, and must eventually free, each frame that it removes from
+ *   'txq'.
+ *
+ * Returned Value:
+ *   The number of frames added to 'txq'; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+struct iob_queue_s;      /* Forward reference See iob.h */
+
+int netdev_iob_input(FAR struct net_driver_s *dev,
+                     FAR struct iob_queue_s *rxq,
+                     FAR struct iob_queue_s *txq);
+int netdev_iob_poll(FAR struct net_driver_s *dev,
+                    FAR struct iob_queue_s *txq, unsigned int maxframes);
+int netdev_iob_timer(FAR struct net_driver_s *dev,
+                     FAR struct iob_queue_s *txq, unsigned int maxframes);
+#endif
+
 /****************************************************************************
  * Name: neighbor_out
  *
@@ -76,8 +76,17 @@
 #define TCP_OPT_END       0   /* End of TCP options list */
 #define TCP_OPT_NOOP      1   /* "No-operation" TCP option */
 #define TCP_OPT_MSS       2   /* Maximum segment size TCP option */
+#define TCP_OPT_WS        3   /* Window scale TCP option (RFC 7323) */
+#define TCP_OPT_SACK_PERM 4   /* SACK permitted TCP option (RFC 2018) */
+#define TCP_OPT_SACK      5   /* SACK TCP option (RFC 2018) */
 
 #define TCP_OPT_MSS_LEN   4   /* Length of TCP MSS option. */
+#define TCP_OPT_WS_LEN    3   /* Length of TCP window scale option. */
+#define TCP_OPT_SACK_PERM_LEN 2 /* Length of TCP SACK permitted option. */
+#define TCP_OPT_SACK_LEN(n) (2 + ((n) << 3)) /* Length of SACK option with
+                                              * n blocks */
+
+#define TCP_MAX_WS        14  /* Maximum window scale shift (RFC 7323) */
 
 /* The TCP states used in the struct tcp_conn_s tcpstateflags field */
 
@@ -180,6 +189,10 @@ struct tcp_stats_s
   net_stats_t syndrop;    /* Number of dropped SYNs due to too few
                              available connections */
   net_stats_t synrst;     /* Number of SYNs for closed ports triggering a RST */
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  net_stats_t dlyack;     /* Number of ACKs that were delayed */
+  net_stats_t acksaved;   /* Number of pure ACKs saved by delaying */
+#endif
 };
 #endif
 
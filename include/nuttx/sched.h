@@ -538,6 +538,20 @@ struct task_group_s
 };
 #endif
 
+/* struct latency_hist_s *********************************************************/
+/* A log2 histogram of latencies in microseconds (CONFIG_SCHED_LATENCY).  Bucket 0
+ * counts latencies below 1 microsecond, bucket n counts latencies in the range
+ * [2**(n-1), 2**n) and the last bucket also counts all longer latencies.
+ */
+
+#ifdef CONFIG_SCHED_LATENCY
+struct latency_hist_s
+{
+  uint32_t lh_count[CONFIG_SCHED_LATENCY_NBUCKETS];
+  uint32_t lh_max;                       /* Longest latency (microseconds)      */
+};
+#endif
+
 /* struct tcb_s ******************************************************************/
 /* This is the common part of the task control block (TCB).  The TCB is the heart
  * of the NuttX task-control logic.  Each task or thread is represented by a TCB
@@ -596,6 +610,23 @@ struct tcb_s
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters      */
 #endif
+#ifdef CONFIG_SCHED_BALANCE
+  uint32_t nmigrations;                  /* Number of times moved by balancer   */
+#endif
+#ifdef CONFIG_SCHED_SWITCHCOUNT
+  uint32_t nswitches;                    /* Number of times switched in         */
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+  uint32_t readytime;                    /* up_perf_gettime() when made ready   */
+                                         /* to run (0 if not pending)           */
+  struct latency_hist_s schedlat;        /* Ready-to-run to running latency     */
+  struct latency_hist_s semwait;         /* Time blocked in nxsem_wait()        */
+#endif
+#ifdef CONFIG_SCHED_CPUTIME
+  uint32_t runstart;                     /* up_perf_gettime() when switched in  */
+                                         /* (0 if not running)                  */
+  uint64_t runtime;                      /* CPU time used in up_perf counts     */
+#endif
 
   FAR struct wdog_s *waitdog;            /* All timed waits use this timer      */
 
@@ -618,6 +649,10 @@ struct tcb_s
   /* POSIX Semaphore Control Fields *********************************************/
 
   sem_t *waitsem;                        /* Semaphore ID waiting on             */
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  FAR struct semholder_s *holdsem;       /* List of semaphores held by thread   */
+  FAR struct tcb_s *semwlink;            /* Next thread waiting for waitsem     */
+#endif
 
   /* POSIX Signal Control Fields ************************************************/
 
@@ -766,6 +801,15 @@ void sched_foreach(sched_foreach_t handler, FAR void *arg);
 
 FAR struct tcb_s *sched_gettcb(pid_t pid);
 
+/* Return a snapshot of the wake-up latency and semaphore wait histograms of one
+ * thread or, if pid is negative, of the whole system.
+ */
+
+#ifdef CONFIG_SCHED_LATENCY
+int sched_latency(pid_t pid, FAR struct latency_hist_s *schedlat,
+                  FAR struct latency_hist_s *semwait);
+#endif
+
 /* File system helpers **********************************************************/
 /* These functions all extract lists from the group structure assocated with the
  * currently executing task.
@@ -851,7 +895,8 @@ void task_vforkabort(FAR struct task_tcb_s *child, int errcode);
  ********************************************************************************/
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
-    defined(CONFIG_SCHED_INSTRUMENTATION)
+    defined(CONFIG_SCHED_INSTRUMENTATION) || defined(CONFIG_SCHED_SWITCHCOUNT) || \
+    defined(CONFIG_SCHED_LATENCY) || defined(CONFIG_SCHED_CPUTIME)
 void sched_resume_scheduler(FAR struct tcb_s *tcb);
 #else
 #  define sched_resume_scheduler(tcb)
@@ -873,7 +918,8 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb);
  *
  ********************************************************************************/
 
-#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION)
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_LATENCY) || defined(CONFIG_SCHED_CPUTIME)
 void sched_suspend_scheduler(FAR struct tcb_s *tcb);
 #else
 #  define sched_suspend_scheduler(tcb)
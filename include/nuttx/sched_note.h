@@ -45,8 +45,10 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/fs/ioctl.h>
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION
 
@@ -66,6 +68,17 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+/* IOCTL Commands ***********************************************************/
+/* NOTEIOC_DROPPED
+ *   Description: Return the number of notes discarded because a per-CPU
+ *                note buffer was full.  Only supported with
+ *                CONFIG_SCHED_NOTE_PERCPU.
+ *   Argument:    A reference to an unsigned long value to receive the count
+ *   Return:      Zero (OK)
+ */
+
+#define NOTEIOC_DROPPED        _NOTEIOC(0x0001)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -106,6 +119,15 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+  ,
+  NOTE_BPRINTF         = 18
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+  ,
+  NOTE_IRQ_ENTER       = 19,
+  NOTE_IRQ_LEAVE       = 20
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -119,7 +141,10 @@ struct note_common_s
   uint8_t nc_cpu;              /* CPU thread/task running on */
 #endif
   uint8_t nc_pid[2];           /* ID of the thread/task */
-  uint8_t nc_systime[4];       /* Time when note was buffered */
+  uint8_t nc_systime[4];       /* Time when note was buffered (system
+                                * timer ticks or, with
+                                * CONFIG_SCHED_NOTE_PERFTIME, the value of
+                                * up_perf_gettime()) */
 };
 
 /* This is the specific form of the NOTE_START note */
@@ -234,6 +259,39 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+/* This is the specific form of the NOTE_BPRINTF note.  The note holds the
+ * address of the format string (not the string itself) followed by the
+ * raw argument values in native byte order:  Integer and pointer arguments
+ * are stored with the size of their C type, floating point arguments as
+ * double, and %s arguments as a copy of the NUL-terminated string.  The
+ * note is formatted only when it is read out, typically on the host with
+ * tools/notedecode.py.  Arguments that did not fit in the note are
+ * omitted.
+ */
+
+struct note_bprintf_s
+{
+  struct note_common_s nbp_cmn; /* Common note parameters */
+  uint8_t nbp_level;            /* SYSLOG priority (LOG_EMERG..LOG_DEBUG) */
+  uint8_t nbp_fmt[sizeof(uintptr_t)]; /* Address of the format string */
+  uint8_t nbp_data[1];          /* Start of the raw argument data */
+};
+
+#define SIZEOF_NOTE_BPRINTF(n) (sizeof(struct note_bprintf_s) + (n) - 1)
+#endif /* CONFIG_SCHED_INSTRUMENTATION_BPRINTF */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+/* This is the specific form of the NOTE_IRQ_ENTER/LEAVE note */
+
+struct note_irqhandler_s
+{
+  struct note_common_s nih_cmn; /* Common note parameters */
+  uint8_t nih_handler[sizeof(uintptr_t)]; /* Address of the handler */
+  uint8_t nih_irq;              /* IRQ number */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -293,6 +351,12 @@ void sched_note_csection(FAR struct tcb_s *tcb, bool enter);
 #  define sched_note_csection(t,e)
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+void sched_note_irqhandler(int irq, FAR void *handler, bool enter);
+#else
+#  define sched_note_irqhandler(i,h,e)
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
 void sched_note_spinlock(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 void sched_note_spinlocked(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
@@ -305,6 +369,35 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #  define sched_note_spinabort(t,s)
 #endif
 
+/****************************************************************************
+ * Name: sched_note_bprintf and sched_note_vbprintf
+ *
+ * Description:
+ *   Add a binary printf-style note to the instrumentation buffer.  Only the
+ *   address of the format string and the raw argument values are recorded;
+ *   formatting is deferred until the note is read out.  The format string
+ *   must therefore be a constant string that remains valid and is present
+ *   in the firmware image.
+ *
+ *   Unlike the other sched_note_* interfaces, these may be called from any
+ *   context.
+ *
+ * Input Parameters:
+ *   level - The SYSLOG priority of the message (LOG_EMERG..LOG_DEBUG).
+ *   fmt   - The printf-style format string.
+ *   ap    - The argument list.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+void sched_note_bprintf(uint8_t level, FAR const IPTR char *fmt, ...);
+void sched_note_vbprintf(uint8_t level, FAR const IPTR char *fmt,
+                         va_list ap);
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -348,6 +441,26 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen);
 ssize_t sched_note_size(void);
 #endif
 
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were discarded because a per-CPU note
+ *   buffer was full.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of notes dropped on all CPUs.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_SCHED_NOTE_PERCPU)
+unsigned long sched_note_dropped(void);
+#endif
+
 /****************************************************************************
  * Name: note_register
  *
@@ -383,6 +496,7 @@ int note_register(void);
 #  define sched_note_cpu_resumed(t)
 #  define sched_note_premption(t,l)
 #  define sched_note_csection(t,e)
+#  define sched_note_irqhandler(i,h,e)
 #  define sched_note_spinlock(t,s)
 #  define sched_note_spinlocked(t,s)
 #  define sched_note_spinunlock(t,s)
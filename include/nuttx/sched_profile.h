@@ -0,0 +1,187 @@
+/****************************************************************************
+ * include/nuttx/sched_profile.h
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SCHED_PROFILE_H
+#define __INCLUDE_NUTTX_SCHED_PROFILE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/ioctl.h>
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* IOCTL Commands ***********************************************************/
+/* PROFIOC_START
+ *   Description: Discard all buffered samples, clear the count of dropped
+ *                samples and (re-)start sampling.  Sampling is started
+ *                when the system boots.
+ *   Argument:    None
+ *   Return:      Zero (OK)
+ *
+ * PROFIOC_STOP
+ *   Description: Stop sampling.  The buffered samples may still be read.
+ *   Argument:    None
+ *   Return:      Zero (OK)
+ *
+ * PROFIOC_DROPPED
+ *   Description: Return the number of samples discarded because a sample
+ *                buffer was full.
+ *   Argument:    A reference to an unsigned long value to receive the count
+ *   Return:      Zero (OK)
+ */
+
+#define PROFIOC_START          _PROFIOC(0x0001)
+#define PROFIOC_STOP           _PROFIOC(0x0002)
+#define PROFIOC_DROPPED        _PROFIOC(0x0003)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the form of one sample as read from /dev/profile.  Like the
+ * scheduler notes, the sample is packed into byte arrays so that it has no
+ * padding.  Multi-byte values are in little-endian order.
+ */
+
+struct profile_sample_s
+{
+  uint8_t ps_pc[sizeof(uintptr_t)]; /* Interrupted program counter */
+  uint8_t ps_pid[2];                /* ID of the interrupted task */
+  uint8_t ps_cpu;                   /* CPU that took the sample */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Record one profiler sample:  The interrupted program counter and the
+ *   ID of the task running on this CPU.  This is called from
+ *   sched_process_timer() or, if CONFIG_ARCH_HAVE_PROFILE_TIMER is selected,
+ *   from the architecture's profiling timer.
+ *
+ * Input Parameters:
+ *   pc - The interrupted program counter.  Zero values are ignored.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt.  Never called concurrently on the
+ *   same CPU.
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(uintptr_t pc);
+
+/****************************************************************************
+ * Name: sched_profile_start and sched_profile_stop
+ *
+ * Description:
+ *   sched_profile_start() discards all buffered samples and starts
+ *   sampling.  sched_profile_stop() stops sampling.
+ *
+ ****************************************************************************/
+
+void sched_profile_start(void);
+void sched_profile_stop(void);
+
+/****************************************************************************
+ * Name: sched_profile_get
+ *
+ * Description:
+ *   Remove the oldest buffered samples, taking them from each CPU's buffer
+ *   in turn.
+ *
+ * Input Parameters:
+ *   samples  - Location to return the samples
+ *   nsamples - The maximum number of samples to return
+ *
+ * Returned Value:
+ *   The number of samples returned.  Zero is returned if no samples are
+ *   buffered.
+ *
+ ****************************************************************************/
+
+size_t sched_profile_get(FAR struct profile_sample_s *samples,
+                         size_t nsamples);
+
+/****************************************************************************
+ * Name: sched_profile_dropped
+ *
+ * Description:
+ *   Return the number of samples that were discarded because a sample
+ *   buffer was full.
+ *
+ ****************************************************************************/
+
+unsigned long sched_profile_dropped(void);
+
+/****************************************************************************
+ * Name: profile_register
+ *
+ * Description:
+ *   Register a driver at /dev/profile that can be used by an application
+ *   to read the profiler samples.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_PROFILE
+int profile_register(void);
+#endif
+
+#endif /* CONFIG_SCHED_PROFILE */
+#endif /* __INCLUDE_NUTTX_SCHED_PROFILE_H */
@@ -524,6 +524,34 @@ int nxsem_setprotocol(FAR sem_t *sem, int protocol);
 
 int sem_setprotocol(FAR sem_t *sem, int protocol);
 
+/****************************************************************************
+ * Name: sem_futexwait, sem_futextrywait, and sem_futexwake
+ *
+ * Description:
+ *   The kernel slow paths for the user-space semaphore fast path.  These
+ *   system calls are used by the user-space sem_wait(), sem_trywait() and
+ *   sem_post() only when the semaphore count cannot simply be adjusted with
+ *   an atomic compare-and-exchange:  When the caller must block, when a
+ *   waiting thread must be awakened, or when the semaphore uses priority
+ *   inheritance.  They are otherwise identical to sem_wait(), sem_trywait()
+ *   and sem_post().
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor; the user address that identifies the wait
+ *         queue.
+ *
+ * Return Value:
+ *   Zero (OK) if successful.  Otherwise, -1 (ERROR) is returned and the
+ *   errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_FASTPATH
+int sem_futexwait(FAR sem_t *sem);
+int sem_futextrywait(FAR sem_t *sem);
+int sem_futexwake(FAR sem_t *sem);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
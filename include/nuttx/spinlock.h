@@ -100,11 +100,49 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_SPINLOCK_TICKET
+/* A ticket spinlock.  Waiters are granted the lock in FIFO order and spin
+ * only reading st_owner.  Only the short ticket draw uses up_testset().
+ */
+
+struct spin_ticket_s
+{
+  volatile uint16_t st_next;    /* Next ticket to be drawn */
+  volatile uint16_t st_owner;   /* Ticket currently holding the lock */
+  volatile spinlock_t st_guard; /* Serializes the ticket draw */
+};
+
+#  define SPIN_TICKET_INITIALIZER { 0, 0, SP_UNLOCKED }
+#endif
+
+/* A kernel spinlock.  The global and subsystem locks taken with
+ * spin_lock_irqsave() and the lock in struct spinlock_s are kernel
+ * spinlocks.  CONFIG_SPINLOCK_KERNEL_TICKET selects FIFO ticket spinlocks
+ * for them; otherwise they are test-and-set spinlocks.
+ */
+
+#ifdef CONFIG_SPINLOCK_KERNEL_TICKET
+typedef struct spin_ticket_s kspinlock_t;
+
+#  define KSPINLOCK_INITIALIZER  SPIN_TICKET_INITIALIZER
+#  define kspin_initialize(l)    spin_ticket_initialize(l)
+#  define kspin_lock(l)          spin_ticket_lock(l)
+#  define kspin_unlock(l)        spin_ticket_unlock(l)
+#  define kspin_islocked(l)      ((l)->st_owner != (l)->st_next)
+#else
+typedef volatile spinlock_t kspinlock_t;
+
+#  define KSPINLOCK_INITIALIZER  SP_UNLOCKED
+#  define kspin_initialize(l)    spin_initialize(l, SP_UNLOCKED)
+#  define kspin_lock(l)          spin_lock(l)
+#  define kspin_unlock(l)        spin_unlock(l)
+#  define kspin_islocked(l)      spin_islocked(l)
+#endif
+
 struct spinlock_s
 {
-  volatile spinlock_t sp_lock;  /* Indicates if the spinlock is locked or
-                                 * not.  See the* values SP_LOCKED and
-                                 * SP_UNLOCKED. */
+  kspinlock_t sp_lock;          /* Indicates if the spinlock is locked or
+                                 * not.  See kspin_islocked(). */
 #ifdef CONFIG_SMP
   uint8_t  sp_cpu;              /* CPU holding the lock */
   uint16_t sp_count;            /* The count of references by this CPU on
@@ -112,6 +150,22 @@ struct spinlock_s
 #endif
 };
 
+#ifdef CONFIG_SPINLOCK_STATS
+/* Contention statistics for one registered spinlock.  The counts are only
+ * modified by the CPU that holds the lock.
+ */
+
+struct spinlock_stats_s
+{
+  FAR volatile void *ss_lock;       /* The registered spinlock */
+  FAR const char *ss_name;          /* Name of the spinlock */
+  uint32_t ss_acquired;             /* Number of times the lock was taken */
+  uint32_t ss_contended;            /* Number of times the lock was busy */
+  uint32_t ss_spins;                /* Number of failed attempts to take it */
+  uint32_t ss_maxspins;             /* Longest wait for the lock (spins) */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -319,7 +373,7 @@ void spin_unlockr(FAR struct spinlock_s *lock);
  ****************************************************************************/
 
 /* bool spin_islockedr(FAR struct spinlock_s *lock); */
-#define spin_islockedr(l) ((l)->sp_lock == SP_LOCKED)
+#define spin_islockedr(l) kspin_islocked(&(l)->sp_lock)
 
 /****************************************************************************
  * Name: spin_setbit
@@ -363,5 +417,150 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *setlock,
                  FAR volatile spinlock_t *orlock);
 
+/****************************************************************************
+ * Name: spin_ticket_initialize
+ *
+ * Description:
+ *   Initialize a ticket spinlock object to its initial, unlocked state.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to be initialized.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_ticket_initialize(FAR struct spin_ticket_s *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_ticket_lock
+ *
+ * Description:
+ *   Draw a ticket and wait until that ticket is served.  Contending CPUs
+ *   acquire the lock in the order in which they arrived.
+ *
+ *   Like spin_lock(), this implementation is non-reentrant.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_ticket_lock(FAR struct spin_ticket_s *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_ticket_trylock
+ *
+ * Description:
+ *   Take the ticket spinlock only if it is available and nobody is waiting
+ *   for it.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+spinlock_t spin_ticket_trylock(FAR struct spin_ticket_s *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_ticket_unlock
+ *
+ * Description:
+ *   Release a ticket spinlock, passing it to the next waiter (if any).
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_ticket_unlock(FAR struct spin_ticket_s *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_stats_register
+ *
+ * Description:
+ *   Register a spinlock so that contention statistics are collected for it.
+ *   At most CONFIG_SPINLOCK_NSTATS spinlocks may be registered.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock to be monitored (spinlock_t or
+ *          struct spin_ticket_s).
+ *   name - A name for the spinlock.  The string must persist.
+ *
+ * Returned Value:
+ *   None.  If there is no free statistics entry, the lock is not monitored.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_stats_register(FAR volatile void *lock, FAR const char *name);
+#else
+#  define spin_stats_register(l,n)
+#endif
+
+/****************************************************************************
+ * Name: spin_stats_update
+ *
+ * Description:
+ *   Account for one acquisition of a spinlock.  Has no effect if the
+ *   spinlock is not registered.
+ *
+ * Input Parameters:
+ *   lock   - A reference to the spinlock that was just taken.
+ *   nspins - The number of failed attempts before the lock was taken.
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   The caller holds the spinlock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_stats_update(FAR volatile void *lock, uint32_t nspins);
+#else
+#  define spin_stats_update(l,n)
+#endif
+
+/****************************************************************************
+ * Name: spin_stats_get
+ *
+ * Description:
+ *   Return a snapshot of the statistics for one registered spinlock.
+ *
+ * Input Parameters:
+ *   ndx   - The index of the statistics entry, 0..CONFIG_SPINLOCK_NSTATS-1
+ *   stats - The location to return the statistics.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the index is not in use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+int spin_stats_get(int ndx, FAR struct spinlock_stats_s *stats);
+#endif
+
 #endif /* CONFIG_SPINLOCK */
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
@@ -54,6 +54,10 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/syslog/syslog.h>
 
 #ifdef CONFIG_RAMLOG
@@ -77,6 +81,10 @@
  *   used to generate debug output from interrupt level handlers.
  * CONFIG_RAMLOG_NPOLLWAITERS - The number of threads than can be waiting
  *   for this driver on poll().  Default: 4
+ * CONFIG_RAMLOG_STREAMING - Reads do not consume data.  Each open file has
+ *   its own read position, new data overwrites the oldest records, and the
+ *   number of records that a reader lost can be queried with
+ *   RAMLOGIOC_GETSTATUS.
  *
  * If CONFIG_RAMLOG_CONSOLE or CONFIG_RAMLOG_SYSLOG is selected, then the
  * following may also be provided:
@@ -109,12 +117,42 @@
 #  define CONFIG_RAMLOG_CRLF 1
 #endif
 
+/* IOCTL Commands ***********************************************************/
+/* RAMLOGIOC_GETSTATUS - Get the status of this open file's read position.
+ *   Only available with CONFIG_RAMLOG_STREAMING.
+ *
+ *   ioctl argument:  A pointer to a writable instance of struct
+ *   ramlog_status_s.
+ */
+
+#define RAMLOGIOC_GETSTATUS _RAMLOGIOC(0x0001)
+
 /****************************************************************************
- * Public Data
+ * Public Types
  ****************************************************************************/
 
 #ifndef __ASSEMBLY__
 
+#ifdef CONFIG_RAMLOG_STREAMING
+/* This is the form of the RAMLOGIOC_GETSTATUS ioctl argument.  A record is
+ * a sequence of characters terminated by a line feed.  Records are numbered
+ * sequentially from zero (the first record written after power up).
+ */
+
+struct ramlog_status_s
+{
+  uint32_t rs_seq;      /* Sequence number of the next record to be read */
+  uint32_t rs_headseq;  /* Sequence number of the record being written */
+  uint32_t rs_firstseq; /* Sequence number of the oldest record retained */
+  uint32_t rs_nlost;    /* Records overwritten before this reader got them */
+  uint32_t rs_navail;   /* Bytes available to this reader */
+};
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
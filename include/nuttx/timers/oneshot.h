@@ -148,6 +148,28 @@
 
 #define ONESHOT_CANCEL(l,t) ((l)->ops->cancel(l,t))
 
+/****************************************************************************
+ * Name: ONESHOT_CURRENT
+ *
+ * Description:
+ *   Return the current value of the free-running clock against which the
+ *   oneshot timer delays are measured.  This method is optional:  Lower
+ *   halves that have no such clock leave it NULL.
+ *
+ * Input Parameters:
+ *   lower   Caller allocated instance of the oneshot state structure.  This
+ *           structure must have been previously initialized via a call to
+ *           oneshot_initialize();
+ *   ts      The location in which to return the current time.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#define ONESHOT_CURRENT(l,t) ((l)->ops->current(l,t))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -175,6 +197,8 @@ struct oneshot_operations_s
                     FAR const struct timespec *ts);
   CODE int (*cancel)(struct oneshot_lowerhalf_s *lower,
                      FAR struct timespec *ts);
+  CODE int (*current)(FAR struct oneshot_lowerhalf_s *lower,
+                      FAR struct timespec *ts);
 };
 
 /* This structure describes the state of the oneshot timer lower-half driver */
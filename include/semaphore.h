@@ -71,14 +71,16 @@ struct semholder_s
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   struct semholder_s *flink;     /* Implements singly linked list */
 #endif
+  struct semholder_s *tlink;     /* Next semaphore held by the same thread */
   FAR struct tcb_s *htcb;        /* Holder TCB */
   int16_t counts;                /* Number of counts owned by this holder */
+  uint8_t waitprio;              /* Priority of highest priority waiter */
 };
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, 0, 0}
 #else
-#  define SEMHOLDER_INITIALIZER {NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0, 0}
 #endif
 #endif /* CONFIG_PRIORITY_INHERITANCE */
 
@@ -94,6 +96,7 @@ struct sem_s
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t flags;                 /* See PRIOINHERIT_FLAGS_* definitions */
+  FAR struct tcb_s *whead;       /* List of threads waiting for a count */
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *hhead; /* List of holders of semaphore counts */
 # else
@@ -109,10 +112,10 @@ typedef struct sem_s sem_t;
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
 #  define SEM_INITIALIZER(c) \
-    {(c), 0, NULL}               /* semcount, flags, hhead */
+    {(c), 0, NULL, NULL}         /* semcount, flags, whead, hhead */
 # else
 #  define SEM_INITIALIZER(c) \
-    {(c), 0, {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}} /* semcount, flags, holder[2] */
+    {(c), 0, NULL, {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}} /* semcount, flags, whead, holder[2] */
 # endif
 #else
 #  define SEM_INITIALIZER(c) \
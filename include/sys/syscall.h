@@ -86,10 +86,21 @@
 /* Semaphores */
 
 #define SYS_sem_destroy                (CONFIG_SYS_RESERVED+15)
-#define SYS_sem_post                   (CONFIG_SYS_RESERVED+16)
-#define SYS_sem_timedwait              (CONFIG_SYS_RESERVED+17)
-#define SYS_sem_trywait                (CONFIG_SYS_RESERVED+18)
-#define SYS_sem_wait                   (CONFIG_SYS_RESERVED+19)
+#ifdef CONFIG_SEM_FASTPATH
+/* The user-space library implements sem_post(), sem_trywait(), and
+ * sem_wait() and traps into the kernel only on contention.
+ */
+
+#  define SYS_sem_futexwake            (CONFIG_SYS_RESERVED+16)
+#  define SYS_sem_timedwait            (CONFIG_SYS_RESERVED+17)
+#  define SYS_sem_futextrywait         (CONFIG_SYS_RESERVED+18)
+#  define SYS_sem_futexwait            (CONFIG_SYS_RESERVED+19)
+#else
+#  define SYS_sem_post                 (CONFIG_SYS_RESERVED+16)
+#  define SYS_sem_timedwait            (CONFIG_SYS_RESERVED+17)
+#  define SYS_sem_trywait              (CONFIG_SYS_RESERVED+18)
+#  define SYS_sem_wait                 (CONFIG_SYS_RESERVED+19)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 #  define SYS_sem_setprotocol          (CONFIG_SYS_RESERVED+20)
@@ -40,17 +40,115 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 
 #include "libc.h"
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0 || CONFIG_NFILE_DESCRIPTORS > 0
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile_xip
+ *
+ * Description:
+ *   If the input file is a regular file whose data is directly addressable
+ *   in memory (as with ROMFS on XIP media), write the data to outfd directly
+ *   from that memory, avoiding the intermediate I/O buffer and the read()
+ *   copy.  On return, the file position of infd is advanced past the bytes
+ *   transferred.
+ *
+ * Returned Value:
+ *   The number of bytes transferred;  ERROR on a write failure (with errno
+ *   set);  or -ENOTTY if the input file data is not directly addressable
+ *   and the normal read/write loop must be used.
+ *
+ ****************************************************************************/
+
+static ssize_t sendfile_xip(int outfd, int infd, size_t count)
+{
+  FAR const uint8_t *xipbase = NULL;
+  struct stat buf;
+  ssize_t nbyteswritten;
+  ssize_t ntransferred;
+  off_t curpos;
+
+  if (fstat(infd, &buf) < 0 || !S_ISREG(buf.st_mode))
+    {
+      return -ENOTTY;
+    }
+
+  if (ioctl(infd, FIOC_MMAP, (unsigned long)((uintptr_t)&xipbase)) < 0 ||
+      xipbase == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  curpos = lseek(infd, 0, SEEK_CUR);
+  if (curpos == (off_t)-1)
+    {
+      return -ENOTTY;
+    }
+
+  /* Truncate the transfer at the end of the file */
+
+  if (curpos >= buf.st_size)
+    {
+      count = 0;
+    }
+  else if (count > (size_t)(buf.st_size - curpos))
+    {
+      count = buf.st_size - curpos;
+    }
+
+  for (ntransferred = 0; (size_t)ntransferred < count; )
+    {
+      nbyteswritten = _NX_WRITE(outfd, xipbase + curpos + ntransferred,
+                                count - ntransferred);
+      if (nbyteswritten < 0)
+        {
+#ifndef CONFIG_DISABLE_SIGNALS
+          int errcode = _NX_GETERRNO(nbyteswritten);
+
+          /* EINTR is not an error if some data has been transferred (but
+           * will still stop the copy).
+           */
+
+          if (errcode == EINTR && ntransferred > 0)
+            {
+              break;
+            }
+#endif
+
+          _NX_SETERRNO(nbyteswritten);
+          ntransferred = ERROR;
+          break;
+        }
+
+      ntransferred += nbyteswritten;
+    }
+
+  /* Update the file position to reflect the bytes "read" */
+
+  if (ntransferred > 0)
+    {
+      (void)lseek(infd, curpos + ntransferred, SEEK_SET);
+    }
+
+  return ntransferred;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -133,6 +231,15 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
         }
     }
 
+  /* Try to write directly from the input file data */
+
+  nbyteswritten = sendfile_xip(outfd, infd, count);
+  if (nbyteswritten != -ENOTTY)
+    {
+      ntransferred = nbyteswritten;
+      goto update_offset;
+    }
+
   /* Allocate an I/O buffer */
 
   iobuffer = (FAR void *)lib_malloc(CONFIG_LIB_SENDFILE_BUFSIZE);
@@ -263,6 +370,8 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
   lib_free(iobuffer);
 
+update_offset:
+
   /* Return the current file position */
 
   if (offset)
@@ -0,0 +1,212 @@
+/****************************************************************************
+ * libc/semaphore/sem_fastpath.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <limits.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+
+/* The kernel itself uses the full OS semaphore logic.  Only the user-space
+ * library in the PROTECTED or KERNEL build provides these fast paths.
+ */
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_fastok
+ *
+ * Description:
+ *   Return true if the semaphore count may be manipulated in user space.
+ *   Semaphores that participate in priority inheritance must always go
+ *   through the OS so that the holder list is maintained.
+ *
+ ****************************************************************************/
+
+static inline bool sem_fastok(FAR sem_t *sem)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  return (sem->flags & PRIOINHERIT_FLAGS_DISABLE) != 0;
+#else
+  return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: sem_fasttake
+ *
+ * Description:
+ *   Attempt to take one count from the semaphore with a compare-and-
+ *   exchange.  This fails if the count is not positive.
+ *
+ ****************************************************************************/
+
+static bool sem_fasttake(FAR sem_t *sem)
+{
+  int16_t semcount;
+
+  do
+    {
+      semcount = sem->semcount;
+      if (semcount <= 0)
+        {
+          return false;
+        }
+    }
+  while (!__sync_bool_compare_and_swap(&sem->semcount, semcount,
+                                       (int16_t)(semcount - 1)));
+
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_wait
+ *
+ * Description:
+ *   The user-space sem_wait().  If a count is available, it is taken with
+ *   an atomic compare-and-exchange without entering the OS.  Otherwise,
+ *   sem_futexwait() is called to block the caller.
+ *
+ *   NOTE:  sem_wait() is a cancellation point.  That check is performed
+ *   only when the OS is entered, i.e., only when the caller would block.
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success.  Otherwise, -1 (ERROR) is returned
+ *   and the errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+int sem_wait(FAR sem_t *sem)
+{
+  if (sem != NULL && sem_fastok(sem) && sem_fasttake(sem))
+    {
+      return OK;
+    }
+
+  return sem_futexwait(sem);
+}
+
+/****************************************************************************
+ * Name: sem_trywait
+ *
+ * Description:
+ *   The user-space sem_trywait().  If a count is available, it is taken
+ *   with an atomic compare-and-exchange without entering the OS.
+ *   Otherwise, sem_futextrywait() is called so that the OS can make the
+ *   final decision and set the errno value.
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success.  Otherwise, -1 (ERROR) is returned
+ *   and the errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+int sem_trywait(FAR sem_t *sem)
+{
+  if (sem != NULL && sem_fastok(sem) && sem_fasttake(sem))
+    {
+      return OK;
+    }
+
+  return sem_futextrywait(sem);
+}
+
+/****************************************************************************
+ * Name: sem_post
+ *
+ * Description:
+ *   The user-space sem_post().  If no thread is waiting for the semaphore
+ *   (the count is non-negative), the count is incremented with an atomic
+ *   compare-and-exchange without entering the OS.  Otherwise,
+ *   sem_futexwake() is called to awaken the highest priority waiter.
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success.  Otherwise, -1 (ERROR) is returned
+ *   and the errno value is set appropriately.
+ *
+ ****************************************************************************/
+
+int sem_post(FAR sem_t *sem)
+{
+  int16_t semcount;
+
+  if (sem != NULL && sem_fastok(sem))
+    {
+      do
+        {
+          semcount = sem->semcount;
+          if (semcount < 0 || semcount >= SEM_VALUE_MAX)
+            {
+              /* There are waiters (or the count would overflow):  Let the
+               * OS deal with it.
+               */
+
+              return sem_futexwake(sem);
+            }
+        }
+      while (!__sync_bool_compare_and_swap(&sem->semcount, semcount,
+                                           (int16_t)(semcount + 1)));
+
+      return OK;
+    }
+
+  return sem_futexwake(sem);
+}
+
+#endif /* CONFIG_SEM_FASTPATH && !__KERNEL__ */
@@ -142,9 +142,11 @@ void arp_out(FAR struct net_driver_s *dev)
   in_addr_t                   ipaddr;
   in_addr_t                   destipaddr;
 
-#if defined(CONFIG_NET_PKT) || defined(CONFIG_NET_ARP_SEND)
+#if defined(CONFIG_NET_PKT) || defined(CONFIG_NET_ARP_SEND) || \
+    defined(CONFIG_NET_IPFORWARD_FLOWCACHE)
   /* Skip sending ARP requests when the frame to be transmitted was
-   * written into a packet socket.
+   * written into a packet socket or already carries the link layer header
+   * of a forwarded flow.
    */
 
   if (IFF_IS_NOARP(dev->d_flags))
@@ -260,6 +262,12 @@ void arp_out(FAR struct net_driver_s *dev)
 
       arp_format(dev, ipaddr);
       arp_dump(ARPBUF);
+
+#ifdef CONFIG_NET_TCP_GSO
+      /* The ARP request is not a TCP super-segment */
+
+      dev->d_gsosize = 0;
+#endif
       return;
     }
 
@@ -41,6 +41,8 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <net/if.h>
+
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 
@@ -60,8 +62,13 @@
  *   Called from protocol-specific IP forwarding logic to re-send a packet.
  *
  * Input Parameters:
- *   fwd - An initialized instance of the common forwarding structure that
- *         includes everything needed to perform the forwarding operation.
+ *   fwd      - An initialized instance of the common forwarding structure
+ *              that includes everything needed to perform the forwarding
+ *              operation.
+ *   zerocopy - True if the packet need not be retained after it is sent.
+ *              The I/O buffer that holds the packet may then be given to
+ *              the device rather than copied into d_buf.  In that case
+ *              fwd->f_iob is NULL on return.
  *
  * Returned Value:
  *   None
@@ -71,26 +78,69 @@
  *
  ****************************************************************************/
 
-void devif_forward(FAR struct forward_s *fwd)
+void devif_forward(FAR struct forward_s *fwd, bool zerocopy)
 {
+  FAR struct net_driver_s *dev;
+  FAR struct iob_s *iob;
   unsigned int offset;
+  unsigned int pktlen;
   int ret;
 
   DEBUGASSERT(fwd != NULL && fwd->f_iob != NULL && fwd->f_dev != NULL);
-  offset = NET_LL_HDRLEN(fwd->f_dev);
-
-  /* Copy the IOB chain that contains the L3L3 headers and any data payload */
-
-  DEBUGASSERT(offset + fwd->f_iob->io_pktlen <= NET_DEV_MTU(fwd->f_dev));
-  ret = iob_copyout(&fwd->f_dev->d_buf[offset], fwd->f_iob,
-                    fwd->f_iob->io_pktlen, 0);
-
-  DEBUGASSERT(ret == fwd->f_iob->io_pktlen);
-
-  fwd->f_dev->d_sndlen = 0;
-  fwd->f_dev->d_len    = fwd->f_iob->io_pktlen;
-
-  UNUSED(ret);
+  dev    = fwd->f_dev;
+  iob    = fwd->f_iob;
+  offset = NET_LL_HDRLEN(dev);
+  pktlen = iob->io_pktlen;
+
+  DEBUGASSERT(offset + pktlen <= NET_DEV_MTU(dev));
+
+#ifdef CONFIG_NETDEV_IOB
+  /* If the device takes its packet buffer from an I/O buffer and the whole
+   * packet lies in one I/O buffer, then that I/O buffer becomes the packet
+   * buffer.  The packet is moved only if it does not already follow the
+   * space for the link layer header.
+   */
+
+  if (zerocopy && dev->d_iob != NULL && iob->io_flink == NULL &&
+      offset + pktlen <= CONFIG_IOB_BUFSIZE)
+    {
+      if (iob->io_offset != offset)
+        {
+          memmove(&iob->io_data[offset], IOB_DATA(iob), pktlen);
+        }
+
+      iob_free(dev->d_iob);
+      dev->d_iob = iob;
+      dev->d_buf = iob->io_data;
+      fwd->f_iob = NULL;
+    }
+  else
+#endif
+    {
+      /* Copy the IOB chain that contains the L3L3 headers and any data
+       * payload
+       */
+
+      ret = iob_copyout(&dev->d_buf[offset], iob, pktlen, 0);
+      DEBUGASSERT(ret == pktlen);
+      UNUSED(ret);
+    }
+
+  dev->d_sndlen = 0;
+  dev->d_len    = pktlen;
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && IPFWD_LLHDRLEN > 0
+  /* Add the link layer header cached for the flow.  arp_out() and
+   * neighbor_out() will then leave the frame alone.
+   */
+
+  if (fwd->f_lllen > 0)
+    {
+      memcpy(dev->d_buf, fwd->f_llhdr, fwd->f_lllen);
+      dev->d_len += fwd->f_lllen;
+      IFF_SET_NOARP(dev->d_flags);
+    }
+#endif
 }
 
 #endif /* CONFIG_NET_IPFORWARD */
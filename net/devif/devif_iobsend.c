@@ -71,7 +71,12 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
+#ifdef CONFIG_NET_TCP_GSO
+  DEBUGASSERT(dev && len > 0 &&
+              (len < NET_DEV_MTU(dev) || len < dev->d_gsomax));
+#else
   DEBUGASSERT(dev && len > 0 && len < NET_DEV_MTU(dev));
+#endif
 
   /* Copy the data from the I/O buffer chain to the device buffer */
 
@@ -67,7 +67,12 @@
 
 void devif_send(struct net_driver_s *dev, const void *buf, int len)
 {
+#ifdef CONFIG_NET_TCP_GSO
+  DEBUGASSERT(dev != NULL && len > 0 &&
+              (len < NET_DEV_MTU(dev) || len < dev->d_gsomax));
+#else
   DEBUGASSERT(dev != NULL && len > 0 && len < NET_DEV_MTU(dev));
+#endif
 
   memcpy(dev->d_appdata, buf, len);
   dev->d_sndlen = len;
@@ -505,9 +505,11 @@ int ipv4_input(FAR struct net_driver_s *dev)
         }
     }
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM_OFFLOAD(dev) && ipv4_chksum(dev) != 0xffff)
     {
-      /* Compute and check the IP header checksum. */
+      /* Compute and check the IP header checksum unless the hardware
+       * already did.
+       */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv4.drop++;
@@ -202,7 +202,10 @@ static void sendto_request(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~(ipv4_chksum(dev));
+  if (!NETDEV_TXCSUM_OFFLOAD(dev))
+    {
+      ipv4->ipchksum = ~(ipv4_chksum(dev));
+    }
 
   /* Calculate the ICMP checksum. */
 
@@ -42,7 +42,14 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/net/ip.h>
+#ifdef CONFIG_NET_ETHERNET
+#  include <nuttx/net/ethernet.h>
+#endif
 
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
@@ -57,6 +64,24 @@
 #  define CONFIG_NET_IPFORWARD_NSTRUCT 4
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  ifndef CONFIG_NET_IPFORWARD_NFLOWS
+#    define CONFIG_NET_IPFORWARD_NFLOWS 8
+#  endif
+
+#  ifndef CONFIG_NET_IPFORWARD_FLOWTIMEOUT
+#    define CONFIG_NET_IPFORWARD_FLOWTIMEOUT 10
+#  endif
+
+/* The largest link layer header that may be cached */
+
+#  ifdef CONFIG_NET_ETHERNET
+#    define IPFWD_LLHDRLEN ETH_HDRLEN
+#  else
+#    define IPFWD_LLHDRLEN 0
+#  endif
+#endif
+
 /* Allocate a new IP forwarding data callback */
 
 #define ipfwd_callback_alloc(dev)   devif_callback_alloc(dev, &(dev)->d_conncb)
@@ -71,6 +96,7 @@
 struct devif_callback_s; /* Forward refernce */
 struct net_driver_s;     /* Forward reference */
 struct iob_s;            /* Forward reference */
+struct ipfwd_flow_s;     /* Forward reference */
 
 struct forward_s
 {
@@ -81,8 +107,38 @@ struct forward_s
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
   uint8_t                      f_domain;  /* Domain: PF_INET or PF_INET6 */
 #endif
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && IPFWD_LLHDRLEN > 0
+  uint8_t                      f_lllen;   /* Size of f_llhdr, zero if none */
+  uint8_t                      f_llhdr[IPFWD_LLHDRLEN]; /* Link layer header */
+#endif
 };
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+/* One entry in the forwarding flow cache.  A flow is identified by the
+ * addresses, protocol and ports of its packets.  The forwarding decision
+ * made for the first packet of the flow is reused for the following packets
+ * until the entry expires.
+ */
+
+struct ipfwd_flow_s
+{
+  FAR struct net_driver_s *fl_dev;        /* Forwarding device, NULL if unused */
+  clock_t                  fl_time;       /* Time that the entry was validated */
+  uint32_t                 fl_packets;    /* Number of packets forwarded */
+  uint32_t                 fl_bytes;      /* Number of bytes forwarded */
+  union ip_addr_u          fl_srcaddr;    /* Source IP address */
+  union ip_addr_u          fl_destaddr;   /* Destination IP address */
+  uint16_t                 fl_srcport;    /* Source port (host order) */
+  uint16_t                 fl_destport;   /* Destination port (host order) */
+  uint8_t                  fl_domain;     /* Domain: PF_INET or PF_INET6 */
+  uint8_t                  fl_proto;      /* IP protocol */
+#if IPFWD_LLHDRLEN > 0
+  uint8_t                  fl_lllen;      /* Size of fl_llhdr, zero if unresolved */
+  uint8_t                  fl_llhdr[IPFWD_LLHDRLEN]; /* Link layer header */
+#endif
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -194,6 +250,62 @@ void ipv6_forward_broadcast(FAR struct net_driver_s *dev,
                             FAR struct ipv6_hdr_s *ipv6);
 #endif
 
+/****************************************************************************
+ * Name: ipfwd_iob_alloc
+ *
+ * Description:
+ *   Get an I/O buffer chain that holds the packet to be forwarded.
+ *
+ *   If 'zerocopy' is true and the receiving device takes its packet buffer
+ *   from an I/O buffer (see netdev_iob_input()), then that I/O buffer is
+ *   taken from the device and a new one takes its place.  Otherwise the
+ *   packet is copied into a new I/O buffer chain, leaving room for the link
+ *   layer header of the forwarding device.
+ *
+ * Input Parameters:
+ *   dev      - The device on which the packet was received.  dev->d_len
+ *              holds the size of the packet.
+ *   fwddev   - The device on which the packet will be forwarded.
+ *   packet   - The IP packet within dev->d_buf.
+ *   zerocopy - True if the packet in dev->d_buf is no longer needed.
+ *
+ * Returned Value:
+ *   The I/O buffer chain; NULL if no I/O buffers are available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *ipfwd_iob_alloc(FAR struct net_driver_s *dev,
+                                  FAR struct net_driver_s *fwddev,
+                                  FAR const uint8_t *packet, bool zerocopy);
+
+/****************************************************************************
+ * Name: ipfwd_iob_free
+ *
+ * Description:
+ *   Free an I/O buffer chain obtained from ipfwd_iob_alloc() when the packet
+ *   is not forwarded.  If the I/O buffer was taken from the receiving
+ *   device, it is returned to the device so that 'packet' remains valid.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received.
+ *   iob    - The I/O buffer chain to free.
+ *   packet - The IP packet within dev->d_buf that was passed to
+ *            ipfwd_iob_alloc().
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_iob_free(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                    FAR const uint8_t *packet);
+
 /****************************************************************************
  * Name: devif_forward
  *
@@ -201,8 +313,13 @@ void ipv6_forward_broadcast(FAR struct net_driver_s *dev,
  *   Called from protocol-specific IP forwarding logic to re-send a packet.
  *
  * Input Parameters:
- *   fwd - An initialized instance of the common forwarding structure that
- *         includes everything needed to perform the forwarding operation.
+ *   fwd      - An initialized instance of the common forwarding structure
+ *              that includes everything needed to perform the forwarding
+ *              operation.
+ *   zerocopy - True if the packet need not be retained after it is sent.
+ *              The I/O buffer that holds the packet may then be given to
+ *              the device rather than copied into d_buf.  In that case
+ *              fwd->f_iob is NULL on return.
  *
  * Returned Value:
  *   None
@@ -212,7 +329,7 @@ void ipv6_forward_broadcast(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-void devif_forward(FAR struct forward_s *fwd);
+void devif_forward(FAR struct forward_s *fwd, bool zerocopy);
 
 /****************************************************************************
  * Name: ipfwd_forward
@@ -375,5 +492,137 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4);
 #  define ipv4_dropstats(ipv4)
 #endif
 
+/****************************************************************************
+ * Name: ipv4_flow_find and ipv6_flow_find
+ *
+ * Description:
+ *   Find the cached flow of a packet that is to be forwarded.  The flow is
+ *   not returned if it has expired or if its forwarding device is down.
+ *
+ * Input Parameters:
+ *   ipv4/ipv6 - A pointer to the IP header of the packet.
+ *   len       - The size of the IP packet.
+ *
+ * Returned Value:
+ *   The flow; NULL if the flow is not cached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv4)
+FAR struct ipfwd_flow_s *ipv4_flow_find(FAR struct ipv4_hdr_s *ipv4,
+                                        unsigned int len);
+#endif
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv6)
+FAR struct ipfwd_flow_s *ipv6_flow_find(FAR struct ipv6_hdr_s *ipv6,
+                                        unsigned int len);
+#endif
+
+/****************************************************************************
+ * Name: ipv4_flow_add and ipv6_flow_add
+ *
+ * Description:
+ *   Cache the forwarding decision for the flow of a packet, replacing any
+ *   other flow that occupies the same entry.  The link layer header is
+ *   resolved, if possible, from the ARP or Neighbor table.
+ *
+ * Input Parameters:
+ *   ipv4/ipv6 - A pointer to the IP header of the packet.
+ *   len       - The size of the IP packet.
+ *   fwddev    - The device on which the packet is forwarded.
+ *
+ * Returned Value:
+ *   The flow.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv4)
+FAR struct ipfwd_flow_s *ipv4_flow_add(FAR struct ipv4_hdr_s *ipv4,
+                                       unsigned int len,
+                                       FAR struct net_driver_s *fwddev);
+#endif
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv6)
+FAR struct ipfwd_flow_s *ipv6_flow_add(FAR struct ipv6_hdr_s *ipv6,
+                                       unsigned int len,
+                                       FAR struct net_driver_s *fwddev);
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_setup
+ *
+ * Description:
+ *   Account for a packet of a flow and give the cached link layer header,
+ *   if any, to the forwarding state structure.
+ *
+ * Input Parameters:
+ *   flow - The flow of the packet
+ *   fwd  - The forwarding state structure; NULL if the packet was sent
+ *          without one.
+ *   len  - The size of the IP packet.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flow_setup(FAR struct ipfwd_flow_s *flow,
+                      FAR struct forward_s *fwd, unsigned int len);
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_flush
+ *
+ * Description:
+ *   Discard the cached flows that forward packets on a device.
+ *
+ * Input Parameters:
+ *   dev - The forwarding device.  NULL discards all flows.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flow_flush(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_get
+ *
+ * Description:
+ *   Return a copy of one entry of the flow cache.  This is used to report
+ *   the flows in /proc/net/flows.  The device may be unregistered as soon
+ *   as the network is unlocked, so fl_dev is cleared in the copy and the
+ *   name of the device is returned instead.
+ *
+ * Input Parameters:
+ *   index  - The index of the entry: 0 .. CONFIG_NET_IPFORWARD_NFLOWS-1
+ *   flow   - The location to return the copy.
+ *   ifname - The location to return the name of the forwarding device.
+ *            It must hold IFNAMSIZ characters.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the entry is not in use; -EINVAL if
+ *   the index is out of range.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+int ipfwd_flow_get(int index, FAR struct ipfwd_flow_s *flow,
+                   FAR char *ifname);
+#endif
+
 #endif /* CONFIG_NET_IPFORWARD */
 #endif /* __NET_IPFORWARD_IPFORWARD_H */
@@ -0,0 +1,585 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flow.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/arp.h>
+
+#include "netdev/netdev.h"
+#include "arp/arp.h"
+#include "neighbor/neighbor.h"
+#include "route/route.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPFWD_FLOWTIMEOUT SEC2TICK(CONFIG_NET_IPFORWARD_FLOWTIMEOUT)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The flow cache */
+
+static struct ipfwd_flow_s g_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_flow_ports
+ *
+ * Description:
+ *   Get the TCP or UDP ports of a packet into a flow key.  The ports of
+ *   other protocols are zero.
+ *
+ ****************************************************************************/
+
+static void ipfwd_flow_ports(FAR struct ipfwd_flow_s *key,
+                             FAR const uint8_t *l4hdr, unsigned int l4len)
+{
+  if ((key->fl_proto == IP_PROTO_TCP || key->fl_proto == IP_PROTO_UDP) &&
+      l4len >= 4)
+    {
+      key->fl_srcport  = ((uint16_t)l4hdr[0] << 8) | l4hdr[1];
+      key->fl_destport = ((uint16_t)l4hdr[2] << 8) | l4hdr[3];
+    }
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_slot
+ *
+ * Description:
+ *   Return the cache entry that may hold the flow described by 'key'.
+ *
+ ****************************************************************************/
+
+static FAR struct ipfwd_flow_s *
+ipfwd_flow_slot(FAR const struct ipfwd_flow_s *key)
+{
+  FAR const uint8_t *addr;
+  uint32_t hash;
+  int i;
+
+  hash = ((uint32_t)key->fl_srcport << 16) ^ key->fl_destport ^
+         key->fl_proto;
+
+  addr = (FAR const uint8_t *)&key->fl_srcaddr;
+  for (i = 0; i < sizeof(union ip_addr_u); i++)
+    {
+      hash = (hash << 5) + (hash >> 27) + addr[i];
+    }
+
+  addr = (FAR const uint8_t *)&key->fl_destaddr;
+  for (i = 0; i < sizeof(union ip_addr_u); i++)
+    {
+      hash = (hash << 5) + (hash >> 27) + addr[i];
+    }
+
+  return &g_flows[hash % CONFIG_NET_IPFORWARD_NFLOWS];
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_match
+ *
+ * Description:
+ *   Return true if the cache entry holds the flow described by 'key'.  The
+ *   unused bytes of the addresses are zero in both.
+ *
+ ****************************************************************************/
+
+static bool ipfwd_flow_match(FAR const struct ipfwd_flow_s *flow,
+                             FAR const struct ipfwd_flow_s *key)
+{
+  return flow->fl_dev != NULL &&
+         flow->fl_domain == key->fl_domain &&
+         flow->fl_proto == key->fl_proto &&
+         flow->fl_srcport == key->fl_srcport &&
+         flow->fl_destport == key->fl_destport &&
+         memcmp(&flow->fl_srcaddr, &key->fl_srcaddr,
+                sizeof(union ip_addr_u)) == 0 &&
+         memcmp(&flow->fl_destaddr, &key->fl_destaddr,
+                sizeof(union ip_addr_u)) == 0;
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_resolve
+ *
+ * Description:
+ *   Build the link layer header of a flow if the link layer address of the
+ *   next hop is in the ARP or Neighbor table.  The next hop is selected as
+ *   arp_out() and neighbor_out() do.  Otherwise, the header is left to be
+ *   resolved by arp_out() or neighbor_out() for each packet.
+ *
+ ****************************************************************************/
+
+#if IPFWD_LLHDRLEN > 0
+static void ipfwd_flow_resolve(FAR struct ipfwd_flow_s *flow)
+{
+  FAR struct net_driver_s *dev = flow->fl_dev;
+  FAR const uint8_t *mac = NULL;
+  uint16_t type = 0;
+
+  if (dev->d_lltype != NET_LL_ETHERNET)
+    {
+      return;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if (flow->fl_domain == PF_INET)
+    {
+      FAR struct arp_entry *entry;
+      in_addr_t destipaddr = flow->fl_destaddr.ipv4;
+      in_addr_t ipaddr;
+
+      if (!net_ipv4addr_maskcmp(destipaddr, dev->d_ipaddr, dev->d_netmask))
+        {
+          /* Destination address is not on the local network */
+
+#ifdef CONFIG_NET_ROUTE
+          netdev_ipv4_router(dev, destipaddr, &ipaddr);
+#else
+          net_ipv4addr_copy(ipaddr, dev->d_draddr);
+#endif
+        }
+      else
+        {
+          net_ipv4addr_copy(ipaddr, destipaddr);
+        }
+
+      entry = arp_find(ipaddr);
+      if (entry != NULL)
+        {
+          mac  = entry->at_ethaddr.ether_addr_octet;
+          type = ETHTYPE_IP;
+        }
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+  if (flow->fl_domain == PF_INET6 &&
+      (flow->fl_destaddr.ipv6[0] & HTONS(0xff00)) != HTONS(0xff00))
+    {
+      FAR const struct neighbor_addr_s *naddr;
+      net_ipv6addr_t ipaddr;
+
+      if (!net_ipv6addr_maskcmp(flow->fl_destaddr.ipv6, dev->d_ipv6addr,
+                                dev->d_ipv6netmask))
+        {
+          /* Destination address is not on the local network */
+
+#ifdef CONFIG_NET_ROUTE
+          netdev_ipv6_router(dev, flow->fl_destaddr.ipv6, ipaddr);
+#else
+          net_ipv6addr_copy(ipaddr, dev->d_ipv6draddr);
+#endif
+        }
+      else
+        {
+          net_ipv6addr_copy(ipaddr, flow->fl_destaddr.ipv6);
+        }
+
+      naddr = neighbor_lookup(ipaddr);
+      if (naddr != NULL)
+        {
+          mac  = naddr->u.na_ethernet.ether_addr_octet;
+          type = ETHTYPE_IP6;
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  if (mac != NULL)
+    {
+      /* Build the Ethernet header: Destination MAC, source MAC, type */
+
+      memcpy(&flow->fl_llhdr[0], mac, ETHER_ADDR_LEN);
+      memcpy(&flow->fl_llhdr[ETHER_ADDR_LEN],
+             dev->d_mac.ether.ether_addr_octet, ETHER_ADDR_LEN);
+      flow->fl_llhdr[2 * ETHER_ADDR_LEN]     = type >> 8;
+      flow->fl_llhdr[2 * ETHER_ADDR_LEN + 1] = type & 0xff;
+      flow->fl_lllen = ETH_HDRLEN;
+    }
+}
+#else
+#  define ipfwd_flow_resolve(flow)
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_find
+ *
+ * Description:
+ *   Find the flow described by 'key'.  Common logic for ipv4_flow_find()
+ *   and ipv6_flow_find().
+ *
+ ****************************************************************************/
+
+static FAR struct ipfwd_flow_s *
+ipfwd_flow_find(FAR const struct ipfwd_flow_s *key)
+{
+  FAR struct ipfwd_flow_s *flow = ipfwd_flow_slot(key);
+
+  if (!ipfwd_flow_match(flow, key))
+    {
+      return NULL;
+    }
+
+  /* The forwarding decision must be re-made if the device has gone down or
+   * if the flow has not been revalidated recently.
+   */
+
+  if (!IFF_IS_UP(flow->fl_dev->d_flags) ||
+      clock_systimer() - flow->fl_time >= IPFWD_FLOWTIMEOUT)
+    {
+      return NULL;
+    }
+
+#if IPFWD_LLHDRLEN > 0
+  /* The next hop may have been added to the ARP or Neighbor table since
+   * the flow was cached.
+   */
+
+  if (flow->fl_lllen == 0)
+    {
+      ipfwd_flow_resolve(flow);
+    }
+#endif
+
+  return flow;
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_add
+ *
+ * Description:
+ *   Cache the flow described by 'key'.  Common logic for ipv4_flow_add()
+ *   and ipv6_flow_add().
+ *
+ ****************************************************************************/
+
+static FAR struct ipfwd_flow_s *
+ipfwd_flow_add(FAR const struct ipfwd_flow_s *key,
+               FAR struct net_driver_s *fwddev)
+{
+  FAR struct ipfwd_flow_s *flow = ipfwd_flow_slot(key);
+
+  /* Keep the counters if the flow is only being revalidated */
+
+  if (!ipfwd_flow_match(flow, key))
+    {
+      memcpy(flow, key, sizeof(struct ipfwd_flow_s));
+    }
+
+  flow->fl_dev  = fwddev;
+  flow->fl_time = clock_systimer();
+#if IPFWD_LLHDRLEN > 0
+  flow->fl_lllen = 0;
+#endif
+
+  ipfwd_flow_resolve(flow);
+  return flow;
+}
+
+/****************************************************************************
+ * Name: ipv4_flow_key and ipv6_flow_key
+ *
+ * Description:
+ *   Describe the flow of a packet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static void ipv4_flow_key(FAR struct ipfwd_flow_s *key,
+                          FAR struct ipv4_hdr_s *ipv4, unsigned int len)
+{
+  memset(key, 0, sizeof(struct ipfwd_flow_s));
+
+  key->fl_domain = PF_INET;
+  key->fl_proto  = ipv4->proto;
+  net_ipv4addr_copy(key->fl_srcaddr.ipv4,
+                    net_ip4addr_conv32(ipv4->srcipaddr));
+  net_ipv4addr_copy(key->fl_destaddr.ipv4,
+                    net_ip4addr_conv32(ipv4->destipaddr));
+
+  if (len > IPv4_HDRLEN)
+    {
+      ipfwd_flow_ports(key, (FAR const uint8_t *)ipv4 + IPv4_HDRLEN,
+                       len - IPv4_HDRLEN);
+    }
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static void ipv6_flow_key(FAR struct ipfwd_flow_s *key,
+                          FAR struct ipv6_hdr_s *ipv6, unsigned int len)
+{
+  memset(key, 0, sizeof(struct ipfwd_flow_s));
+
+  key->fl_domain = PF_INET6;
+  key->fl_proto  = ipv6->proto;
+  net_ipv6addr_copy(key->fl_srcaddr.ipv6, ipv6->srcipaddr);
+  net_ipv6addr_copy(key->fl_destaddr.ipv6, ipv6->destipaddr);
+
+  if (len > IPv6_HDRLEN)
+    {
+      ipfwd_flow_ports(key, (FAR const uint8_t *)ipv6 + IPv6_HDRLEN,
+                       len - IPv6_HDRLEN);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_find and ipv6_flow_find
+ *
+ * Description:
+ *   Find the cached flow of a packet that is to be forwarded.  The flow is
+ *   not returned if it has expired or if its forwarding device is down.
+ *
+ * Input Parameters:
+ *   ipv4/ipv6 - A pointer to the IP header of the packet.
+ *   len       - The size of the IP packet.
+ *
+ * Returned Value:
+ *   The flow; NULL if the flow is not cached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+FAR struct ipfwd_flow_s *ipv4_flow_find(FAR struct ipv4_hdr_s *ipv4,
+                                        unsigned int len)
+{
+  struct ipfwd_flow_s key;
+
+  ipv4_flow_key(&key, ipv4, len);
+  return ipfwd_flow_find(&key);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+FAR struct ipfwd_flow_s *ipv6_flow_find(FAR struct ipv6_hdr_s *ipv6,
+                                        unsigned int len)
+{
+  struct ipfwd_flow_s key;
+
+  ipv6_flow_key(&key, ipv6, len);
+  return ipfwd_flow_find(&key);
+}
+#endif
+
+/****************************************************************************
+ * Name: ipv4_flow_add and ipv6_flow_add
+ *
+ * Description:
+ *   Cache the forwarding decision for the flow of a packet, replacing any
+ *   other flow that occupies the same entry.  The link layer header is
+ *   resolved, if possible, from the ARP or Neighbor table.
+ *
+ * Input Parameters:
+ *   ipv4/ipv6 - A pointer to the IP header of the packet.
+ *   len       - The size of the IP packet.
+ *   fwddev    - The device on which the packet is forwarded.
+ *
+ * Returned Value:
+ *   The flow.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+FAR struct ipfwd_flow_s *ipv4_flow_add(FAR struct ipv4_hdr_s *ipv4,
+                                       unsigned int len,
+                                       FAR struct net_driver_s *fwddev)
+{
+  struct ipfwd_flow_s key;
+
+  ipv4_flow_key(&key, ipv4, len);
+  return ipfwd_flow_add(&key, fwddev);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+FAR struct ipfwd_flow_s *ipv6_flow_add(FAR struct ipv6_hdr_s *ipv6,
+                                       unsigned int len,
+                                       FAR struct net_driver_s *fwddev)
+{
+  struct ipfwd_flow_s key;
+
+  ipv6_flow_key(&key, ipv6, len);
+  return ipfwd_flow_add(&key, fwddev);
+}
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_setup
+ *
+ * Description:
+ *   Account for a packet of a flow and give the cached link layer header,
+ *   if any, to the forwarding state structure.
+ *
+ * Input Parameters:
+ *   flow - The flow of the packet
+ *   fwd  - The forwarding state structure; NULL if the packet was sent
+ *          without one.
+ *   len  - The size of the IP packet.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_setup(FAR struct ipfwd_flow_s *flow,
+                      FAR struct forward_s *fwd, unsigned int len)
+{
+  flow->fl_packets++;
+  flow->fl_bytes += len;
+
+#if IPFWD_LLHDRLEN > 0
+  if (fwd != NULL && flow->fl_lllen > 0)
+    {
+      memcpy(fwd->f_llhdr, flow->fl_llhdr, flow->fl_lllen);
+      fwd->f_lllen = flow->fl_lllen;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_flush
+ *
+ * Description:
+ *   Discard the cached flows that forward packets on a device.
+ *
+ * Input Parameters:
+ *   dev - The forwarding device.  NULL discards all flows.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_flush(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  net_lock();
+  for (i = 0; i < CONFIG_NET_IPFORWARD_NFLOWS; i++)
+    {
+      if (dev == NULL || g_flows[i].fl_dev == dev)
+        {
+          g_flows[i].fl_dev = NULL;
+        }
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_get
+ *
+ * Description:
+ *   Return a copy of one entry of the flow cache.  This is used to report
+ *   the flows in /proc/net/flows.  The device may be unregistered as soon
+ *   as the network is unlocked, so fl_dev is cleared in the copy and the
+ *   name of the device is returned instead.
+ *
+ * Input Parameters:
+ *   index  - The index of the entry: 0 .. CONFIG_NET_IPFORWARD_NFLOWS-1
+ *   flow   - The location to return the copy.
+ *   ifname - The location to return the name of the forwarding device.
+ *            It must hold IFNAMSIZ characters.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the entry is not in use; -EINVAL if
+ *   the index is out of range.
+ *
+ ****************************************************************************/
+
+int ipfwd_flow_get(int index, FAR struct ipfwd_flow_s *flow,
+                   FAR char *ifname)
+{
+  int ret = -ENOENT;
+
+  if (index < 0 || index >= CONFIG_NET_IPFORWARD_NFLOWS)
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+  if (g_flows[index].fl_dev != NULL)
+    {
+      memcpy(flow, &g_flows[index], sizeof(struct ipfwd_flow_s));
+      strncpy(ifname, flow->fl_dev->d_ifname, IFNAMSIZ);
+      ifname[IFNAMSIZ - 1] = '\0';
+      flow->fl_dev = NULL;
+      ret = OK;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
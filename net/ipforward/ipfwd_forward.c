@@ -152,13 +152,22 @@ static inline bool ipfwd_addrchk(FAR struct forward_s *fwd)
       return true;
     }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* The link layer header may already have been resolved for the flow */
+
+  if (fwd->f_lllen > 0)
+    {
+      return true;
+    }
+#endif
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   if (fwd->f_domain == PF_INET)
 #endif
     {
 #if !defined(CONFIG_NET_ARP_IPIN) && !defined(CONFIG_NET_ARP_SEND)
-      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)fwd->f_iob->io_data;
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(fwd->f_iob);
       return (arp_find(*(in_addr_t *)ipv4->destipaddr) != NULL);
 #else
       return true;
@@ -172,7 +181,7 @@ static inline bool ipfwd_addrchk(FAR struct forward_s *fwd)
 #endif
     {
 #if defined(CONFIG_NET_ICMPv6_NEIGHBOR)
-      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)fwd->f_iob->io_data;
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)IOB_DATA(fwd->f_iob);
       return (neighbor_findentry(ipv6->destipaddr) != NULL);
 #else
       return true;
@@ -249,6 +258,24 @@ static uint16_t ipfwd_eventhandler(FAR struct net_driver_s *dev, FAR void *conn,
 
       else
         {
+          bool resolved;
+
+          /* Check if the destination IP address is in the ARP or Neighbor
+           * table.  If not, then the send won't actually make it out... it
+           * will be replaced with an ARP request or Neighbor Solicitation
+           * and the packet must be retained for the next poll.
+           */
+
+          resolved = ipfwd_addrchk(fwd);
+
+          /* Copy the user data into d_appdata and send it.  If the packet
+           * need not be retained, its I/O buffer may be given to the device
+           * instead.
+           */
+
+          devif_forward(fwd, resolved);
+          flags &= ~DEVPOLL_MASK;
+
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
           /* If both IPv4 and IPv6 support are enabled, then we will need to
            * select which one to use when generating the outgoing packet.
@@ -258,17 +285,8 @@ static uint16_t ipfwd_eventhandler(FAR struct net_driver_s *dev, FAR void *conn,
 
           forward_ipselect(fwd);
 #endif
-          /* Copy the user data into d_appdata and send it. */
-
-          devif_forward(fwd);
-          flags &= ~DEVPOLL_MASK;
-
-          /* Check if the destination IP address is in the ARP or Neighbor
-           * table.  If not, then the send won't actually make it out... it
-           * will be replaced with an ARP request or Neighbor Solicitation.
-           */
 
-          if (!ipfwd_addrchk(fwd))
+          if (!resolved)
             {
               return flags;
             }
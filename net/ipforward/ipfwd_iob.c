@@ -0,0 +1,181 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_iob.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_iob_alloc
+ *
+ * Description:
+ *   Get an I/O buffer chain that holds the packet to be forwarded.
+ *
+ *   If 'zerocopy' is true and the receiving device takes its packet buffer
+ *   from an I/O buffer (see netdev_iob_input()), then that I/O buffer is
+ *   taken from the device and a new one takes its place.  Otherwise the
+ *   packet is copied into a new I/O buffer chain, leaving room for the link
+ *   layer header of the forwarding device.
+ *
+ * Input Parameters:
+ *   dev      - The device on which the packet was received.  dev->d_len
+ *              holds the size of the packet.
+ *   fwddev   - The device on which the packet will be forwarded.
+ *   packet   - The IP packet within dev->d_buf.
+ *   zerocopy - True if the packet in dev->d_buf is no longer needed.
+ *
+ * Returned Value:
+ *   The I/O buffer chain; NULL if no I/O buffers are available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *ipfwd_iob_alloc(FAR struct net_driver_s *dev,
+                                  FAR struct net_driver_s *fwddev,
+                                  FAR const uint8_t *packet, bool zerocopy)
+{
+  FAR struct iob_s *iob;
+  int ret;
+
+  /* Try to allocate the head of an IOB chain.  If this fails, the packet
+   * will be dropped; we are not operating in a context where waiting for an
+   * IOB is a good idea.
+   */
+
+  iob = iob_tryalloc(false);
+  if (iob == NULL)
+    {
+      nwarn("WARNING: iob_tryalloc() failed\n");
+      return NULL;
+    }
+
+#ifdef CONFIG_NETDEV_IOB
+  if (zerocopy && dev->d_iob != NULL)
+    {
+      FAR struct iob_s *frame = dev->d_iob;
+
+      /* The packet already lies in an I/O buffer.  Take that I/O buffer
+       * from the device and give it the new one to receive the next packet.
+       */
+
+      dev->d_iob = iob;
+      dev->d_buf = iob->io_data;
+
+      frame->io_offset = packet - frame->io_data;
+      frame->io_len    = dev->d_len;
+      frame->io_pktlen = dev->d_len;
+      return frame;
+    }
+#endif
+
+  /* Copy the packet into the IOB chain.  Start the packet after the link
+   * layer header of the forwarding device so that the I/O buffer may be
+   * given to that device without moving the packet.  iob_trycopyin() will
+   * not wait, but will fail there are no available IOBs.
+   */
+
+  iob->io_offset = NET_LL_HDRLEN(fwddev);
+
+  ret = iob_trycopyin(iob, packet, dev->d_len, 0, false);
+  if (ret < 0)
+    {
+      nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
+      iob_free_chain(iob);
+      return NULL;
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: ipfwd_iob_free
+ *
+ * Description:
+ *   Free an I/O buffer chain obtained from ipfwd_iob_alloc() when the packet
+ *   is not forwarded.  If the I/O buffer was taken from the receiving
+ *   device, it is returned to the device so that 'packet' remains valid.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received.
+ *   iob    - The I/O buffer chain to free.
+ *   packet - The IP packet within dev->d_buf that was passed to
+ *            ipfwd_iob_alloc().
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_iob_free(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                    FAR const uint8_t *packet)
+{
+#ifdef CONFIG_NETDEV_IOB
+  if (dev->d_iob != NULL && IOB_DATA(iob) == packet)
+    {
+      /* Swap the I/O buffers back */
+
+      iob_free(dev->d_iob);
+      dev->d_iob = iob;
+      dev->d_buf = iob->io_data;
+      return;
+    }
+#endif
+
+  iob_free_chain(iob);
+}
+
+#endif /* CONFIG_NET_IPFORWARD */
@@ -146,7 +146,7 @@ static int ipv4_hdrsize(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 {
-  uint16_t sum;
+  uint32_t sum;
   int ttl = (int)ipv4->ttl - 1;
 
   if (ttl <= 0)
@@ -165,23 +165,15 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
   ipv4->ttl = ttl;
 
-  /* Re-calculate the IPv4 checksum.  This checksum is the Internet checksum
-   * of the 20 bytes of the IPv4 header.  This checksum will be different
-   * because we just modify the IPv4 TTL.
+  /* Update the IPv4 checksum.  This checksum is the Internet checksum of
+   * the 20 bytes of the IPv4 header.  Only the TTL, the high byte of its
+   * 16-bit word, has changed so the checksum is adjusted incrementally
+   * (RFC 1141) rather than recalculated:  Decrementing the TTL by one
+   * increments the one's complement checksum by 0x0100.
    */
 
-  ipv4->ipchksum = 0;
-  sum            = chksum(0, (FAR const uint8_t *)ipv4, IPv4_HDRLEN);
-  if (sum == 0)
-    {
-      sum = 0xffff;
-    }
-  else
-    {
-      sum = htons(sum);
-    }
-
-  ipv4->ipchksum = ~sum;
+  sum            = (uint32_t)ntohs(ipv4->ipchksum) + 0x0100;
+  ipv4->ipchksum = htons((uint16_t)(sum + (sum >> 16)));
   return ttl;
 }
 
@@ -199,6 +191,10 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
  *              contains the IPv4 packet.
  *   fwdddev  - The device on which the packet must be forwarded.
  *   ipv4     - A pointer to the IPv4 header in within the IPv4 packet
+ *   flow     - The cached flow of the packet or NULL
+ *   zerocopy - True if the packet in dev->d_buf is no longer needed after
+ *              it is forwarded.  It may then be forwarded without being
+ *              copied.
  *
  * Returned Value:
  *   Zero is returned if the packet was successfully forward;  A negated
@@ -209,7 +205,8 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_dev_forward(FAR struct net_driver_s *dev,
                             FAR struct net_driver_s *fwddev,
-                            FAR struct ipv4_hdr_s *ipv4)
+                            FAR struct ipv4_hdr_s *ipv4,
+                            FAR struct ipfwd_flow_s *flow, bool zerocopy)
 {
   FAR struct forward_s *fwd = NULL;
 #ifdef CONFIG_DEBUG_NET_WARN
@@ -268,42 +265,25 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
     }
 #endif
 
-  /* Try to allocate the head of an IOB chain.  If this fails, the
-   * packet will be dropped; we are not operating in a context
-   * where waiting for an IOB is a good idea
+  /* Get an IOB chain that holds the L2/L3 headers plus any following
+   * payload.  The packet is copied unless the receiving device can give
+   * up the I/O buffer that holds it.
    */
 
-  fwd->f_iob = iob_tryalloc(false);
+  fwd->f_iob = ipfwd_iob_alloc(dev, fwddev, (FAR const uint8_t *)ipv4,
+                               zerocopy);
   if (fwd->f_iob == NULL)
     {
-      nwarn("WARNING: iob_tryalloc() failed\n");
       ret = -ENOMEM;
       goto errout_with_fwd;
     }
 
-  /* Copy the L2/L3 headers plus any following payload into an IOB chain.
-   * iob_trycopin() will not wait, but will fail there are no available
-   * IOBs.
-   *
-   * REVISIT: Consider an alternative design that does not require data
-   * copying.  This would require a pool of d_buf's that are managed by
-   * the network rather than the network device.
-   */
-
-  ret = iob_trycopyin(fwd->f_iob, (FAR const uint8_t *)ipv4,
-                      dev->d_len, 0, false);
-  if (ret < 0)
-    {
-      nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
-      goto errout_with_iobchain;
-    }
-
   /* Decrement the TTL in the copy of the IPv4 header (retaining the
    * original TTL in the source to handle the broadcast case).  If the
    * TLL decrements to zero, then do not forward the packet.
    */
 
-  ret = ipv4_decr_ttl((FAR struct ipv4_hdr_s *)fwd->f_iob->io_data);
+  ret = ipv4_decr_ttl((FAR struct ipv4_hdr_s *)IOB_DATA(fwd->f_iob));
   if (ret < 1)
     {
       nwarn("WARNING: Hop limit exceeded... Dropping!\n");
@@ -311,6 +291,15 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
       goto errout_with_iobchain;
     }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Use the cached link layer header of the flow, if any */
+
+  if (flow != NULL)
+    {
+      ipfwd_flow_setup(flow, fwd, dev->d_len);
+    }
+#endif
+
   /* Then set up to forward the packet according to the protocol. */
 
   ret = ipfwd_forward(fwd);
@@ -323,7 +312,7 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
 errout_with_iobchain:
   if (fwd != NULL && fwd->f_iob != NULL)
     {
-      iob_free_chain(fwd->f_iob);
+      ipfwd_iob_free(dev, fwd->f_iob, (FAR const uint8_t *)ipv4);
     }
 
 errout_with_fwd:
@@ -379,7 +368,7 @@ int ipv4_forward_callback(FAR struct net_driver_s *fwddev, FAR void *arg)
 
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, NULL, false);
       if (ret < 0)
         {
           nwarn("WARNING: ipv4_dev_forward failed: %d\n", ret);
@@ -429,18 +418,40 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
   in_addr_t destipaddr;
   in_addr_t srcipaddr;
   FAR struct net_driver_s *fwddev;
+  FAR struct ipfwd_flow_s *flow = NULL;
   int ret;
 
-  /* Search for a device that can forward this packet. */
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Check if the forwarding device is already known for this flow */
 
-  destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
-  srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
-
-  fwddev     = netdev_findby_ipv4addr(srcipaddr, destipaddr);
-  if (fwddev == NULL)
+  flow = ipv4_flow_find(ipv4, dev->d_len);
+  if (flow != NULL)
+    {
+      fwddev = flow->fl_dev;
+    }
+  else
+#endif
     {
-      nwarn("WARNING: Not routable\n");
-      return (ssize_t)-ENETUNREACH;
+      /* Search for a device that can forward this packet. */
+
+      destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+      srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+
+      fwddev     = netdev_findby_ipv4addr(srcipaddr, destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          return (ssize_t)-ENETUNREACH;
+        }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Remember the forwarding device for the following packets */
+
+      if (fwddev != dev)
+        {
+          flow = ipv4_flow_add(ipv4, dev->d_len, fwddev);
+        }
+#endif
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -451,7 +462,7 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
     {
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, flow, true);
       if (ret < 0)
         {
           nwarn("WARNING: ipv4_dev_forward failed: %d\n", ret);
@@ -330,6 +330,10 @@ static int ipv6_packet_conversion(FAR struct net_driver_s *dev,
  *              contains the IPv6 packet.
  *   fwdddev  - The device on which the packet must be forwarded.
  *   ipv6     - A pointer to the IPv6 header in within the IPv6 packet
+ *   flow     - The cached flow of the packet or NULL
+ *   zerocopy - True if the packet in dev->d_buf is no longer needed after
+ *              it is forwarded.  It may then be forwarded without being
+ *              copied.
  *
  * Returned Value:
  *   Zero is returned if the packet was successfully forwarded;  A negated
@@ -340,9 +344,13 @@ static int ipv6_packet_conversion(FAR struct net_driver_s *dev,
 
 static int ipv6_dev_forward(FAR struct net_driver_s *dev,
                             FAR struct net_driver_s *fwddev,
-                            FAR struct ipv6_hdr_s *ipv6)
+                            FAR struct ipv6_hdr_s *ipv6,
+                            FAR struct ipfwd_flow_s *flow, bool zerocopy)
 {
   FAR struct forward_s *fwd = NULL;
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  unsigned int len = dev->d_len;
+#endif
 #ifdef CONFIG_DEBUG_NET_WARN
   int hdrsize;
 #endif
@@ -356,7 +364,18 @@ static int ipv6_dev_forward(FAR struct net_driver_s *dev,
       nwarn("WARNING: ipv6_packet_conversion failed: %d\n", ret);
       goto errout;
     }
-  else if (ret == PACKET_NOT_FORWARDED)
+  else if (ret == PACKET_FORWARDED)
+    {
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* The packet was sent directly by the conversion */
+
+      if (flow != NULL)
+        {
+          ipfwd_flow_setup(flow, NULL, len);
+        }
+#endif
+    }
+  else
     {
       /* Verify that the full packet will fit within the forwarding devices
        * MTU.  We provide no support for fragmenting forwarded packets.
@@ -409,42 +428,25 @@ static int ipv6_dev_forward(FAR struct net_driver_s *dev,
         }
 #endif
 
-      /* Try to allocate the head of an IOB chain.  If this fails, the
-       * packet will be dropped; we are not operating in a context where
-       * waiting for an IOB is a good idea
+      /* Get an IOB chain that holds the L2/L3 headers plus any following
+       * payload.  The packet is copied unless the receiving device can
+       * give up the I/O buffer that holds it.
        */
 
-      fwd->f_iob = iob_tryalloc(false);
+      fwd->f_iob = ipfwd_iob_alloc(dev, fwddev, (FAR const uint8_t *)ipv6,
+                                   zerocopy);
       if (fwd->f_iob == NULL)
         {
-          nwarn("WARNING: iob_tryalloc() failed\n");
           ret = -ENOMEM;
           goto errout_with_fwd;
         }
 
-      /* Copy the L2/L3 headers plus any following payload into an IOB
-       * chain.  iob_trycopin() will not wait, but will fail there are no
-       * available IOBs.
-       *
-       * REVISIT: Consider an alternative design that does not require data
-       * copying.  This would require a pool of d_buf's that are managed by
-       * the network rather than the network device.
-       */
-
-      ret = iob_trycopyin(fwd->f_iob, (FAR const uint8_t *)ipv6,
-                          dev->d_len, 0, false);
-      if (ret < 0)
-        {
-          nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
-          goto errout_with_iobchain;
-        }
-
       /* Decrement the TTL in the copy of the IPv6 header (retaining the
        * original TTL in the sourcee to handle the broadcast case).  If the
        * TTL decrements to zero, then do not forward the packet.
        */
 
-      ret = ipv6_decr_ttl((FAR struct ipv6_hdr_s *)fwd->f_iob->io_data);
+      ret = ipv6_decr_ttl((FAR struct ipv6_hdr_s *)IOB_DATA(fwd->f_iob));
       if (ret < 1)
         {
           nwarn("WARNING: Hop limit exceeded... Dropping!\n");
@@ -452,6 +454,15 @@ static int ipv6_dev_forward(FAR struct net_driver_s *dev,
           goto errout_with_iobchain;
         }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Use the cached link layer header of the flow, if any */
+
+      if (flow != NULL)
+        {
+          ipfwd_flow_setup(flow, fwd, len);
+        }
+#endif
+
       /* Then set up to forward the packet according to the protocol. */
 
       ret = ipfwd_forward(fwd);
@@ -465,7 +476,7 @@ static int ipv6_dev_forward(FAR struct net_driver_s *dev,
 errout_with_iobchain:
   if (fwd != NULL && fwd->f_iob != NULL)
     {
-      iob_free_chain(fwd->f_iob);
+      ipfwd_iob_free(dev, fwd->f_iob, (FAR const uint8_t *)ipv6);
     }
 
 errout_with_fwd:
@@ -521,7 +532,7 @@ int ipv6_forward_callback(FAR struct net_driver_s *fwddev, FAR void *arg)
 
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv6_dev_forward(dev, fwddev, ipv6);
+      ret = ipv6_dev_forward(dev, fwddev, ipv6, NULL, false);
       if (ret < 0)
         {
           nwarn("WARNING: ipv6_dev_forward failed: %d\n", ret);
@@ -569,15 +580,37 @@ int ipv6_forward_callback(FAR struct net_driver_s *fwddev, FAR void *arg)
 int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
 {
   FAR struct net_driver_s *fwddev;
+  FAR struct ipfwd_flow_s *flow = NULL;
   int ret;
 
-  /* Search for a device that can forward this packet. */
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Check if the forwarding device is already known for this flow */
 
-  fwddev = netdev_findby_ipv6addr(ipv6->srcipaddr, ipv6->destipaddr);
-  if (fwddev == NULL)
+  flow = ipv6_flow_find(ipv6, dev->d_len);
+  if (flow != NULL)
+    {
+      fwddev = flow->fl_dev;
+    }
+  else
+#endif
     {
-      nwarn("WARNING: Not routable\n");
-      return (ssize_t)-ENETUNREACH;
+      /* Search for a device that can forward this packet. */
+
+      fwddev = netdev_findby_ipv6addr(ipv6->srcipaddr, ipv6->destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          return (ssize_t)-ENETUNREACH;
+        }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Remember the forwarding device for the following packets */
+
+      if (fwddev != dev)
+        {
+          flow = ipv6_flow_add(ipv6, dev->d_len, fwddev);
+        }
+#endif
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -588,7 +621,7 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
     {
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv6_dev_forward(dev, fwddev, ipv6);
+      ret = ipv6_dev_forward(dev, fwddev, ipv6, flow, true);
       if (ret < 0)
         {
           nwarn("WARNING: ipv6_dev_forward failed: %d\n", ret);
@@ -235,6 +235,12 @@ void neighbor_out(FAR struct net_driver_s *dev)
            */
 
           icmpv6_solicit(dev, ipaddr);
+
+#ifdef CONFIG_NET_TCP_GSO
+          /* The solicitation is not a TCP super-segment */
+
+          dev->d_gsosize = 0;
+#endif
           return;
         }
 
@@ -0,0 +1,847 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NETDEV_IOB)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/arp.h>
+#include <nuttx/net/ethernet.h>
+
+#ifdef CONFIG_NET_PKT
+#  include <nuttx/net/pkt.h>
+#endif
+
+#ifdef CONFIG_NET_TCP_GSO
+#  include <nuttx/net/tcp.h>
+#  include "inet/inet.h"
+#  include "utils/utils.h"
+#endif
+
+#include "netdev/netdev.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_IOB_NCHAINS < 1
+#  error CONFIG_NETDEV_IOB requires CONFIG_IOB_NCHAINS > 0
+#endif
+
+/* The packet buffer is taken from an I/O buffer if the driver does not
+ * provide one.  Then every frame must fit into a single I/O buffer.
+ */
+
+#define NETDEV_IOB_ZEROCOPY(dev) ((dev)->d_iob != NULL)
+#define NETDEV_IOB_FITS(dev) \
+  ((dev)->d_mtu + CONFIG_NET_GUARDSIZE <= CONFIG_IOB_BUFSIZE)
+
+#define ETHBUF ((FAR struct eth_hdr_s *)&dev->d_buf[0])
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one netdev_iob_poll() or netdev_iob_timer() operation */
+
+struct netdev_iob_poll_s
+{
+  FAR struct iob_queue_s *txq;  /* Queue that receives the frames */
+  unsigned int maxframes;       /* The most frames to queue */
+  unsigned int nframes;         /* The number of frames queued */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The poll operation in progress.  Polls are performed with the network
+ * locked and, hence, never run concurrently.
+ */
+
+static FAR struct netdev_iob_poll_s *g_iob_poll;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   If the driver did not provide a packet buffer, then take one from an
+ *   I/O buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if no I/O buffer is available;  -EINVAL
+ *   if a frame of the device's MTU does not fit into an I/O buffer (i.e.,
+ *   CONFIG_IOB_BUFSIZE is too small).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int netdev_iob_prepare(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob;
+
+  if (dev->d_buf == NULL)
+    {
+      if (!NETDEV_IOB_FITS(dev))
+        {
+          nerr("ERROR: MTU %d does not fit into CONFIG_IOB_BUFSIZE=%d\n",
+               dev->d_mtu, CONFIG_IOB_BUFSIZE);
+          return -EINVAL;
+        }
+
+      iob = iob_tryalloc(false);
+      if (iob == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      dev->d_iob = iob;
+      dev->d_buf = iob->io_data;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_llout
+ *
+ * Description:
+ *   Add the link layer header to an outgoing IP packet in d_buf.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void netdev_iob_llout(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_ETHERNET
+  if (dev->d_lltype == NET_LL_ETHERNET)
+    {
+      /* Look up the destination MAC address and add it to the Ethernet
+       * header.
+       */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      if (IFF_IS_IPv4(dev->d_flags))
+#endif
+        {
+          arp_out(dev);
+        }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      else
+#endif
+        {
+          neighbor_out(dev);
+        }
+#endif /* CONFIG_NET_IPv6 */
+    }
+#endif /* CONFIG_NET_ETHERNET */
+}
+
+/****************************************************************************
+ * Name: netdev_iob_copyframe
+ *
+ * Description:
+ *   Copy the frame in d_buf into a new I/O buffer chain and add it to the
+ *   end of a queue of frames to be transmitted.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int netdev_iob_copyframe(FAR struct net_driver_s *dev,
+                                FAR struct iob_queue_s *txq)
+{
+  FAR struct iob_s *iob;
+  int ret;
+
+  iob = iob_tryalloc(false);
+  if (iob == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = iob_trycopyin(iob, dev->d_buf, dev->d_len, 0, false);
+  if (ret >= 0)
+    {
+      ret = iob_tryadd_queue(iob, txq);
+    }
+
+  if (ret < 0)
+    {
+      iob_free_chain(iob);
+      return ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_gso
+ *
+ * Description:
+ *   Split the TCP super-segment in d_buf into segments that carry
+ *   d_gsosize bytes of data each (the last may carry less) and add each to
+ *   the end of a queue of frames to be transmitted.
+ *
+ *   The segments are built in place:  The headers of each segment are
+ *   copied over the end of the data of the segment before it, which has
+ *   already been queued.  tcp_gso_sndsize() assures that the MSS is never
+ *   smaller than the headers.
+ *
+ * Returned Value:
+ *   The number of frames queued; a negated errno value if none could be.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+static int netdev_iob_gso(FAR struct net_driver_s *dev,
+                          FAR struct iob_queue_s *txq)
+{
+  FAR uint8_t *buf = dev->d_buf;
+  FAR uint8_t *seg;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iphdrlen;
+  unsigned int tcphdrlen;
+  unsigned int datalen;
+  unsigned int offset;
+  unsigned int seglen;
+  uint32_t seqno;
+  uint8_t flags;
+  int nframes = 0;
+  int ret = OK;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      iphdrlen = IPv6_HDRLEN;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      iphdrlen = IPv4_HDRLEN;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  /* Save the fields of the original headers that differ in each segment */
+
+  tcp       = (FAR struct tcp_hdr_s *)&buf[llhdrlen + iphdrlen];
+  tcphdrlen = (tcp->tcpoffset >> 4) << 2;
+  datalen   = dev->d_len - llhdrlen - iphdrlen - tcphdrlen;
+  seqno     = ((uint32_t)tcp->seqno[0] << 24) |
+              ((uint32_t)tcp->seqno[1] << 16) |
+              ((uint32_t)tcp->seqno[2] << 8) |
+              (uint32_t)tcp->seqno[3];
+  flags     = tcp->flags;
+
+  for (offset = 0; offset < datalen; offset += seglen)
+    {
+      uint32_t segseq = seqno + offset;
+
+      seglen = datalen - offset;
+      if (seglen > dev->d_gsosize)
+        {
+          seglen = dev->d_gsosize;
+        }
+
+      /* Put a copy of the headers just before the data of this segment */
+
+      seg = &buf[offset];
+      if (offset > 0)
+        {
+          memcpy(seg, buf, llhdrlen + iphdrlen + tcphdrlen);
+        }
+
+      tcp = (FAR struct tcp_hdr_s *)&seg[llhdrlen + iphdrlen];
+      tcp->seqno[0]  = segseq >> 24;
+      tcp->seqno[1]  = segseq >> 16;
+      tcp->seqno[2]  = segseq >> 8;
+      tcp->seqno[3]  = segseq;
+      tcp->tcpchksum = 0;
+
+      /* Only the last segment may carry FIN or PSH */
+
+      tcp->flags = flags;
+      if (offset + seglen < datalen)
+        {
+          tcp->flags &= ~(TCP_FIN | TCP_PSH);
+        }
+
+      /* Then operate on this segment as though it were the packet */
+
+      dev->d_buf = seg;
+      dev->d_len = llhdrlen + iphdrlen + tcphdrlen + seglen;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      if (IFF_IS_IPv6(dev->d_flags))
+#endif
+        {
+          FAR struct ipv6_hdr_s *ipv6 =
+            (FAR struct ipv6_hdr_s *)&seg[llhdrlen];
+          uint16_t iplen = tcphdrlen + seglen;
+
+          ipv6->len[0] = iplen >> 8;
+          ipv6->len[1] = iplen & 0xff;
+
+          if (!NETDEV_TXCSUM_OFFLOAD(dev))
+            {
+              tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+            }
+        }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      else
+#endif
+        {
+          FAR struct ipv4_hdr_s *ipv4 =
+            (FAR struct ipv4_hdr_s *)&seg[llhdrlen];
+          uint16_t iplen = iphdrlen + tcphdrlen + seglen;
+
+          ipv4->len[0]   = iplen >> 8;
+          ipv4->len[1]   = iplen & 0xff;
+          ipv4->ipchksum = 0;
+
+          if (offset > 0)
+            {
+              ++g_ipid;
+              ipv4->ipid[0] = g_ipid >> 8;
+              ipv4->ipid[1] = g_ipid & 0xff;
+            }
+
+          if (!NETDEV_TXCSUM_OFFLOAD(dev))
+            {
+              tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+              ipv4->ipchksum = ~ipv4_chksum(dev);
+            }
+        }
+#endif /* CONFIG_NET_IPv4 */
+
+      ret = netdev_iob_copyframe(dev, txq);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      nframes++;
+    }
+
+  dev->d_buf     = buf;
+  dev->d_len     = 0;
+  dev->d_gsosize = 0;
+
+  if (ret < 0)
+    {
+      nwarn("WARNING: Dropped %u bytes of TCP super-segment: %d\n",
+            datalen - offset, ret);
+    }
+
+  return nframes > 0 ? nframes : ret;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/****************************************************************************
+ * Name: netdev_iob_txframe
+ *
+ * Description:
+ *   Move the complete frame in d_buf to the end of a queue of frames to be
+ *   transmitted.  If d_buf lies in an I/O buffer, then that I/O buffer is
+ *   queued and a fresh one takes its place; otherwise the frame is copied
+ *   into a new I/O buffer chain.  A TCP super-segment is split into
+ *   several frames.
+ *
+ * Returned Value:
+ *   The number of frames queued; a negated errno value on failure.  The
+ *   frame is dropped on failure.  In either case d_len is zero on return.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int netdev_iob_txframe(FAR struct net_driver_s *dev,
+                              FAR struct iob_queue_s *txq)
+{
+  FAR struct iob_s *iob;
+  int ret;
+
+  DEBUGASSERT(dev->d_len > 0);
+
+#ifdef CONFIG_NET_TCP_GSO
+  /* A TCP super-segment must always be split, even if it fits in the MTU:
+   * It may be larger than the peer's MSS and its checksums have not been
+   * calculated.  arp_out() and neighbor_out() clear d_gsosize if they
+   * replace the frame with an ARP request or a Neighbor Solicitation.
+   */
+
+  if (NETDEV_GSO(dev))
+    {
+      return netdev_iob_gso(dev, txq);
+    }
+#endif
+
+  if (NETDEV_IOB_ZEROCOPY(dev))
+    {
+      FAR struct iob_s *frame = dev->d_iob;
+
+      iob = iob_tryalloc(false);
+      if (iob == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      frame->io_offset = 0;
+      frame->io_len    = dev->d_len;
+      frame->io_pktlen = dev->d_len;
+
+      ret = iob_tryadd_queue(frame, txq);
+      if (ret < 0)
+        {
+          iob_free(iob);
+          goto errout;
+        }
+
+      /* The new I/O buffer holds the next packet */
+
+      dev->d_iob = iob;
+      dev->d_buf = iob->io_data;
+    }
+  else
+    {
+      ret = netdev_iob_copyframe(dev, txq);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  dev->d_len = 0;
+  return 1;
+
+errout:
+  nwarn("WARNING: Dropped TX frame: %d\n", ret);
+  dev->d_len = 0;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_txpoll
+ *
+ * Description:
+ *   The devif_poll() callback used by netdev_iob_poll() and
+ *   netdev_iob_timer().
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int netdev_iob_txpoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_iob_poll_s *poll = g_iob_poll;
+
+  DEBUGASSERT(poll != NULL);
+
+  if (dev->d_len > 0)
+    {
+      int ret;
+
+      netdev_iob_llout(dev);
+      ret = netdev_iob_txframe(dev, poll->txq);
+      if (ret > 0)
+        {
+          poll->nframes += ret;
+        }
+    }
+
+  /* Stop polling when the driver cannot accept any more frames */
+
+  return poll->nframes >= poll->maxframes;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_dispatch
+ *
+ * Description:
+ *   Pass the received frame in d_buf to the network.  Any response is
+ *   queued for transmission.
+ *
+ * Returned Value:
+ *   The number of frames added to the TX queue.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static unsigned int netdev_iob_dispatch(FAR struct net_driver_s *dev,
+                                        FAR struct iob_queue_s *txq)
+{
+  bool llout = true;
+  int ret;
+
+  NETDEV_RXPACKETS(dev);
+
+#ifdef CONFIG_NET_ETHERNET
+  if (dev->d_lltype == NET_LL_ETHERNET)
+    {
+      if (dev->d_len < ETH_HDRLEN)
+        {
+          NETDEV_RXERRORS(dev);
+          dev->d_len = 0;
+          return 0;
+        }
+
+#ifdef CONFIG_NET_PKT
+      /* When packet sockets are enabled, feed the frame into the packet
+       * tap.
+       */
+
+      pkt_input(dev);
+#endif
+
+#ifdef CONFIG_NET_IPv4
+      if (ETHBUF->type == HTONS(ETHTYPE_IP))
+        {
+          NETDEV_RXIPV4(dev);
+
+          /* Handle ARP on input then give the IPv4 packet to the network
+           * layer.
+           */
+
+          arp_ipin(dev);
+          ipv4_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if (ETHBUF->type == HTONS(ETHTYPE_IP6))
+        {
+          NETDEV_RXIPV6(dev);
+          ipv6_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_ARP
+      if (ETHBUF->type == HTONS(ETHTYPE_ARP))
+        {
+          NETDEV_RXARP(dev);
+
+          /* An ARP response is already a complete Ethernet frame */
+
+          arp_arpin(dev);
+          llout = false;
+        }
+      else
+#endif
+        {
+          NETDEV_RXDROPPED(dev);
+          dev->d_len = 0;
+        }
+    }
+  else
+#endif /* CONFIG_NET_ETHERNET */
+
+  /* Devices without a link layer header carry bare IP packets.  Select the
+   * IP version from the first nibble of the packet.
+   */
+
+  if (NET_LL_HDRLEN(dev) == 0 && dev->d_len > 0)
+    {
+#ifdef CONFIG_NET_IPv4
+      if ((dev->d_buf[0] & 0xf0) == 0x40)
+        {
+          NETDEV_RXIPV4(dev);
+          ipv4_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if ((dev->d_buf[0] & 0xf0) == 0x60)
+        {
+          NETDEV_RXIPV6(dev);
+          ipv6_input(dev);
+        }
+      else
+#endif
+        {
+          NETDEV_RXDROPPED(dev);
+          dev->d_len = 0;
+        }
+    }
+  else
+    {
+      nerr("ERROR: Unsupported link layer: %u\n", dev->d_lltype);
+      NETDEV_RXDROPPED(dev);
+      dev->d_len = 0;
+    }
+
+  /* If the above resulted in a response that should be sent out on the
+   * network, d_len is set to a value > 0.
+   */
+
+  if (dev->d_len > 0)
+    {
+      if (llout)
+        {
+          netdev_iob_llout(dev);
+        }
+
+      ret = netdev_iob_txframe(dev, txq);
+      if (ret > 0)
+        {
+          return ret;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_dopoll
+ *
+ * Description:
+ *   Perform the poll or timer operation for netdev_iob_poll() and
+ *   netdev_iob_timer().
+ *
+ ****************************************************************************/
+
+static int netdev_iob_dopoll(FAR struct net_driver_s *dev,
+                             FAR struct iob_queue_s *txq,
+                             unsigned int maxframes, bool timer)
+{
+  struct netdev_iob_poll_s poll;
+  int ret;
+
+  DEBUGASSERT(dev != NULL && txq != NULL);
+
+  if (maxframes == 0)
+    {
+      return 0;
+    }
+
+  net_lock();
+  ret = netdev_iob_prepare(dev);
+  if (ret >= 0)
+    {
+      poll.txq       = txq;
+      poll.maxframes = maxframes;
+      poll.nframes   = 0;
+      g_iob_poll     = &poll;
+
+      if (timer)
+        {
+          (void)devif_timer(dev, netdev_iob_txpoll);
+        }
+      else
+        {
+          (void)devif_poll(dev, netdev_iob_txpoll);
+        }
+
+      g_iob_poll     = NULL;
+      ret            = poll.nframes;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_input
+ *
+ * Description:
+ *   Pass a batch of received frames to the network.  Each frame is an I/O
+ *   buffer chain with io_pktlen holding the length of the frame, including
+ *   the link layer header.  The network is locked only once for the whole
+ *   batch.
+ *
+ *   If the driver did not provide d_buf and a frame is held in a single I/O
+ *   buffer with no leading offset, the frame is processed in place without
+ *   being copied.  Otherwise the frame is copied into d_buf.
+ *
+ *   Any responses (ARP replies, TCP ACKs, ...) are added to the end of
+ *   'txq' as complete link layer frames for the driver to transmit.
+ *
+ * Input Parameters:
+ *   dev - The network device that received the frames
+ *   rxq - The queue of received frames.  All frames are consumed.
+ *   txq - The queue that receives the frames to be transmitted
+ *
+ * Returned Value:
+ *   The number of frames added to 'txq'; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int netdev_iob_input(FAR struct net_driver_s *dev,
+                     FAR struct iob_queue_s *rxq,
+                     FAR struct iob_queue_s *txq)
+{
+  FAR struct iob_s *iob;
+  unsigned int ntx = 0;
+  int ret;
+
+  DEBUGASSERT(dev != NULL && rxq != NULL && txq != NULL);
+
+  net_lock();
+  ret = netdev_iob_prepare(dev);
+  if (ret < 0)
+    {
+      iob_free_queue(rxq);
+      net_unlock();
+      return ret;
+    }
+
+  while ((iob = iob_remove_queue(rxq)) != NULL)
+    {
+      unsigned int len = iob->io_pktlen;
+
+      if (len == 0 || len > dev->d_mtu)
+        {
+          NETDEV_RXERRORS(dev);
+          iob_free_chain(iob);
+          continue;
+        }
+
+      if (NETDEV_IOB_ZEROCOPY(dev) && iob->io_flink == NULL &&
+          iob->io_offset == 0)
+        {
+          /* Process the frame in place.  The previous packet buffer is no
+           * longer needed.
+           */
+
+          iob_free(dev->d_iob);
+          dev->d_iob = iob;
+          dev->d_buf = iob->io_data;
+        }
+      else
+        {
+          (void)iob_copyout(dev->d_buf, iob, len, 0);
+          iob_free_chain(iob);
+        }
+
+      dev->d_len = len;
+      ntx       += netdev_iob_dispatch(dev, txq);
+    }
+
+  net_unlock();
+  return ntx;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_poll and netdev_iob_timer
+ *
+ * Description:
+ *   Like devif_poll() and devif_timer() except that up to 'maxframes'
+ *   frames to be transmitted are collected in one call.  Each frame is
+ *   added to the end of 'txq' as an I/O buffer chain with io_pktlen
+ *   holding the length of the frame, including the link layer header.
+ *   The link layer header has already been completed (arp_out() and
+ *   neighbor_out() are called as needed).
+ *
+ *   If CONFIG_NET_TCP_GSO is enabled and the driver has set d_gsomax, then
+ *   TCP super-segments are split here into MSS-sized frames.  All of the
+ *   frames of a super-segment are queued together, so the number of frames
+ *   returned may exceed 'maxframes' by the frames of the last one.
+ *
+ * Input Parameters:
+ *   dev       - The network device to poll
+ *   txq       - The queue that receives the frames to be transmitted
+ *   maxframes - The largest number of frames that the driver can accept
+ *
+ * Returned Value:
+ *   The number of frames added to 'txq'; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int netdev_iob_poll(FAR struct net_driver_s *dev,
+                    FAR struct iob_queue_s *txq, unsigned int maxframes)
+{
+  return netdev_iob_dopoll(dev, txq, maxframes, false);
+}
+
+int netdev_iob_timer(FAR struct net_driver_s *dev,
+                     FAR struct iob_queue_s *txq, unsigned int maxframes)
+{
+  return netdev_iob_dopoll(dev, txq, maxframes, true);
+}
+
+#endif /* CONFIG_NET && CONFIG_NETDEV_IOB */
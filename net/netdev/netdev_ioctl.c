@@ -90,6 +90,10 @@
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 #if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
 
 /****************************************************************************
@@ -330,7 +334,8 @@ static void ioctl_get_ipv6addr(FAR struct sockaddr_storage *outaddr,
  * Name: ioctl_set_ipv4addr
  *
  * Description:
- *   Copy IP addresses from user memory into the device structure
+ *   Copy IP addresses from user memory into the device structure and
+ *   discard any forwarding flows that were cached under the old address.
  *
  * Input Parameters:
  *   outaddr - Pointer to the source IP address in the device structure.
@@ -345,6 +350,12 @@ static void ioctl_set_ipv4addr(FAR in_addr_t *outaddr,
 {
   FAR const struct sockaddr_in *src = (FAR const struct sockaddr_in *)inaddr;
   *outaddr = src->sin_addr.s_addr;
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Flows cached under the old address may now be forwarded differently */
+
+  ipfwd_flow_flush(NULL);
+#endif
 }
 #endif
 
@@ -352,7 +363,8 @@ static void ioctl_set_ipv4addr(FAR in_addr_t *outaddr,
  * Name: ioctl_set_ipv6addr
  *
  * Description:
- *   Copy IP addresses from user memory into the device structure
+ *   Copy IP addresses from user memory into the device structure and
+ *   discard any forwarding flows that were cached under the old address.
  *
  * Input Parameters:
  *   outaddr - Pointer to the source IP address in the device structure.
@@ -367,6 +379,12 @@ static void ioctl_set_ipv6addr(FAR net_ipv6addr_t outaddr,
 {
   FAR const struct sockaddr_in6 *src = (FAR const struct sockaddr_in6 *)inaddr;
   memcpy(outaddr, src->sin6_addr.in6_u.u6_addr8, 16);
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Flows cached under the old address may now be forwarded differently */
+
+  ipfwd_flow_flush(NULL);
+#endif
 }
 #endif
 
@@ -954,6 +972,9 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
 #endif
 #ifdef CONFIG_NET_IPv6
               memset(&dev->d_ipv6addr, 0, sizeof(net_ipv6addr_t));
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+              ipfwd_flow_flush(NULL);
 #endif
               ret = OK;
             }
@@ -1546,6 +1567,12 @@ void netdev_ifdown(FAR struct net_driver_s *dev)
             }
         }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Forget any flows that are forwarded on the device */
+
+      ipfwd_flow_flush(dev);
+#endif
+
       /* Notify clients that the network has been taken down */
 
       (void)devif_dev_event(dev, NULL, NETDEV_DOWN);
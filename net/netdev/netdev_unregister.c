@@ -55,6 +55,10 @@
 #include "utils/utils.h"
 #include "netdev/netdev.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -122,6 +126,12 @@ int netdev_unregister(FAR struct net_driver_s *dev)
             }
 
           curr->flink = NULL;
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+          /* Forget any flows that are forwarded on the device */
+
+          ipfwd_flow_flush(dev);
+#endif
         }
 
       net_unlock();
@@ -71,20 +71,29 @@
 
 /* Directory entry indices */
 
-#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_ROUTE)
-#  define STAT_INDEX  0
-#  define ROUTE_INDEX 1
-#  define DEV_INDEX   2
-#elif defined(CONFIG_NET_STATISTICS)
+#ifdef CONFIG_NET_STATISTICS
 #  define STAT_INDEX  0
-#  define DEV_INDEX   1
-#elif defined(CONFIG_NET_ROUTE)
-#  define ROUTE_INDEX 0
-#  define DEV_INDEX   1
+#  define NSTAT       1
+#else
+#  define NSTAT       0
+#endif
+
+#ifdef CONFIG_NET_ROUTE
+#  define ROUTE_INDEX NSTAT
+#  define NROUTE      1
+#else
+#  define NROUTE      0
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  define FLOWS_INDEX (NSTAT + NROUTE)
+#  define NFLOWS      1
 #else
-#  define DEV_INDEX   0
+#  define NFLOWS      0
 #endif
 
+#define DEV_INDEX     (NSTAT + NROUTE + NFLOWS)
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -178,6 +187,19 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
   else
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* "net/flows" is an acceptable value for the relpath only if the IP
+   * forwarding flow cache is enabled.
+   */
+
+  if (strcmp(relpath, "net/flows") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_FLOWS;
+      dev   = NULL;
+    }
+  else
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* "net/route" is an acceptable value for the relpath only if routing
    * table support is initialized.
@@ -297,6 +319,14 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
         break;
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      case NETPROCFS_SUBDIR_FLOWS:
+        /* Show the flows of the IP forwarding flow cache */
+
+        nreturned = netprocfs_read_flows(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -416,6 +446,9 @@ static int netprocfs_opendir(FAR const char *relpath,
 #endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      level1->base.nentries++;
 #endif
     }
   else
@@ -519,6 +552,16 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
           strncpy(dir->fd_dir.d_name, "route", NAME_MAX + 1);
         }
       else
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      if (index == FLOWS_INDEX)
+        {
+          /* Copy the forwarding flow cache directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "flows", NAME_MAX + 1);
+        }
+      else
 #endif
         {
           int devndx = index - DEV_INDEX;
@@ -606,6 +649,15 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
       buf->st_mode = S_IFDIR | S_IROTH | S_IRGRP | S_IRUSR;
     }
   else
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Check for the forwarding flow cache "net/flows" */
+
+  if (strcmp(relpath, "net/flows") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
 #endif
     {
       FAR struct net_driver_s *dev;
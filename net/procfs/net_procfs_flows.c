@@ -0,0 +1,254 @@
+/****************************************************************************
+ * net/procfs/net_procfs_flows.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+#include <net/if.h>
+
+#include <nuttx/net/netdev.h>
+
+#include "ipforward/ipforward.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && \
+    defined(CONFIG_NET_IPFORWARD_FLOWCACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Line 0 is the header; lines 1 .. CONFIG_NET_IPFORWARD_NFLOWS hold the
+ * entries of the flow cache.
+ */
+
+#define NFLOW_LINES (CONFIG_NET_IPFORWARD_NFLOWS + 1)
+
+#ifdef CONFIG_NET_IPv6
+#  define FLOW_ADDRSTRLEN INET6_ADDRSTRLEN
+#else
+#  define FLOW_ADDRSTRLEN INET_ADDRSTRLEN
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_flow_line
+ *
+ * Description:
+ *   Format one line of /proc/net/flows:
+ *
+ *   PROTO SOURCE          SPORT DEST            DPORT DEV      PACKETS BYTES
+ *   nnn   xxx.xxx.xxx.xxx nnnnn xxx.xxx.xxx.xxx nnnnn ifname   nnnnnnn nnnnn
+ *
+ * Returned Value:
+ *   The length of the line; zero if the flow cache entry is not in use.
+ *
+ ****************************************************************************/
+
+static int netprocfs_flow_line(FAR struct netprocfs_file_s *netfile,
+                               int lineno)
+{
+  struct ipfwd_flow_s flow;
+  char srcaddr[FLOW_ADDRSTRLEN];
+  char destaddr[FLOW_ADDRSTRLEN];
+  char ifname[IFNAMSIZ];
+  int ret;
+
+  if (lineno == 0)
+    {
+      return snprintf(netfile->line, NET_LINELEN,
+                      "PROTO %-15s SPORT %-15s DPORT %-8s %10s %10s\n",
+                      "SOURCE", "DEST", "DEV", "PACKETS", "BYTES");
+    }
+
+  ret = ipfwd_flow_get(lineno - 1, &flow, ifname);
+  if (ret < 0)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (flow.fl_domain == PF_INET)
+#endif
+    {
+      (void)inet_ntop(AF_INET, &flow.fl_srcaddr.ipv4, srcaddr,
+                      FLOW_ADDRSTRLEN);
+      (void)inet_ntop(AF_INET, &flow.fl_destaddr.ipv4, destaddr,
+                      FLOW_ADDRSTRLEN);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      (void)inet_ntop(AF_INET6, flow.fl_srcaddr.ipv6, srcaddr,
+                      FLOW_ADDRSTRLEN);
+      (void)inet_ntop(AF_INET6, flow.fl_destaddr.ipv6, destaddr,
+                      FLOW_ADDRSTRLEN);
+    }
+#endif
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-5u %-15s %5u %-15s %5u %-8s %10lu %10lu\n",
+                  flow.fl_proto, srcaddr, flow.fl_srcport, destaddr,
+                  flow.fl_destport, ifname,
+                  (unsigned long)flow.fl_packets,
+                  (unsigned long)flow.fl_bytes);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_flows
+ *
+ * Description:
+ *   Read and format the entries of the IP forwarding flow cache.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_flows(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen)
+{
+  size_t xfrsize;
+  ssize_t nreturned;
+
+  finfo("buffer=%p buflen=%lu\n", buffer, (unsigned long)buflen);
+
+  /* Is there line data already buffered? */
+
+  nreturned = 0;
+  if (priv->linesize > 0)
+    {
+      /* Yes, how much can we transfer now? */
+
+      xfrsize = priv->linesize;
+      if (xfrsize > buflen)
+        {
+          xfrsize = buflen;
+        }
+
+      /* Transfer the data to the user buffer */
+
+      memcpy(buffer, &priv->line[priv->offset], xfrsize);
+
+      /* Update pointers, sizes, and offsets */
+
+      buffer         += xfrsize;
+      buflen         -= xfrsize;
+
+      priv->linesize -= xfrsize;
+      priv->offset   += xfrsize;
+      nreturned       = xfrsize;
+    }
+
+  /* Loop until the user buffer is full or until all of the flows have
+   * been transferred.  Unused flow cache entries generate no line.  This
+   * is the same logic as netprocfs_read_linegen(), but the line generator
+   * needs the line number.
+   */
+
+  while (buflen > 0 && priv->lineno < NFLOW_LINES)
+    {
+      int len;
+
+      /* Read the next line into the working buffer */
+
+      len = netprocfs_flow_line(priv, priv->lineno);
+      if (len >= NET_LINELEN)
+        {
+          len = NET_LINELEN - 1;
+        }
+
+      /* Update line-related information */
+
+      priv->lineno++;
+      priv->linesize = len;
+      priv->offset = 0;
+
+      /* Transfer data to the user buffer */
+
+      xfrsize = priv->linesize;
+      if (xfrsize > buflen)
+        {
+          xfrsize = buflen;
+        }
+
+      memcpy(buffer, &priv->line[priv->offset], xfrsize);
+
+      /* Update pointers, sizes, and offsets */
+
+      buffer         += xfrsize;
+      buflen         -= xfrsize;
+
+      priv->linesize -= xfrsize;
+      priv->offset   += xfrsize;
+      nreturned      += xfrsize;
+    }
+
+  return nreturned;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_IPFORWARD_FLOWCACHE */
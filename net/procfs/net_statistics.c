@@ -78,6 +78,9 @@ static int     netprocfs_prototype(FAR struct netprocfs_file_s *netfile);
 static int     netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int     netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+static int     netprocfs_tcp_dlyack(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_TCP_DELAYED_ACK */
 #endif /* CONFIG_NET_TCP */
 
 /****************************************************************************
@@ -112,6 +115,9 @@ static const linegen_t g_stat_linegen[] =
 
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  , netprocfs_tcp_dlyack
+#endif /* CONFIG_NET_TCP_DELAYED_ACK */
 #endif /* CONFIG_NET_TCP */
 };
 
@@ -435,6 +441,19 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_tcp_dlyack
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_TCP_DELAYED_ACK)
+static int netprocfs_tcp_dlyack(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  TCP      DlyACK: %04x Saved: %04x\n",
+                  g_netstats.tcp.dlyack, g_netstats.tcp.acksaved);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP_DELAYED_ACK */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -58,7 +58,11 @@
  * to handle the longest line generated by this logic.
  */
 
-#define NET_LINELEN 80
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv6)
+#  define NET_LINELEN 160
+#else
+#  define NET_LINELEN 80
+#endif
 
 /****************************************************************************
  * Public Type Definitions
@@ -75,6 +79,9 @@ enum netprocfs_entry_e
 #ifdef CONFIG_NET_ROUTE
   , NETPROCFS_SUBDIR_ROUTE           /* /proc/net/route */
 #endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  , NETPROCFS_SUBDIR_FLOWS           /* /proc/net/flows */
+#endif
 };
 
 /* This structure describes one open "file" */
@@ -189,6 +196,29 @@ ssize_t netprocfs_read_routes(FAR struct netprocfs_file_s *priv,
                               FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_flows
+ *
+ * Description:
+ *   Read and format the entries of the IP forwarding flow cache.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+ssize_t netprocfs_read_flows(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_devstats
  *
@@ -50,8 +50,13 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
 /****************************************************************************
@@ -100,6 +105,19 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   (void)net_closeroute_ipv4(&fshandle);
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv4();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -134,6 +152,19 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   (void)net_closeroute_ipv6(&fshandle);
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv6();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -50,8 +50,13 @@
 #include <arch/irq.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
 /****************************************************************************
@@ -100,6 +105,19 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv4();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   net_unlock();
   return OK;
 }
@@ -135,6 +153,19 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv6();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   net_unlock();
   return OK;
 }
@@ -52,8 +52,13 @@
 
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
 /****************************************************************************
@@ -285,6 +290,18 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_flushcache_ipv4();
 #endif
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Likewise, the longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv4();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -437,6 +454,18 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_flushcache_ipv6();
 #endif
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Likewise, the longest prefix match trie must be rebuilt */
+
+  net_flushlpm_ipv6();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
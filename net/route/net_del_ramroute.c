@@ -45,11 +45,17 @@
 #include <debug.h>
 
 #include <arpa/inet.h>
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  include "ipforward/ipforward.h"
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
 /****************************************************************************
@@ -212,6 +218,7 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -221,7 +228,23 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  net_lock();
+  ret = net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt before the next lookup */
+
+  net_flushlpm_ipv4();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
+  net_unlock();
+  return ret;
 }
 #endif
 
@@ -229,6 +252,7 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -238,7 +262,23 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  net_lock();
+  ret = net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+
+#ifdef CONFIG_ROUTE_LPM
+  /* The longest prefix match trie must be rebuilt before the next lookup */
+
+  net_flushlpm_ipv6();
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Cached forwarding decisions may no longer match the routing table */
+
+  ipfwd_flow_flush(NULL);
+#endif
+
+  net_unlock();
+  return ret;
 }
 #endif
 
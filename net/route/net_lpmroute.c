@@ -0,0 +1,800 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE) && \
+    defined(CONFIG_ROUTE_LPM)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each route adds at most two nodes to the trie:  The node that holds the
+ * route and a branch node where its prefix diverges from another.
+ */
+
+#define LPM_MAXNODES  (2 * CONFIG_ROUTE_LPM_MAXROUTES)
+
+/* Marks the absence of a node or a route */
+
+#define LPM_NONE      0xff
+
+/* Get bit 'n' of an address in network order.  Bit 0 is the most
+ * significant bit of the first byte.
+ */
+
+#define LPM_BIT(a,n)  (((a)[(n) >> 3] >> (7 - ((n) & 7))) & 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of the trie.  A node with a route matches every address that
+ * begins with its prefix; a node without a route only marks the point
+ * where the prefixes of its children diverge.
+ */
+
+struct lpm_node_s
+{
+  uint8_t plen;                  /* Length of the prefix in bits */
+  uint8_t route;                 /* Index of the route or LPM_NONE */
+  uint8_t child[2];              /* Index of each child node or LPM_NONE */
+  uint8_t prefix[16];            /* The prefix in network order */
+};
+
+/* The trie built from one routing table */
+
+struct lpm_trie_s
+{
+  bool valid;                    /* True: The trie holds the routing table */
+  bool overflow;                 /* True: The routing table did not fit */
+  uint8_t addrlen;               /* Size of an address in bytes */
+  uint8_t root;                  /* Index of the root node or LPM_NONE */
+  uint8_t nnodes;                /* Number of nodes in use */
+  uint8_t nroutes;               /* Number of routes in use */
+  struct lpm_node_s nodes[LPM_MAXNODES];
+};
+
+/* One cached lookup.  The route is LPM_NONE if there is no route to the
+ * destination.
+ */
+
+#ifdef CONFIG_NET_IPv4
+struct lpm_ipv4_cache_s
+{
+  bool valid;                    /* True: The entry holds a lookup */
+  uint8_t route;                 /* Index of the route or LPM_NONE */
+  in_addr_t target;              /* The destination address */
+};
+
+struct lpm_ipv4_s
+{
+  struct lpm_trie_s trie;
+  struct net_route_ipv4_s routes[CONFIG_ROUTE_LPM_MAXROUTES];
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  struct lpm_ipv4_cache_s cache[CONFIG_ROUTE_LPM_CACHESIZE];
+#endif
+};
+
+/* The state of a linear search for the longest matching route */
+
+struct lpm_ipv4_match_s
+{
+  in_addr_t target;              /* The destination address */
+  int plen;                      /* Prefix length of the best route or -1 */
+  struct net_route_ipv4_s route; /* Copy of the best route */
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+struct lpm_ipv6_cache_s
+{
+  bool valid;                    /* True: The entry holds a lookup */
+  uint8_t route;                 /* Index of the route or LPM_NONE */
+  net_ipv6addr_t target;         /* The destination address */
+};
+
+struct lpm_ipv6_s
+{
+  struct lpm_trie_s trie;
+  struct net_route_ipv6_s routes[CONFIG_ROUTE_LPM_MAXROUTES];
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  struct lpm_ipv6_cache_s cache[CONFIG_ROUTE_LPM_CACHESIZE];
+#endif
+};
+
+struct lpm_ipv6_match_s
+{
+  net_ipv6addr_t target;         /* The destination address */
+  int plen;                      /* Prefix length of the best route or -1 */
+  struct net_route_ipv6_s route; /* Copy of the best route */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static struct lpm_ipv4_s g_ipv4_lpm;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static struct lpm_ipv6_s g_ipv6_lpm;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_masklen
+ *
+ * Description:
+ *   Return the number of leading one bits in a network mask, or -EINVAL if
+ *   the mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_masklen(FAR const uint8_t *mask, unsigned int addrlen)
+{
+  unsigned int nbits;
+  unsigned int i;
+
+  for (nbits = 0; nbits < 8 * addrlen && LPM_BIT(mask, nbits); nbits++);
+
+  for (i = nbits; i < 8 * addrlen; i++)
+    {
+      if (LPM_BIT(mask, i))
+        {
+          return -EINVAL;
+        }
+    }
+
+  return nbits;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits, up to 'maxbits', in which two
+ *   addresses agree.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *a, FAR const uint8_t *b,
+                               unsigned int maxbits)
+{
+  unsigned int nbits = 0;
+  uint8_t diff;
+
+  while (nbits < maxbits)
+    {
+      diff = a[nbits >> 3] ^ b[nbits >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              nbits++;
+            }
+
+          break;
+        }
+
+      nbits += 8;
+    }
+
+  return nbits < maxbits ? nbits : maxbits;
+}
+
+/****************************************************************************
+ * Name: lpm_reset
+ *
+ * Description:
+ *   Empty the trie.
+ *
+ ****************************************************************************/
+
+static void lpm_reset(FAR struct lpm_trie_s *trie, unsigned int addrlen)
+{
+  trie->valid    = false;
+  trie->overflow = false;
+  trie->addrlen  = addrlen;
+  trie->root     = LPM_NONE;
+  trie->nnodes   = 0;
+  trie->nroutes  = 0;
+}
+
+/****************************************************************************
+ * Name: lpm_alloc
+ *
+ * Description:
+ *   Allocate and initialize a node.  Returns LPM_NONE if there are no free
+ *   nodes.
+ *
+ ****************************************************************************/
+
+static uint8_t lpm_alloc(FAR struct lpm_trie_s *trie,
+                         FAR const uint8_t *prefix, unsigned int plen,
+                         uint8_t route)
+{
+  FAR struct lpm_node_s *node;
+
+  if (trie->nnodes >= LPM_MAXNODES)
+    {
+      return LPM_NONE;
+    }
+
+  node           = &trie->nodes[trie->nnodes];
+  node->plen     = plen;
+  node->route    = route;
+  node->child[0] = LPM_NONE;
+  node->child[1] = LPM_NONE;
+  memcpy(node->prefix, prefix, trie->addrlen);
+
+  return trie->nnodes++;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a route with the prefix 'prefix' of length 'plen' to the trie.
+ *   Bits of the prefix beyond 'plen' must be zero.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the trie is full.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *prefix,
+                      unsigned int plen, uint8_t route)
+{
+  FAR struct lpm_node_s *node;
+  FAR uint8_t *link = &trie->root;
+  unsigned int common;
+  uint8_t branch;
+  uint8_t leaf;
+
+  while (*link != LPM_NONE)
+    {
+      node   = &trie->nodes[*link];
+      common = lpm_common(prefix, node->prefix,
+                          plen < node->plen ? plen : node->plen);
+
+      if (common < node->plen)
+        {
+          /* The new prefix is shorter than the prefix of this node or the
+           * two diverge.  If it is shorter, the new node goes just above
+           * this one.
+           */
+
+          if (common == plen)
+            {
+              leaf = lpm_alloc(trie, prefix, plen, route);
+              if (leaf == LPM_NONE)
+                {
+                  return -ENOMEM;
+                }
+
+              trie->nodes[leaf].child[LPM_BIT(node->prefix, plen)] = *link;
+              *link = leaf;
+              return OK;
+            }
+
+          /* Otherwise a branch node goes above both */
+
+          branch = lpm_alloc(trie, prefix, common, LPM_NONE);
+          leaf   = lpm_alloc(trie, prefix, plen, route);
+          if (branch == LPM_NONE || leaf == LPM_NONE)
+            {
+              return -ENOMEM;
+            }
+
+          trie->nodes[branch].child[LPM_BIT(prefix, common)] = leaf;
+          trie->nodes[branch].child[LPM_BIT(node->prefix, common)] = *link;
+          *link = branch;
+          return OK;
+        }
+
+      if (plen == node->plen)
+        {
+          /* The same prefix.  A branch node takes the route.  Otherwise this
+           * is a duplicate route and, as with the linear search, the first
+           * one wins.
+           */
+
+          if (node->route == LPM_NONE)
+            {
+              node->route = route;
+            }
+
+          return OK;
+        }
+
+      link = &node->child[LPM_BIT(prefix, node->plen)];
+    }
+
+  leaf = lpm_alloc(trie, prefix, plen, route);
+  if (leaf == LPM_NONE)
+    {
+      return -ENOMEM;
+    }
+
+  *link = leaf;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the index of the route with the longest prefix that matches
+ *   'addr', or LPM_NONE.
+ *
+ ****************************************************************************/
+
+static uint8_t lpm_lookup(FAR struct lpm_trie_s *trie,
+                          FAR const uint8_t *addr)
+{
+  FAR struct lpm_node_s *node;
+  uint8_t route = LPM_NONE;
+  uint8_t ndx   = trie->root;
+
+  while (ndx != LPM_NONE)
+    {
+      node = &trie->nodes[ndx];
+      if (lpm_common(addr, node->prefix, node->plen) < node->plen)
+        {
+          break;
+        }
+
+      if (node->route != LPM_NONE)
+        {
+          route = node->route;
+        }
+
+      if (node->plen >= 8 * trie->addrlen)
+        {
+          break;
+        }
+
+      ndx = node->child[LPM_BIT(addr, node->plen)];
+    }
+
+  return route;
+}
+
+/****************************************************************************
+ * Name: lpm_hash
+ *
+ * Description:
+ *   Select the cache entry for an address.
+ *
+ ****************************************************************************/
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+static unsigned int lpm_hash(FAR const uint8_t *addr, unsigned int addrlen)
+{
+  unsigned int hash = 0;
+  unsigned int i;
+
+  for (i = 0; i < addrlen; i++)
+    {
+      hash = (hash << 3) ^ (hash >> 5) ^ addr[i];
+    }
+
+  return hash % CONFIG_ROUTE_LPM_CACHESIZE;
+}
+#endif
+
+/****************************************************************************
+ * Name: lpm_ipv4_add
+ *
+ * Description:
+ *   net_foreachroute_ipv4() callback that adds one route to the trie.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static int lpm_ipv4_add(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  FAR struct lpm_trie_s *trie = &g_ipv4_lpm.trie;
+  in_addr_t prefix;
+  int plen;
+
+  plen = lpm_masklen((FAR const uint8_t *)&route->netmask,
+                     sizeof(in_addr_t));
+  if (plen < 0 || trie->nroutes >= CONFIG_ROUTE_LPM_MAXROUTES)
+    {
+      trie->overflow = true;
+      return 1;
+    }
+
+  prefix = route->target & route->netmask;
+  if (lpm_insert(trie, (FAR const uint8_t *)&prefix, plen,
+                 trie->nroutes) < 0)
+    {
+      trie->overflow = true;
+      return 1;
+    }
+
+  memcpy(&g_ipv4_lpm.routes[trie->nroutes], route,
+         sizeof(struct net_route_ipv4_s));
+  trie->nroutes++;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lpm_ipv4_match
+ *
+ * Description:
+ *   net_foreachroute_ipv4() callback that remembers the longest matching
+ *   route.  Used if the routing table does not fit into the trie.
+ *
+ ****************************************************************************/
+
+static int lpm_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  FAR struct lpm_ipv4_match_s *match = (FAR struct lpm_ipv4_match_s *)arg;
+  int plen;
+
+  if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
+    {
+      plen = lpm_masklen((FAR const uint8_t *)&route->netmask,
+                         sizeof(in_addr_t));
+      if (plen > match->plen)
+        {
+          match->plen = plen;
+          memcpy(&match->route, route, sizeof(struct net_route_ipv4_s));
+        }
+    }
+
+  return 0;
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: lpm_ipv6_add and lpm_ipv6_match
+ *
+ * Description:
+ *   The IPv6 counterparts of lpm_ipv4_add() and lpm_ipv4_match().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static int lpm_ipv6_add(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  FAR struct lpm_trie_s *trie = &g_ipv6_lpm.trie;
+  net_ipv6addr_t prefix;
+  int plen;
+  int i;
+
+  plen = lpm_masklen((FAR const uint8_t *)route->netmask,
+                     sizeof(net_ipv6addr_t));
+  if (plen < 0 || trie->nroutes >= CONFIG_ROUTE_LPM_MAXROUTES)
+    {
+      trie->overflow = true;
+      return 1;
+    }
+
+  for (i = 0; i < 8; i++)
+    {
+      prefix[i] = route->target[i] & route->netmask[i];
+    }
+
+  if (lpm_insert(trie, (FAR const uint8_t *)prefix, plen,
+                 trie->nroutes) < 0)
+    {
+      trie->overflow = true;
+      return 1;
+    }
+
+  memcpy(&g_ipv6_lpm.routes[trie->nroutes], route,
+         sizeof(struct net_route_ipv6_s));
+  trie->nroutes++;
+  return 0;
+}
+
+static int lpm_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  FAR struct lpm_ipv6_match_s *match = (FAR struct lpm_ipv6_match_s *)arg;
+  int plen;
+
+  if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask))
+    {
+      plen = lpm_masklen((FAR const uint8_t *)route->netmask,
+                         sizeof(net_ipv6addr_t));
+      if (plen > match->plen)
+        {
+          match->plen = plen;
+          memcpy(&match->route, route, sizeof(struct net_route_ipv6_s));
+        }
+    }
+
+  return 0;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4
+ *
+ * Description:
+ *   Find the route with the longest prefix that matches the target
+ *   address.
+ *
+ * Parameters:
+ *   target - An IPv4 address on a remote network to use in the lookup.
+ *   route  - The location to return a copy of the matching route.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if no route
+ *   matches the target address.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_lpmroute_ipv4(in_addr_t target, FAR struct net_route_ipv4_s *route)
+{
+  FAR struct lpm_trie_s *trie = &g_ipv4_lpm.trie;
+  uint8_t ndx;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  FAR struct lpm_ipv4_cache_s *entry;
+#endif
+
+  /* (Re-)build the trie if the routing table has changed */
+
+  if (!trie->valid)
+    {
+      lpm_reset(trie, sizeof(in_addr_t));
+      (void)net_foreachroute_ipv4(lpm_ipv4_add, NULL);
+      trie->valid = true;
+
+      if (trie->overflow)
+        {
+          nwarn("WARNING: IPv4 routing table too large for the trie\n");
+        }
+    }
+
+  /* If the routing table does not fit into the trie, search it */
+
+  if (trie->overflow)
+    {
+      struct lpm_ipv4_match_s match;
+
+      net_ipv4addr_copy(match.target, target);
+      match.plen = -1;
+
+      (void)net_foreachroute_ipv4(lpm_ipv4_match, &match);
+      if (match.plen < 0)
+        {
+          return -ENOENT;
+        }
+
+      memcpy(route, &match.route, sizeof(struct net_route_ipv4_s));
+      return OK;
+    }
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  /* Check for a recent lookup of the same address */
+
+  entry = &g_ipv4_lpm.cache[lpm_hash((FAR const uint8_t *)&target,
+                                     sizeof(in_addr_t))];
+  if (entry->valid && net_ipv4addr_cmp(entry->target, target))
+    {
+      ndx = entry->route;
+    }
+  else
+    {
+      ndx = lpm_lookup(trie, (FAR const uint8_t *)&target);
+
+      entry->valid = true;
+      entry->route = ndx;
+      net_ipv4addr_copy(entry->target, target);
+    }
+#else
+  ndx = lpm_lookup(trie, (FAR const uint8_t *)&target);
+#endif
+
+  if (ndx == LPM_NONE)
+    {
+      return -ENOENT;
+    }
+
+  memcpy(route, &g_ipv4_lpm.routes[ndx], sizeof(struct net_route_ipv4_s));
+  return OK;
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv6
+ *
+ * Description:
+ *   Find the route with the longest prefix that matches the target
+ *   address.
+ *
+ * Parameters:
+ *   target - An IPv6 address on a remote network to use in the lookup.
+ *   route  - The location to return a copy of the matching route.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if no route
+ *   matches the target address.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      FAR struct net_route_ipv6_s *route)
+{
+  FAR struct lpm_trie_s *trie = &g_ipv6_lpm.trie;
+  uint8_t ndx;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  FAR struct lpm_ipv6_cache_s *entry;
+#endif
+
+  /* (Re-)build the trie if the routing table has changed */
+
+  if (!trie->valid)
+    {
+      lpm_reset(trie, sizeof(net_ipv6addr_t));
+      (void)net_foreachroute_ipv6(lpm_ipv6_add, NULL);
+      trie->valid = true;
+
+      if (trie->overflow)
+        {
+          nwarn("WARNING: IPv6 routing table too large for the trie\n");
+        }
+    }
+
+  /* If the routing table does not fit into the trie, search it */
+
+  if (trie->overflow)
+    {
+      struct lpm_ipv6_match_s match;
+
+      net_ipv6addr_copy(match.target, target);
+      match.plen = -1;
+
+      (void)net_foreachroute_ipv6(lpm_ipv6_match, &match);
+      if (match.plen < 0)
+        {
+          return -ENOENT;
+        }
+
+      memcpy(route, &match.route, sizeof(struct net_route_ipv6_s));
+      return OK;
+    }
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  /* Check for a recent lookup of the same address */
+
+  entry = &g_ipv6_lpm.cache[lpm_hash((FAR const uint8_t *)target,
+                                     sizeof(net_ipv6addr_t))];
+  if (entry->valid && net_ipv6addr_cmp(entry->target, target))
+    {
+      ndx = entry->route;
+    }
+  else
+    {
+      ndx = lpm_lookup(trie, (FAR const uint8_t *)target);
+
+      entry->valid = true;
+      entry->route = ndx;
+      net_ipv6addr_copy(entry->target, target);
+    }
+#else
+  ndx = lpm_lookup(trie, (FAR const uint8_t *)target);
+#endif
+
+  if (ndx == LPM_NONE)
+    {
+      return -ENOENT;
+    }
+
+  memcpy(route, &g_ipv6_lpm.routes[ndx], sizeof(struct net_route_ipv6_s));
+  return OK;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: net_flushlpm_ipv4 and net_flushlpm_ipv6
+ *
+ * Description:
+ *   Discard the lookup trie and the cached lookups.  This must be called
+ *   whenever the routing table is modified.
+ *
+ * Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void net_flushlpm_ipv4(void)
+{
+  net_lock();
+  g_ipv4_lpm.trie.valid = false;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv4_lpm.cache, 0, sizeof(g_ipv4_lpm.cache));
+#endif
+  net_unlock();
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void net_flushlpm_ipv6(void)
+{
+  net_lock();
+  g_ipv6_lpm.trie.valid = false;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv6_lpm.cache, 0, sizeof(g_ipv6_lpm.cache));
+#endif
+  net_unlock();
+}
+#endif
+
+#endif /* CONFIG_NET && CONFIG_NET_ROUTE && CONFIG_ROUTE_LPM */
@@ -49,6 +49,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -57,7 +58,7 @@
  * Pre-processor defintions
  ****************************************************************************/
 
-#ifdef CONFIG_ROUTE_IPv6_CACHEROUTE
+#ifdef CONFIG_ROUTE_IPv4_CACHEROUTE
 #  define IPv4_ROUTER entry.router
 #else
 #  define IPv4_ROUTER router
@@ -211,7 +212,11 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 #ifdef CONFIG_NET_IPv4
 int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 {
+#ifdef CONFIG_ROUTE_LPM
+  struct net_route_ipv4_s route;
+#else
   struct route_ipv4_match_s match;
+#endif
   int ret;
 
   /* Do not route the special broadcast IP address */
@@ -221,6 +226,18 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Find the route with the longest prefix that matches the target */
+
+  ret = net_lpmroute_ipv4(target, &route);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  net_ipv4addr_copy(*router, route.router);
+  return OK;
+#else
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -263,6 +280,7 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 
   net_ipv4addr_copy(*router, match.IPv4_ROUTER);
   return OK;
+#endif /* CONFIG_ROUTE_LPM */
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -286,7 +304,11 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 #ifdef CONFIG_NET_IPv6
 int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 {
+#ifdef CONFIG_ROUTE_LPM
+  struct net_route_ipv6_s route;
+#else
   struct route_ipv6_match_s match;
+#endif
   int ret;
 
   /* Do not route to any the special IPv6 multicast addresses */
@@ -296,6 +318,18 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Find the route with the longest prefix that matches the target */
+
+  ret = net_lpmroute_ipv6(target, &route);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  net_ipv6addr_copy(router, route.router);
+  return OK;
+#else
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -338,6 +372,7 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 
   net_ipv6addr_copy(router, match.IPv6_ROUTER);
   return OK;
+#endif /* CONFIG_ROUTE_LPM */
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -42,12 +42,14 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <netinet/in.h>
 #include <sys/time.h>
 #include <debug.h>
 #include <assert.h>
 #include <errno.h>
 
 #include "socket/socket.h"
+#include "tcp/tcp.h"
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 
@@ -99,6 +101,21 @@
 int psock_getsockopt(FAR struct socket *psock, int level, int option,
                      FAR void *value, FAR socklen_t *value_len)
 {
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_DELAYED_ACK)
+  /* Options at the IPPROTO_TCP level are handled by the TCP layer */
+
+  if (level == IPPROTO_TCP && psock->s_type == SOCK_STREAM &&
+      (psock->s_domain == PF_INET || psock->s_domain == PF_INET6))
+    {
+      if (!value || !value_len)
+        {
+          return -EINVAL;
+        }
+
+      return tcp_getsockopt(psock, option, value, value_len);
+    }
+#endif
+
   /* Verify that the socket option if valid (but might not be supported ) */
 
   if (!_SO_GETVALID(option) || !value || !value_len)
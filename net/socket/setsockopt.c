@@ -43,6 +43,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <netinet/in.h>
 #include <sys/time.h>
 #include <errno.h>
 #include <debug.h>
@@ -52,6 +53,7 @@
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
+#include "tcp/tcp.h"
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 
@@ -109,6 +111,21 @@
 int psock_setsockopt(FAR struct socket *psock, int level, int option,
                      FAR const void *value, socklen_t value_len)
 {
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_DELAYED_ACK)
+  /* Options at the IPPROTO_TCP level are handled by the TCP layer */
+
+  if (level == IPPROTO_TCP && psock->s_type == SOCK_STREAM &&
+      (psock->s_domain == PF_INET || psock->s_domain == PF_INET6))
+    {
+      if (!value)
+        {
+          return -EINVAL;
+        }
+
+      return tcp_setsockopt(psock, option, value, value_len);
+    }
+#endif
+
   /* Verify that the socket option if valid (but might not be supported ) */
 
   if (!_SO_SETVALID(option) || !value)
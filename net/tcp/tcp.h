@@ -45,6 +45,8 @@
 #include <sys/types.h>
 #include <queue.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
 
@@ -96,6 +98,65 @@
 #endif
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* Congestion control definitions */
+
+#  define TCP_CC_DUPTHRESH  3     /* Duplicate ACKs that trigger fast rexmit */
+#  define TCP_CC_RECOVERY   0x01  /* Bit 0: In fast recovery */
+#endif
+
+/* The amount of data that may be in flight:  The peer window, limited by
+ * the congestion window if congestion control is enabled.
+ */
+
+#ifdef CONFIG_NET_TCP_CC
+#  define TCP_WNDSIZE(conn) tcp_cc_wndsize(conn)
+#else
+#  define TCP_WNDSIZE(conn) ((conn)->winsize)
+#endif
+
+/* Options negotiated in the SYN exchange (tcp_conn_s tcpopts field).  On
+ * an active open, these hold the options offered in our SYN until the
+ * SYNACK is received.
+ */
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+#  define HAVE_TCP_OPTIONS  1
+#  define TCP_NEGO_WSCALE   0x01  /* Bit 0: Window scaling in use */
+#  define TCP_NEGO_SACK     0x02  /* Bit 1: Selective ACKs permitted */
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* The number of SACK blocks that are remembered and reported.  Four blocks
+ * is the most that fit into the option space of a segment without
+ * timestamps.
+ */
+
+#  define TCP_SACK_NBLOCKS  4
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+/* Delayed ACK state (tcp_conn_s dlyack field) */
+
+#  define TCP_DLYACK_PENDING 0x01 /* Bit 0: ACK of received data is delayed */
+#  define TCP_DLYACK_QUICK   0x02 /* Bit 1: Delayed ACKs disabled (TCP_QUICKACK) */
+
+/* The longest time that an ACK may be delayed, in clock ticks */
+
+#  if MSEC2TICK(CONFIG_NET_TCP_DELAYED_ACK_TIME) > 0
+#    define TCP_DLYACK_TICKS MSEC2TICK(CONFIG_NET_TCP_DELAYED_ACK_TIME)
+#  else
+#    define TCP_DLYACK_TICKS 1
+#  endif
+#endif
+
+/* Sequence number comparisons that are safe across wrap-around */
+
+#define TCP_SEQ_LT(a,b)     ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LTE(a,b)    ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a,b)     ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GTE(a,b)    ((int32_t)((a) - (b)) >= 0)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -113,6 +174,31 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_cc_ops_s;      /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+/* A segment that arrived ahead of rcvseq and is held until the gap before
+ * it is filled.
+ */
+
+struct tcp_ofoseg_s
+{
+  uint32_t seqno;         /* Sequence number of the first byte */
+  FAR struct iob_s *iob;  /* The segment data */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* One SACK block:  The sequence numbers of the first byte and of the byte
+ * following the last byte of a contiguous range of data.
+ */
+
+struct tcp_sack_s
+{
+  uint32_t left;          /* First sequence number of the block */
+  uint32_t right;         /* Sequence number following the block */
+};
+#endif
 
 struct tcp_conn_s
 {
@@ -134,12 +220,27 @@ struct tcp_conn_s
   uint8_t  timer;         /* The retransmission timer (units: half-seconds) */
   uint8_t  nrtx;          /* The number of retransmissions for the last
                            * segment sent */
+#ifdef HAVE_TCP_OPTIONS
+  uint8_t  tcpopts;       /* Negotiated TCP options.  See TCP_NEGO_* */
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint8_t  snd_scale;     /* Shift applied to the peer's window */
+  uint8_t  rcv_scale;     /* Shift applied to our advertised window */
+#endif
   uint16_t lport;         /* The local TCP port, in network byte order */
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current (scaled) window size of the
+                           * connection */
+  uint32_t rcv_adv;       /* Right edge of the last window that we
+                           * advertised */
+#else
   uint16_t winsize;       /* Current window size of the connection */
-#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+#endif
+#if defined(CONFIG_NET_TCP_WRITE_BUFFERS) || \
+    defined(CONFIG_NET_TCP_WINDOW_SCALE)
   uint32_t unacked;       /* Number bytes sent but not yet ACKed */
 #else
   uint16_t unacked;       /* Number bytes sent but not yet ACKed */
@@ -162,6 +263,31 @@ struct tcp_conn_s
   struct iob_queue_s readahead;   /* Read-ahead buffering */
 #endif
 
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  /* Out-of-order segment queue.
+   *
+   *   ofosegs  - Segments received ahead of rcvseq, in ascending sequence
+   *              number order and without overlap.
+   *   nofosegs - The number of valid entries in ofosegs[].
+   */
+
+  struct tcp_ofoseg_s ofosegs[CONFIG_NET_TCP_OFOSEGS];
+  uint8_t nofosegs;       /* Number of out-of-order segments held */
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* Delayed ACK
+   *
+   *   dlywdog - Fires when a pending ACK may not be delayed any longer.
+   *   dlytime - The time at which the pending ACK was delayed.
+   *   dlyack  - Delayed ACK state.  See the TCP_DLYACK_* definitions.
+   */
+
+  struct wdog_s dlywdog;  /* Delayed ACK timer */
+  systime_t dlytime;      /* Start of the delay */
+  uint8_t dlyack;         /* Delayed ACK state */
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Write buffering
    *
@@ -181,6 +307,63 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control
+   *
+   *   cc       - The congestion control algorithm used by the connection
+   *   cwnd     - Congestion window.  The amount of un-ACKed data in flight
+   *              is limited to the smaller of cwnd and the peer window.
+   *   ssthresh - Slow start threshold.  cwnd grows exponentially below
+   *              ssthresh and linearly (or cubically) above it.
+   *   cwndcnt  - Bytes ACKed since cwnd was last increased in congestion
+   *              avoidance.
+   *   lastack  - The highest ACK number received from the peer.
+   *   recover  - NewReno recovery point:  The highest sequence number sent
+   *              when fast recovery was last entered.
+   *   sndwnd   - The peer window size of the last ACK (duplicate ACK
+   *              detection).
+   *   dupacks  - The number of consecutive duplicate ACKs received.
+   *   ccflags  - See TCP_CC_* definitions.
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t   cwnd;        /* Congestion window (bytes) */
+  uint32_t   ssthresh;    /* Slow start threshold (bytes) */
+  uint32_t   cwndcnt;     /* Bytes ACKed toward the next cwnd increase */
+  uint32_t   lastack;     /* Highest ACK number received */
+  uint32_t   recover;     /* Highest sequence number sent at last loss */
+  uint32_t   sndwnd;      /* Peer window of the last ACK */
+  uint8_t    dupacks;     /* Number of consecutive duplicate ACKs */
+  uint8_t    ccflags;     /* Congestion control state flags */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  uint32_t   cubic_wmax;  /* cwnd before the last reduction (bytes) */
+  uint32_t   cubic_west;  /* Reno-friendly cwnd estimate (bytes) */
+  uint32_t   cubic_k;     /* Time to grow back to cubic_wmax (msec) */
+  uint32_t   cubic_epoch; /* Start of the current growth epoch (ticks) */
+  uint32_t   cubic_origin; /* Window at which the cubic curve is
+                            * centered (bytes) */
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Selective acknowledgment (RFC 2018)
+   *
+   *   rcvsack  - Blocks of out-of-order data held by the receiver, most
+   *              recently received first.  These are reported to the peer
+   *              in pure ACKs.
+   *   sndsack  - The sender's scoreboard:  Data that the peer has reported
+   *              as received, in ascending sequence number order.
+   *   sacknxt  - The first sequence number that has not yet been
+   *              retransmitted in the current recovery episode.
+   */
+
+  struct tcp_sack_s rcvsack[TCP_SACK_NBLOCKS];
+  struct tcp_sack_s sndsack[TCP_SACK_NBLOCKS];
+  uint32_t   sacknxt;     /* Next hole byte to retransmit */
+  uint8_t    nrcvsack;    /* Number of valid entries in rcvsack[] */
+  uint8_t    nsndsack;    /* Number of valid entries in sndsack[] */
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -242,6 +425,25 @@ struct tcp_conn_s
   int (*accept)(FAR struct tcp_conn_s *listener, FAR struct tcp_conn_s *conn);
 };
 
+/* This structure describes one congestion control algorithm.
+ *
+ *   init       - Initialize algorithm-specific state when the connection
+ *                is established.
+ *   cong_avoid - Grow cwnd on receipt of an ACK for 'acked' new bytes.
+ *   ssthresh   - Return the new slow start threshold on a congestion
+ *                event (fast retransmit or retransmission timeout).
+ */
+
+#ifdef CONFIG_NET_TCP_CC
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 /* This structure supports TCP write buffering */
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -299,6 +501,15 @@ extern "C"
 EXTERN struct net_driver_s *g_netdevices;
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* Congestion control algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1066,6 +1277,232 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 #endif
 
+/****************************************************************************
+ * Name: tcp_ofo_insert
+ *
+ * Description:
+ *   Retain a segment that arrived ahead of rcvseq in the out-of-order
+ *   queue.  Data that is already held is not duplicated and data beyond
+ *   the advertised receive window is discarded.  The segment is
+ *   silently dropped if the per-connection (CONFIG_NET_TCP_OFOSEGS) or the
+ *   global (CONFIG_NET_TCP_OFOIOBS) limit would be exceeded or if no I/O
+ *   buffer is available without waiting.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   seqno  - The sequence number of the first byte of the segment
+ *   buffer - The segment payload
+ *   buflen - The length of the segment payload
+ *   wndend - The right edge of the advertised receive window
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+void tcp_ofo_insert(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                    FAR uint8_t *buffer, uint16_t buflen, uint32_t wndend);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ofo_deliver
+ *
+ * Description:
+ *   After rcvseq has advanced, move the segments that are now in sequence
+ *   from the out-of-order queue to the read-ahead buffers and advance
+ *   rcvseq past them.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The number of bytes delivered to the read-ahead buffers.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+uint32_t tcp_ofo_deliver(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_ofo_free
+ *
+ * Description:
+ *   Release all segments in the out-of-order queue of a connection.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+void tcp_ofo_free(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_dlyack_defer
+ *
+ * Description:
+ *   Called when received data is about to be ACKed and there is no
+ *   outgoing data to carry the ACK.  Decide whether the ACK may be delayed
+ *   and, if so, start the delayed ACK timer.  The ACK of every second
+ *   segment is never delayed, nor is the ACK of data that is received
+ *   while there is a gap in the sequence space.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   true if the ACK is delayed and should not be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+bool tcp_dlyack_defer(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_dlyack_sent
+ *
+ * Description:
+ *   Called whenever a segment carrying an ACK is sent on the connection.
+ *   That segment acknowledges all received data so any pending delayed ACK
+ *   is cancelled.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure holding the outgoing segment
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+void tcp_dlyack_sent(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_dlyack_expired
+ *
+ * Description:
+ *   Return true if there is a pending delayed ACK that must be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+bool tcp_dlyack_expired(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_dlyack_cancel
+ *
+ * Description:
+ *   Discard any pending delayed ACK and stop the delayed ACK timer.  Used
+ *   when the connection is freed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+void tcp_dlyack_cancel(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_gso_sndsize
+ *
+ * Description:
+ *   Return the largest amount of data that may be sent in one segment.
+ *   This is the MSS unless the device accepts TCP super-segments; then it
+ *   is the largest multiple of the MSS that fits into d_gsomax.
+ *
+ * Input Parameters:
+ *   dev  - The device that will send the segment
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The largest amount of data to send in one segment.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+uint16_t tcp_gso_sndsize(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_gso_sndsize(dev,conn) ((conn)->mss)
+#endif
+
+/****************************************************************************
+ * Name: tcp_gso_wndtrim
+ *
+ * Description:
+ *   Trim the amount of data in a super-segment to whole segments that fit
+ *   into the part of the send window that is not already in flight.
+ *
+ * Input Parameters:
+ *   conn     - The TCP connection
+ *   sndlen   - The amount of data to be sent
+ *   inflight - The amount of data sent but not yet ACKed
+ *
+ * Returned Value:
+ *   The trimmed amount of data.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+uint32_t tcp_gso_wndtrim(FAR struct tcp_conn_s *conn, uint32_t sndlen,
+                         uint32_t inflight);
+#else
+#  define tcp_gso_wndtrim(conn,sndlen,inflight) (sndlen)
+#endif
+
+/****************************************************************************
+ * Name: tcp_setsockopt / tcp_getsockopt
+ *
+ * Description:
+ *   Set or get an option at the IPPROTO_TCP level.  These are called from
+ *   psock_setsockopt() and psock_getsockopt() which describe the parameters
+ *   and the returned value.  Only TCP_QUICKACK is supported:  A non-zero
+ *   value disables delayed ACKs on the socket.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -ENOPROTOOPT
+ *   is returned for any option that is not supported.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_TCP_DELAYED_ACK)
+int tcp_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+int tcp_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len);
+#endif
+
 /****************************************************************************
  * Name: tcp_backlogcreate
  *
@@ -1380,6 +1817,260 @@ void tcp_wrbuffer_dump(FAR const char *msg, FAR struct tcp_wrbuffer_s *wrb,
 #endif
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion control state on receipt of an ACK.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection
+ *   ackno   - The acknowledgement number of the incoming segment
+ *   wnd     - The window advertised by the incoming segment
+ *   pureack - True if the incoming segment carries no data
+ *
+ * Returned Value:
+ *   True if the first unacknowledged segment must be retransmitted now
+ *   (fast retransmit or a NewReno partial ACK).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, uint32_t wnd,
+                bool pureack);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control state on a retransmission timeout.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_wndsize
+ *
+ * Description:
+ *   Return the amount of data that may be in flight:  The smaller of the
+ *   congestion window and the peer window.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_wndsize(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of new bytes that may be sent now:  The smaller of
+ *   the congestion window and the peer window, less the data in flight.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_slowstart
+ *
+ * Description:
+ *   Helper for congestion control algorithms:  Grow cwnd by the number of
+ *   bytes ACKed (but by no more than one MSS per ACK) while cwnd is below
+ *   ssthresh.
+ *
+ * Returned Value:
+ *   The number of ACKed bytes left over for congestion avoidance.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_slowstart(FAR struct tcp_conn_s *conn, uint32_t acked);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_halfflight
+ *
+ * Description:
+ *   Helper for congestion control algorithms:  Return the standard slow
+ *   start threshold after a congestion event, half of the data in flight
+ *   but no less than two segments (RFC 5681, equation 4).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_halfflight(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Merge the blocks of a SACK option received from the peer into the
+ *   sender's scoreboard and discard everything that is now cumulatively
+ *   acknowledged.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackno  - The acknowledgement number of the incoming segment
+ *   opt    - The SACK option, beginning with the option kind
+ *   optlen - The length of the SACK option
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_input(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                    FAR const uint8_t *opt, unsigned int optlen);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the next range of data that must be retransmitted during loss
+ *   recovery:  The first byte at or above both seqno and sacknxt that has
+ *   not been selectively acknowledged and lies below the highest SACKed
+ *   byte.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   seqno - On input, the current cumulative ACK.  On output, the start of
+ *           the hole.
+ *   len   - On input, the maximum length to retransmit.  On output, the
+ *           length of the retransmission, clipped to the hole.
+ *
+ * Returned Value:
+ *   True if there is a hole to repair.  If the scoreboard is empty, seqno
+ *   and len are not modified and true is returned so that the caller falls
+ *   back to retransmitting the first unacknowledged segment.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn, FAR uint32_t *seqno,
+                       FAR uint32_t *len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_pipe
+ *
+ * Description:
+ *   Estimate the number of bytes still in flight during loss recovery
+ *   (the "pipe" of RFC 6675):  Data above the highest SACKed byte plus the
+ *   holes below it that have already been retransmitted.  Holes that have
+ *   not been retransmitted are presumed lost and SACKed data has left the
+ *   network.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   ackno - The current cumulative ACK
+ *
+ * Returned Value:
+ *   The estimated number of bytes in flight.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+uint32_t tcp_sack_pipe(FAR struct tcp_conn_s *conn, uint32_t ackno);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_rcvupdate
+ *
+ * Description:
+ *   Record that out-of-order data has been received and retained so that
+ *   it will be reported to the peer in the next pure ACK.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   seqno - The sequence number of the first byte retained
+ *   len   - The number of bytes retained
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_rcvupdate(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                        uint32_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_options
+ *
+ * Description:
+ *   Format the SACK option for an outgoing ACK.  Blocks that have since
+ *   been cumulatively acknowledged are discarded first.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   opt  - The location in the TCP header where the option is written
+ *
+ * Returned Value:
+ *   The number of option bytes written (a multiple of four), or zero if
+ *   there is nothing to report.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+unsigned int tcp_sack_options(FAR struct tcp_conn_s *conn,
+                              FAR uint8_t *opt);
+#endif
+
 /****************************************************************************
  * Name: tcp_pollsetup
  *
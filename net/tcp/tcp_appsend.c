@@ -156,7 +156,7 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   else
     {
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
-      DEBUGASSERT(dev->d_sndlen <= conn->mss);
+      DEBUGASSERT(dev->d_sndlen <= tcp_gso_sndsize(dev, conn));
 #else
       /* If d_sndlen > 0, the application has data to be sent. */
 
@@ -175,7 +175,7 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
            * MSS (the minumum of the MSS and the available window).
            */
 
-          DEBUGASSERT(dev->d_sndlen <= conn->mss);
+          DEBUGASSERT(dev->d_sndlen <= tcp_gso_sndsize(dev, conn));
         }
 
       conn->nrtx = 0;
@@ -0,0 +1,413 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_CC)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initial window (RFC 3390):  min(4*MSS, max(2*MSS, 4380 bytes)) */
+
+#define TCP_CC_IW(mss) \
+  ((mss) > 2190 ? 2 * (uint32_t)(mss) : \
+   (mss) > 1095 ? 4380 : 4 * (uint32_t)(mss))
+
+/* The sequence number following the highest byte sent.  Without write
+ * buffers, sndseq is the oldest unacknowledged byte and unacked covers
+ * everything sent after it.
+ */
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+#  define TCP_CC_SNDMAX(conn) ((conn)->sndseq_max)
+#else
+#  define TCP_CC_SNDMAX(conn) \
+  (tcp_getsequence((conn)->sndseq) + (conn)->unacked)
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn);
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static bool tcp_cc_enter_recovery(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* NewReno is the baseline algorithm.  It uses the default ssthresh. */
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",
+  newreno_init,
+  newreno_cong_avoid,
+  tcp_cc_halfflight
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_init
+ *
+ * Description:
+ *   NewReno has no private state.
+ *
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn)
+{
+}
+
+/****************************************************************************
+ * Name: newreno_cong_avoid
+ *
+ * Description:
+ *   Slow start below ssthresh.  Above it, increase cwnd by one MSS each
+ *   time that a full cwnd of data has been ACKed (appropriate byte
+ *   counting, RFC 3465).
+ *
+ ****************************************************************************/
+
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  acked = tcp_cc_slowstart(conn, acked);
+  if (acked == 0)
+    {
+      return;
+    }
+
+  conn->cwndcnt += acked;
+  if (conn->cwndcnt >= conn->cwnd)
+    {
+      conn->cwndcnt -= conn->cwnd;
+      conn->cwnd    += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_enter_recovery
+ *
+ * Description:
+ *   Enter fast recovery on the third duplicate ACK.  Returns true if the
+ *   first unacknowledged segment must be retransmitted.
+ *
+ ****************************************************************************/
+
+static bool tcp_cc_enter_recovery(FAR struct tcp_conn_s *conn)
+{
+  /* Do not reduce the window more than once for losses in the same window
+   * of data (RFC 6582, section 3.2, step 2).
+   */
+
+  if (!TCP_SEQ_GT(conn->lastack, conn->recover))
+    {
+      return false;
+    }
+
+  conn->ssthresh = conn->cc->ssthresh(conn);
+  conn->cwnd     = conn->ssthresh + TCP_CC_DUPTHRESH * (uint32_t)conn->mss;
+  conn->cwndcnt  = 0;
+  conn->recover  = TCP_CC_SNDMAX(conn);
+  conn->ccflags |= TCP_CC_RECOVERY;
+#ifdef CONFIG_NET_TCP_SACK
+  conn->sacknxt  = conn->lastack;
+#endif
+
+  ninfo("Fast retransmit: cwnd=%u ssthresh=%u recover=%u\n",
+        conn->cwnd, conn->ssthresh, conn->recover);
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t isn = tcp_getsequence(conn->sndseq);
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  conn->cc       = &g_tcp_cc_cubic;
+#else
+  conn->cc       = &g_tcp_cc_newreno;
+#endif
+  conn->cwnd     = TCP_CC_IW(conn->mss);
+  conn->ssthresh = UINT32_MAX;
+  conn->cwndcnt  = 0;
+  conn->lastack  = isn;
+  conn->recover  = isn - 1;
+  conn->sndwnd   = conn->winsize;
+  conn->dupacks  = 0;
+  conn->ccflags  = 0;
+#ifdef CONFIG_NET_TCP_SACK
+  conn->sacknxt  = isn;
+  conn->nsndsack = 0;
+#endif
+
+  conn->cc->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion control state on receipt of an ACK.  Returns
+ *   true if the first unacknowledged segment must be retransmitted now.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, uint32_t wnd,
+                bool pureack)
+{
+  uint32_t acked;
+  uint32_t lastwnd;
+
+  lastwnd      = conn->sndwnd;
+  conn->sndwnd = wnd;
+
+  if (TCP_SEQ_GT(ackno, conn->lastack))
+    {
+      /* New data has been ACKed */
+
+      acked         = ackno - conn->lastack;
+      conn->lastack = ackno;
+      conn->dupacks = 0;
+
+      if ((conn->ccflags & TCP_CC_RECOVERY) != 0)
+        {
+          if (TCP_SEQ_GTE(ackno, conn->recover))
+            {
+              /* Full ACK:  Deflate the window and leave fast recovery */
+
+              conn->cwnd     = conn->ssthresh;
+              conn->ccflags &= ~TCP_CC_RECOVERY;
+              ninfo("Recovered: cwnd=%u\n", conn->cwnd);
+              return false;
+            }
+
+          /* Partial ACK:  The next segment was also lost.  Deflate the
+           * window by the amount ACKed, add back one MSS, and retransmit
+           * (RFC 6582, section 3.2, step 5).
+           */
+
+          conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+          conn->cwnd += conn->mss;
+          return true;
+        }
+
+      conn->cc->cong_avoid(conn, acked);
+      return false;
+    }
+
+  /* A duplicate ACK is a pure ACK that does not advance the ACK number or
+   * change the window while data is outstanding (RFC 5681, section 2).
+   */
+
+  if (!pureack || ackno != conn->lastack || wnd != lastwnd ||
+      conn->unacked == 0)
+    {
+      return false;
+    }
+
+  if ((conn->ccflags & TCP_CC_RECOVERY) != 0)
+    {
+      /* Each additional duplicate ACK means that another segment has left
+       * the network.  Inflate the window to allow a new segment out.
+       */
+
+      conn->cwnd += conn->mss;
+      return false;
+    }
+
+  if (++conn->dupacks == TCP_CC_DUPTHRESH)
+    {
+      return tcp_cc_enter_recovery(conn);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control state on a retransmission timeout:
+ *   Reduce ssthresh and restart from a one segment window (RFC 5681,
+ *   section 3.1).
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cc == NULL)
+    {
+      return;
+    }
+
+  conn->ssthresh = conn->cc->ssthresh(conn);
+  conn->cwnd     = conn->mss;
+  conn->cwndcnt  = 0;
+  conn->dupacks  = 0;
+  conn->recover  = TCP_CC_SNDMAX(conn);
+  conn->ccflags &= ~TCP_CC_RECOVERY;
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Everything is resent after a timeout.  The receiver may also have
+   * discarded data that it SACKed, so the scoreboard is no longer trusted
+   * (RFC 2018, section 8).
+   */
+
+  conn->sacknxt  = conn->lastack;
+  conn->nsndsack = 0;
+#endif
+
+  ninfo("RTO: cwnd=%u ssthresh=%u\n", conn->cwnd, conn->ssthresh);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_wndsize
+ *
+ * Description:
+ *   Return the smaller of the congestion window and the peer window.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_wndsize(FAR struct tcp_conn_s *conn)
+{
+  uint32_t wnd = conn->winsize;
+
+  if (conn->cc != NULL && conn->cwnd < wnd)
+    {
+      wnd = conn->cwnd;
+    }
+
+  return wnd;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of new bytes that may be sent now.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn)
+{
+  uint32_t wnd = tcp_cc_wndsize(conn);
+
+  return wnd > conn->unacked ? wnd - conn->unacked : 0;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_slowstart
+ *
+ * Description:
+ *   Grow cwnd by the number of bytes ACKed (but by no more than one MSS
+ *   per ACK) while cwnd is below ssthresh.  Returns the number of ACKed
+ *   bytes left over for congestion avoidance.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_slowstart(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr;
+
+  if (conn->cwnd >= conn->ssthresh)
+    {
+      return acked;
+    }
+
+  incr = acked > conn->mss ? conn->mss : acked;
+  if (conn->cwnd + incr > conn->ssthresh)
+    {
+      incr = conn->ssthresh - conn->cwnd;
+    }
+
+  conn->cwnd += incr;
+  return acked - incr;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_halfflight
+ *
+ * Description:
+ *   The standard slow start threshold after a congestion event:  Half of
+ *   the data in flight, but no less than two segments.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_halfflight(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh = conn->unacked / 2;
+
+  if (ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  return ssthresh;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC */
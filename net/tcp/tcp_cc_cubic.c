@@ -0,0 +1,285 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_CC_CUBIC)
+
+#include <stdint.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CUBIC parameters (RFC 8312):  C = 0.4 and beta = 0.7 */
+
+#define CUBIC_BETA_NUM    7
+#define CUBIC_BETA_DEN    10
+
+/* K = cbrt(W_max * (1 - beta) / C) seconds.  With the window reduction
+ * expressed in segments and K in milliseconds:
+ *
+ *   K = cbrt(segments / 0.4 * 10^9) = cbrt(segments * 2500000000)
+ */
+
+#define CUBIC_K_SCALE     2500000000ull
+
+/* W_cubic(t) = C * (t - K)^3 + W_max.  With t and K in milliseconds and
+ * the result in bytes:
+ *
+ *   C * (t - K)^3 * mss / 10^9 = (t - K)^3 * mss * 4 / 10^10
+ */
+
+#define CUBIC_C_NUM       4
+#define CUBIC_C_DEN       10000000000ll
+
+/* Limit |t - K| so that the cube cannot overflow (100 seconds) */
+
+#define CUBIC_MAX_DELTA   100000
+
+/* The Reno-friendly estimate grows by 3 * (1 - beta) / (1 + beta), about
+ * 0.53 segments, per window of data ACKed.
+ */
+
+#define CUBIC_WEST_NUM    53
+#define CUBIC_WEST_DEN    100
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",
+  cubic_init,
+  cubic_cong_avoid,
+  cubic_ssthresh
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root (Hacker's Delight, icbrt64).
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cubic_wmax   = 0;
+  conn->cubic_west   = 0;
+  conn->cubic_k      = 0;
+  conn->cubic_epoch  = 0;
+  conn->cubic_origin = 0;
+}
+
+/****************************************************************************
+ * Name: cubic_cong_avoid
+ *
+ * Description:
+ *   Slow start below ssthresh.  Above it, grow cwnd toward the cubic
+ *   function of the time since the start of the current epoch (the first
+ *   ACK after the last congestion event), but never slower than the
+ *   Reno-friendly estimate.
+ *
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  systime_t now;
+  int64_t delta;
+  int64_t target;
+  uint32_t incr;
+
+  acked = tcp_cc_slowstart(conn, acked);
+  if (acked == 0)
+    {
+      return;
+    }
+
+  /* Start a new epoch? */
+
+  now = clock_systimer();
+  if (conn->cubic_epoch == 0)
+    {
+      conn->cubic_epoch = (uint32_t)now | 1;
+      conn->cwndcnt     = 0;
+      conn->cubic_west  = conn->cwnd;
+
+      if (conn->cwnd < conn->cubic_wmax)
+        {
+          conn->cubic_k      =
+            cubic_cbrt((uint64_t)(conn->cubic_wmax - conn->cwnd) *
+                       CUBIC_K_SCALE / conn->mss);
+          conn->cubic_origin = conn->cubic_wmax;
+        }
+      else
+        {
+          conn->cubic_k      = 0;
+          conn->cubic_origin = conn->cwnd;
+        }
+    }
+
+  /* Evaluate the cubic function at the current time */
+
+  delta = (int64_t)TICK2MSEC((uint32_t)now - conn->cubic_epoch) -
+          (int64_t)conn->cubic_k;
+
+  if (delta > CUBIC_MAX_DELTA)
+    {
+      delta = CUBIC_MAX_DELTA;
+    }
+  else if (delta < -CUBIC_MAX_DELTA)
+    {
+      delta = -CUBIC_MAX_DELTA;
+    }
+
+  target = (int64_t)conn->cubic_origin +
+           delta * delta * delta * CUBIC_C_NUM * conn->mss / CUBIC_C_DEN;
+
+  /* The Reno-friendly estimate */
+
+  conn->cwndcnt += acked * CUBIC_WEST_NUM / CUBIC_WEST_DEN;
+  if (conn->cwndcnt >= conn->cwnd)
+    {
+      conn->cwndcnt    -= conn->cwnd;
+      conn->cubic_west += conn->mss;
+    }
+
+  if (target < (int64_t)conn->cubic_west)
+    {
+      target = conn->cubic_west;
+    }
+
+  /* Grow cwnd by (target - cwnd) / cwnd per byte ACKed, but no faster
+   * than slow start.
+   */
+
+  if (target > (int64_t)conn->cwnd)
+    {
+      incr = (uint32_t)((target - conn->cwnd) * acked / conn->cwnd);
+      if (incr > acked)
+        {
+          incr = acked;
+        }
+
+      conn->cwnd += incr;
+    }
+}
+
+/****************************************************************************
+ * Name: cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at the congestion event (reduced further if the
+ *   window is shrinking; fast convergence) and reduce it by beta.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh;
+
+  conn->cubic_epoch = 0;
+
+  if (conn->cwnd < conn->cubic_wmax)
+    {
+      conn->cubic_wmax = (uint32_t)((uint64_t)conn->cwnd *
+                                    (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+                                    (2 * CUBIC_BETA_DEN));
+    }
+  else
+    {
+      conn->cubic_wmax = conn->cwnd;
+    }
+
+  ssthresh = (uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA_NUM /
+                        CUBIC_BETA_DEN);
+  if (ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  return ssthresh;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC_CUBIC */
@@ -714,6 +714,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->tcpstateflags = TCP_ALLOCATED;
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
+#endif
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+      wd_static(&conn->dlywdog);
 #endif
     }
 
@@ -772,6 +775,18 @@ void tcp_free(FAR struct tcp_conn_s *conn)
   iob_free_queue(&conn->readahead);
 #endif
 
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  /* Release any out-of-order segments */
+
+  tcp_ofo_free(conn);
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* Stop the delayed ACK timer */
+
+  tcp_dlyack_cancel(conn);
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Release any write buffers attached to the connection */
 
@@ -1008,6 +1023,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       /* rcvseq should be the seqno from the incoming packet + 1. */
 
       memcpy(conn->rcvseq, tcp->seqno, 4);
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      conn->rcv_adv       = tcp_getsequence(conn->rcvseq);
+#endif
 
 #ifdef CONFIG_NET_TCP_READAHEAD
       /* Initialize the list of TCP read-ahead buffers */
@@ -1246,6 +1264,22 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->sndseq_max = 0;
 #endif
 
+#ifdef HAVE_TCP_OPTIONS
+  /* Offer all of the options that we support in the SYN.  Those that the
+   * peer does not confirm in the SYNACK will be disabled.
+   */
+
+  conn->tcpopts    = 0;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  conn->tcpopts   |= TCP_NEGO_WSCALE;
+  conn->snd_scale  = 0;
+  conn->rcv_scale  = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  conn->tcpopts   |= TCP_NEGO_SACK;
+#endif
+#endif
+
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Initialize the list of TCP read-ahead buffers */
 
@@ -124,6 +124,17 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
           result = tcp_callback(dev, conn, TCP_POLL);
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+          /* Send a delayed ACK that cannot be delayed any longer.  If the
+           * application provided data, the ACK will be carried by it.
+           */
+
+          if (tcp_dlyack_expired(conn))
+            {
+              result |= TCP_SNDACK;
+            }
+#endif
+
           /* Handle the callback response */
 
           tcp_appsend(dev, conn, result);
@@ -0,0 +1,237 @@
+/****************************************************************************
+ * net/tcp/tcp_dlyack.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_DELAYED_ACK)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/tcp.h>
+
+#include "netdev/netdev.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_dlyack_timeout
+ *
+ * Description:
+ *   The delayed ACK timer has expired.  Ask the device driver to poll for
+ *   TX data; the ACK is then sent by tcp_poll().
+ *
+ * Assumptions:
+ *   This function is called from the wdog timer handler which runs in the
+ *   context of the timer interrupt handler.
+ *
+ ****************************************************************************/
+
+static void tcp_dlyack_timeout(int argc, wdparm_t arg, ...)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)arg;
+
+  DEBUGASSERT(argc == 1 && conn != NULL);
+
+  if (conn->dev != NULL)
+    {
+      netdev_txnotify_dev(conn->dev);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_dlyack_defer
+ *
+ * Description:
+ *   Called when received data is about to be ACKed and there is no
+ *   outgoing data to carry the ACK.  Decide whether the ACK may be delayed
+ *   and, if so, start the delayed ACK timer.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   true if the ACK is delayed and should not be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_dlyack_defer(FAR struct tcp_conn_s *conn)
+{
+  /* Delayed ACKs may be disabled on this socket */
+
+  if ((conn->dlyack & TCP_DLYACK_QUICK) != 0)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  /* RFC 5681: Out-of-order data and data that fills a gap in the sequence
+   * space should be ACKed immediately so that the sender learns about the
+   * loss (or the recovery) as soon as possible.
+   */
+
+  if (conn->nofosegs > 0)
+    {
+      return false;
+    }
+#endif
+
+  /* RFC 1122: "...in a stream of full-sized segments there SHOULD be an
+   * ACK for at least every second segment."  If an ACK is already pending,
+   * then send it now.  It covers both segments.
+   */
+
+  if ((conn->dlyack & TCP_DLYACK_PENDING) != 0)
+    {
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.tcp.acksaved++;
+#endif
+      return false;
+    }
+
+  /* Delay the ACK and start the timer that limits the delay */
+
+  conn->dlyack  |= TCP_DLYACK_PENDING;
+  conn->dlytime  = clock_systimer();
+
+  (void)wd_start(&conn->dlywdog, TCP_DLYACK_TICKS, tcp_dlyack_timeout, 1,
+                 (wdparm_t)conn);
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.dlyack++;
+#endif
+  return true;
+}
+
+/****************************************************************************
+ * Name: tcp_dlyack_sent
+ *
+ * Description:
+ *   Called whenever a segment carrying an ACK is sent on the connection.
+ *   That segment acknowledges all received data so any pending delayed ACK
+ *   is cancelled.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure holding the outgoing segment
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_dlyack_sent(FAR struct net_driver_s *dev,
+                     FAR struct tcp_conn_s *conn)
+{
+  if ((conn->dlyack & TCP_DLYACK_PENDING) != 0)
+    {
+#ifdef CONFIG_NET_STATISTICS
+      /* If the ACK was carried by outgoing data, then a pure ACK was saved */
+
+      if (dev->d_sndlen > 0)
+        {
+          g_netstats.tcp.acksaved++;
+        }
+#endif
+
+      tcp_dlyack_cancel(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_dlyack_expired
+ *
+ * Description:
+ *   Return true if there is a pending delayed ACK that must be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_dlyack_expired(FAR struct tcp_conn_s *conn)
+{
+  if ((conn->dlyack & TCP_DLYACK_PENDING) == 0)
+    {
+      return false;
+    }
+
+  /* Send the ACK now if delayed ACKs were disabled after it was delayed */
+
+  return (conn->dlyack & TCP_DLYACK_QUICK) != 0 ||
+         clock_systimer() - conn->dlytime >= TCP_DLYACK_TICKS;
+}
+
+/****************************************************************************
+ * Name: tcp_dlyack_cancel
+ *
+ * Description:
+ *   Discard any pending delayed ACK and stop the delayed ACK timer.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_dlyack_cancel(FAR struct tcp_conn_s *conn)
+{
+  conn->dlyack &= ~TCP_DLYACK_PENDING;
+  (void)wd_cancel(&conn->dlywdog);
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_DELAYED_ACK */
@@ -0,0 +1,159 @@
+/****************************************************************************
+ * net/tcp/tcp_gso.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_GSO)
+
+#include <stdint.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest IP header that precedes the TCP header */
+
+#ifdef CONFIG_NET_IPv6
+#  define TCP_GSO_IPHDRLEN IPv6_HDRLEN
+#else
+#  define TCP_GSO_IPHDRLEN IPv4_HDRLEN
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_gso_sndsize
+ *
+ * Description:
+ *   Return the largest amount of data that may be sent in one segment.
+ *   This is the MSS unless the device accepts TCP super-segments; then it
+ *   is the largest multiple of the MSS that fits into d_gsomax.
+ *
+ * Input Parameters:
+ *   dev  - The device that will send the segment
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The largest amount of data to send in one segment.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+uint16_t tcp_gso_sndsize(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn)
+{
+  unsigned int hdrlen;
+  unsigned int maxlen;
+
+  hdrlen = NET_LL_HDRLEN(dev) + TCP_GSO_IPHDRLEN + TCP_HDRLEN;
+
+  /* Each segment is built by copying the headers over the end of the data
+   * of the segment before it.  So the MSS must be at least as large as the
+   * headers.
+   */
+
+  if (dev->d_gsomax <= hdrlen + conn->mss || conn->mss < hdrlen)
+    {
+      return conn->mss;
+    }
+
+  maxlen = dev->d_gsomax - hdrlen;
+  return maxlen - (maxlen % conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_gso_wndtrim
+ *
+ * Description:
+ *   Trim the amount of data in a super-segment to whole segments that fit
+ *   into the part of the send window (limited by the congestion window)
+ *   that is not already in flight.
+ *
+ * Input Parameters:
+ *   conn     - The TCP connection
+ *   sndlen   - The amount of data to be sent
+ *   inflight - The amount of data sent but not yet ACKed
+ *
+ * Returned Value:
+ *   The trimmed amount of data.  This is never less than one MSS (or
+ *   sndlen, if smaller); the caller's window check then decides if even
+ *   that may be sent.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_gso_wndtrim(FAR struct tcp_conn_s *conn, uint32_t sndlen,
+                         uint32_t inflight)
+{
+  uint32_t avail;
+
+  if (sndlen <= conn->mss)
+    {
+      return sndlen;
+    }
+
+  avail = TCP_WNDSIZE(conn);
+  avail = avail > inflight ? avail - inflight : 0;
+  if (sndlen <= avail)
+    {
+      return sndlen;
+    }
+
+  if (avail < conn->mss)
+    {
+      return conn->mss;
+    }
+
+  return avail - (avail % conn->mss);
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_GSO */
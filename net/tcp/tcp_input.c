@@ -65,6 +65,146 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_option
+ *
+ * Description:
+ *   Parse the options of an incoming TCP segment.  The MSS, window scale,
+ *   and SACK permitted options are only meaningful in a SYN or SYNACK.
+ *   Options that we offered but that are missing from the SYNACK are
+ *   disabled.  SACK blocks are processed in all other segments once SACK
+ *   has been negotiated.
+ *
+ * Parameters:
+ *   dev   - The device driver structure containing the received TCP packet.
+ *   conn  - The TCP connection that the segment belongs to
+ *   tcp   - The TCP header of the received segment
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Return:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_option(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn,
+                             FAR struct tcp_hdr_s *tcp, unsigned int iplen)
+{
+  FAR uint8_t *opts = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  unsigned int optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  bool syn = (tcp->flags & TCP_SYN) != 0;
+#ifdef HAVE_TCP_OPTIONS
+  uint8_t found = 0;
+#endif
+  uint16_t tmp16;
+  unsigned int i;
+  uint8_t opt;
+
+  if ((tcp->tcpoffset & 0xf0) <= 0x50)
+    {
+      optlen = 0;
+    }
+
+  for (i = 0; i < optlen; )
+    {
+      opt = opts[i];
+      if (opt == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          ++i;
+          continue;
+        }
+
+      /* All other options have a length field, so that we easily can skip
+       * past them.  If the length field is invalid, the options are
+       * malformed and we don't process them further.
+       */
+
+      if (i + 1 >= optlen || opts[i + 1] < 2 || i + opts[i + 1] > optlen)
+        {
+          break;
+        }
+
+      if (syn && opt == TCP_OPT_MSS && opts[i + 1] == TCP_OPT_MSS_LEN)
+        {
+          uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+          /* An MSS option with the right option length. */
+
+          tmp16 = ((uint16_t)opts[i + 2] << 8) | (uint16_t)opts[i + 3];
+          conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+        }
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      else if (syn && opt == TCP_OPT_WS && opts[i + 1] == TCP_OPT_WS_LEN)
+        {
+          /* The peer will scale its window by this shift (RFC 7323) */
+
+          conn->snd_scale = opts[i + 2] > TCP_MAX_WS ? TCP_MAX_WS :
+                            opts[i + 2];
+          found          |= TCP_NEGO_WSCALE;
+        }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+      else if (syn && opt == TCP_OPT_SACK_PERM &&
+               opts[i + 1] == TCP_OPT_SACK_PERM_LEN)
+        {
+          found |= TCP_NEGO_SACK;
+        }
+      else if (!syn && opt == TCP_OPT_SACK &&
+               (conn->tcpopts & TCP_NEGO_SACK) != 0 &&
+               (tcp->flags & TCP_ACK) != 0)
+        {
+          tcp_sack_input(conn, tcp_getsequence(tcp->ackno), &opts[i],
+                         opts[i + 1]);
+        }
+#endif
+
+      i += opts[i + 1];
+    }
+
+#ifdef HAVE_TCP_OPTIONS
+  if (syn)
+    {
+      if ((tcp->flags & TCP_ACK) == 0)
+        {
+          /* A SYN:  Accept every option that the peer offered */
+
+          conn->tcpopts = found;
+        }
+      else
+        {
+          /* A SYNACK:  Keep the options that the peer confirmed */
+
+          conn->tcpopts &= found;
+        }
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      /* Window scaling is used in both directions or not at all */
+
+      if ((conn->tcpopts & TCP_NEGO_WSCALE) != 0)
+        {
+          conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+        }
+      else
+        {
+          conn->snd_scale = 0;
+          conn->rcv_scale = 0;
+        }
+#endif
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -90,13 +230,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_hdr_s *tcp;
   FAR struct tcp_conn_s *conn = NULL;
   unsigned int tcpiplen;
-  unsigned int hdrlen;
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
   int      len;
-  int      i;
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -114,15 +251,13 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcpiplen = iplen + TCP_HDRLEN;
 
-  /* Get the size of the link layer header, the IP header, and the TCP header */
-
-  hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
-
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM_OFFLOAD(dev) && tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
+      /* Compute and check the TCP checksum unless the hardware already
+       * did.
+       */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
@@ -226,58 +361,9 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP MSS option and any other options, if present. */
 
-          if ((tcp->tcpoffset & 0xf0) > 0x50)
-            {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we easily
-                       * can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are malformed
-                           * and we don't process them further.
-                           */
-
-                          break;
-                        }
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
-            }
+          tcp_parse_option(dev, conn, tcp, iplen);
 
           /* Our response will be a SYNACK. */
 
@@ -313,6 +399,25 @@ found:
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window field of a SYN segment is never scaled */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_scale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Update the SACK scoreboard before any callbacks see the ACK */
+
+  if ((conn->tcpopts & TCP_NEGO_SACK) != 0 &&
+      (tcp->flags & TCP_SYN) == 0 && (tcp->tcpoffset & 0xf0) > 0x50)
+    {
+      tcp_parse_option(dev, conn, tcp, iplen);
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -384,6 +489,16 @@ found:
 
   dev->d_len -= (len + iplen);
 
+  /* d_appdata points just past a TCP header without options.  If the
+   * segment carries options (SACK blocks, for example), move the payload
+   * down into place.  The options have already been processed.
+   */
+
+  if (len > TCP_HDRLEN && dev->d_len > 0 && (tcp->flags & TCP_SYN) == 0)
+    {
+      memmove(dev->d_appdata, (FAR uint8_t *)tcp + len, dev->d_len);
+    }
+
   /* First, check if the sequence number of the incoming packet is
    * what we're expecting next. If not, we send out an ACK with the
    * correct numbers in, unless we are in the SYN_RCVD state and
@@ -399,6 +514,27 @@ found:
       if ((dev->d_len > 0 || ((tcp->flags & (TCP_SYN | TCP_FIN)) != 0)) &&
           memcmp(tcp->seqno, conn->rcvseq, 4) != 0)
         {
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+          /* Retain plain data that arrived ahead of the expected sequence
+           * number.  The duplicate ACK below tells the peer what is
+           * missing.
+           */
+
+          if (conn->tcpstateflags == TCP_ESTABLISHED && dev->d_len > 0 &&
+              (tcp->flags & (TCP_SYN | TCP_FIN | TCP_URG)) == 0)
+            {
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+              uint32_t wndend = conn->rcv_adv;
+#else
+              uint32_t wndend = tcp_getsequence(conn->rcvseq) +
+                                NET_DEV_RCVWNDO(dev);
+#endif
+
+              tcp_ofo_insert(conn, tcp_getsequence(tcp->seqno),
+                             dev->d_appdata, dev->d_len, wndend);
+            }
+#endif
+
           tcp_send(dev, conn, TCP_ACK, tcpiplen);
           return;
         }
@@ -555,6 +691,9 @@ found:
             tcp_setsequence(conn->sndseq, conn->isn);
             conn->sent          = 0;
             conn->sndseq_max    = 0;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             conn->unacked       = 0;
             flags               = TCP_CONNECTED;
@@ -591,69 +730,25 @@ found:
 
         if ((flags & TCP_ACKDATA) != 0 && (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Parse the TCP MSS option and any other options, if present. */
 
-            if ((tcp->tcpoffset & 0xf0) > 0x50)
-              {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
-              }
+            tcp_parse_option(dev, conn, tcp, iplen);
 
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
 
             net_incr32(conn->rcvseq, 1);
             conn->unacked       = 0;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            conn->rcv_adv       = tcp_getsequence(conn->rcvseq);
+#endif
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -814,9 +909,33 @@ found:
 
             if ((result & TCP_SNDACK) != 0)
               {
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+                /* If there is no outgoing data to carry the ACK, then the
+                 * ACK may be delayed.  It is then sent with the next
+                 * outgoing segment or by tcp_poll() when the delay expires.
+                 */
+
+                if (len > 0 && dev->d_sndlen == 0 && tcp_dlyack_defer(conn))
+                  {
+                    result &= ~TCP_SNDACK;
+                  }
+#endif
+
                 /* Update the sequence number using the saved length */
 
                 net_incr32(conn->rcvseq, len);
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+                /* The new data may have filled the gap before retained
+                 * out-of-order segments.  The ACK sent below covers them
+                 * too.
+                 */
+
+                if (len > 0 && conn->nofosegs > 0)
+                  {
+                    (void)tcp_ofo_deliver(conn);
+                  }
+#endif
               }
 
             /* Send the response, ACKing the data or not, as appropriate */
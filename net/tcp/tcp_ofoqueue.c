@@ -0,0 +1,340 @@
+/****************************************************************************
+ * net/tcp/tcp_ofoqueue.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_OUT_OF_ORDER)
+
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The number of I/O buffers held in the out-of-order queues of all
+ * connections.
+ */
+
+static unsigned int g_tcp_ofo_niobs;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_ofo_niobs
+ *
+ * Description:
+ *   Return the number of I/O buffers in an I/O buffer chain.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_ofo_niobs(FAR struct iob_s *iob)
+{
+  unsigned int niobs = 0;
+
+  for (; iob != NULL; iob = iob->io_flink)
+    {
+      niobs++;
+    }
+
+  return niobs;
+}
+
+/****************************************************************************
+ * Name: tcp_ofo_remove
+ *
+ * Description:
+ *   Remove the segment at index 'ndx' from the out-of-order queue.  The
+ *   I/O buffer chain is freed if 'release' is true; otherwise the caller
+ *   has taken ownership of it.
+ *
+ ****************************************************************************/
+
+static void tcp_ofo_remove(FAR struct tcp_conn_s *conn, int ndx,
+                           bool release)
+{
+  FAR struct tcp_ofoseg_s *seg = &conn->ofosegs[ndx];
+
+  g_tcp_ofo_niobs -= tcp_ofo_niobs(seg->iob);
+  if (release)
+    {
+      iob_free_chain(seg->iob);
+    }
+
+  conn->nofosegs--;
+  memmove(seg, seg + 1,
+          (conn->nofosegs - ndx) * sizeof(struct tcp_ofoseg_s));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_ofo_insert
+ *
+ * Description:
+ *   Retain a segment that arrived ahead of rcvseq.
+ *
+ ****************************************************************************/
+
+void tcp_ofo_insert(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                    FAR uint8_t *buffer, uint16_t buflen, uint32_t wndend)
+{
+  FAR struct tcp_ofoseg_s *segs = conn->ofosegs;
+  FAR struct iob_s *iob;
+  uint32_t rcvseq;
+  uint32_t end;
+  unsigned int niobs;
+  int ret;
+  int i;
+
+  rcvseq = tcp_getsequence(conn->rcvseq);
+  end    = seqno + buflen;
+
+  if (buflen == 0 || !TCP_SEQ_GT(seqno, rcvseq))
+    {
+      return;
+    }
+
+  /* Drop the segment if it starts beyond the advertised window and trim
+   * the part of it that extends beyond the window.
+   */
+
+  if (!TCP_SEQ_LT(seqno, wndend))
+    {
+      ninfo("Beyond window: seqno=%u wndend=%u\n", seqno, wndend);
+      return;
+    }
+
+  if (TCP_SEQ_GT(end, wndend))
+    {
+      end    = wndend;
+      buflen = end - seqno;
+    }
+
+  /* Find the first segment that starts after the new one */
+
+  for (i = 0; i < conn->nofosegs && TCP_SEQ_LTE(segs[i].seqno, seqno); i++)
+    {
+    }
+
+  /* Trim the part of the new data that the preceding segment already
+   * holds.
+   */
+
+  if (i > 0)
+    {
+      uint32_t prevend = segs[i - 1].seqno + segs[i - 1].iob->io_pktlen;
+
+      if (TCP_SEQ_GTE(prevend, end))
+        {
+          /* A duplicate.  Nothing new. */
+
+          return;
+        }
+
+      if (TCP_SEQ_GT(prevend, seqno))
+        {
+          buffer += prevend - seqno;
+          buflen -= prevend - seqno;
+          seqno   = prevend;
+        }
+    }
+
+  /* Discard following segments that the new one covers completely and
+   * trim the new data where it runs into the next one.
+   */
+
+  while (i < conn->nofosegs && TCP_SEQ_LT(segs[i].seqno, end))
+    {
+      if (TCP_SEQ_LTE(segs[i].seqno + segs[i].iob->io_pktlen, end))
+        {
+          tcp_ofo_remove(conn, i, true);
+        }
+      else
+        {
+          end    = segs[i].seqno;
+          buflen = end - seqno;
+          break;
+        }
+    }
+
+  /* Is there room?  When the queue is full, the segment furthest from
+   * rcvseq gives way to one that is closer.
+   */
+
+  if (conn->nofosegs >= CONFIG_NET_TCP_OFOSEGS)
+    {
+      if (i >= conn->nofosegs)
+        {
+          ninfo("Out-of-order queue full\n");
+          return;
+        }
+
+      tcp_ofo_remove(conn, conn->nofosegs - 1, true);
+    }
+
+  /* Copy the data into an I/O buffer chain, without waiting and leaving
+   * the reserved I/O buffers for other uses.
+   */
+
+  iob = iob_tryalloc(true);
+  if (iob == NULL)
+    {
+      return;
+    }
+
+  ret = iob_trycopyin(iob, buffer, buflen, 0, true);
+  if (ret < 0)
+    {
+      iob_free_chain(iob);
+      return;
+    }
+
+  niobs = tcp_ofo_niobs(iob);
+  if (g_tcp_ofo_niobs + niobs > CONFIG_NET_TCP_OFOIOBS)
+    {
+      ninfo("Out-of-order I/O buffer limit reached\n");
+      iob_free_chain(iob);
+      return;
+    }
+
+  g_tcp_ofo_niobs += niobs;
+
+  memmove(&segs[i + 1], &segs[i],
+          (conn->nofosegs - i) * sizeof(struct tcp_ofoseg_s));
+  segs[i].seqno = seqno;
+  segs[i].iob   = iob;
+  conn->nofosegs++;
+
+  ninfo("Queued seqno=%u len=%u rcvseq=%u nsegs=%u\n",
+        seqno, buflen, rcvseq, conn->nofosegs);
+
+#ifdef CONFIG_NET_TCP_SACK
+  tcp_sack_rcvupdate(conn, seqno, buflen);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_ofo_deliver
+ *
+ * Description:
+ *   Move segments that have become contiguous with rcvseq into the
+ *   read-ahead buffers, advancing rcvseq.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_ofo_deliver(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_ofoseg_s *seg = &conn->ofosegs[0];
+  FAR struct iob_s *iob;
+  uint32_t delivered = 0;
+  uint32_t rcvseq;
+  uint32_t trim;
+
+  rcvseq = tcp_getsequence(conn->rcvseq);
+  while (conn->nofosegs > 0 && TCP_SEQ_LTE(seg->seqno, rcvseq))
+    {
+      if (TCP_SEQ_LTE(seg->seqno + seg->iob->io_pktlen, rcvseq))
+        {
+          /* Already received in order */
+
+          tcp_ofo_remove(conn, 0, true);
+          continue;
+        }
+
+      trim = rcvseq - seg->seqno;
+      if (trim > 0)
+        {
+          g_tcp_ofo_niobs -= tcp_ofo_niobs(seg->iob);
+          seg->iob         = iob_trimhead(seg->iob, trim);
+          seg->seqno       = rcvseq;
+          g_tcp_ofo_niobs += tcp_ofo_niobs(seg->iob);
+        }
+
+      iob = seg->iob;
+      if (iob_tryadd_queue(iob, &conn->readahead) < 0)
+        {
+          /* Try again when more data arrives */
+
+          break;
+        }
+
+      rcvseq    += iob->io_pktlen;
+      delivered += iob->io_pktlen;
+      tcp_ofo_remove(conn, 0, false);
+    }
+
+  if (delivered > 0)
+    {
+      ninfo("Delivered %u bytes, rcvseq=%u\n", delivered, rcvseq);
+      tcp_setsequence(conn->rcvseq, rcvseq);
+    }
+
+  return delivered;
+}
+
+/****************************************************************************
+ * Name: tcp_ofo_free
+ *
+ * Description:
+ *   Release all segments in the out-of-order queue of a connection.
+ *
+ ****************************************************************************/
+
+void tcp_ofo_free(FAR struct tcp_conn_s *conn)
+{
+  while (conn->nofosegs > 0)
+    {
+      tcp_ofo_remove(conn, conn->nofosegs - 1, true);
+    }
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_OUT_OF_ORDER */
@@ -0,0 +1,416 @@
+/****************************************************************************
+ * net/tcp/tcp_sack.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_SACK)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_get32
+ *
+ * Description:
+ *   Get a 32-bit sequence number in network order from an option.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_sack_get32(FAR const uint8_t *ptr)
+{
+  return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) |
+         ((uint32_t)ptr[2] << 8)  |  (uint32_t)ptr[3];
+}
+
+/****************************************************************************
+ * Name: tcp_sack_insert
+ *
+ * Description:
+ *   Add one block to the sender's scoreboard, merging it with any blocks
+ *   that it overlaps or touches.  If the scoreboard is full, the block with
+ *   the highest sequence numbers is given up:  Holes at the front of the
+ *   window are the ones that stall the connection.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_insert(FAR struct tcp_conn_s *conn, uint32_t left,
+                            uint32_t right)
+{
+  FAR struct tcp_sack_s *sb = conn->sndsack;
+  int n = conn->nsndsack;
+  int i;
+  int j;
+
+  /* Find the first block that does not end before the new block */
+
+  for (i = 0; i < n && TCP_SEQ_LT(sb[i].right, left); i++)
+    {
+    }
+
+  /* Absorb all of the blocks that overlap or touch the new block */
+
+  for (j = i; j < n && TCP_SEQ_LTE(sb[j].left, right); j++)
+    {
+      if (TCP_SEQ_LT(sb[j].left, left))
+        {
+          left = sb[j].left;
+        }
+
+      if (TCP_SEQ_GT(sb[j].right, right))
+        {
+          right = sb[j].right;
+        }
+    }
+
+  if (j == i)
+    {
+      /* Nothing merged.  Open a slot at index i. */
+
+      if (n >= TCP_SACK_NBLOCKS)
+        {
+          if (i >= n)
+            {
+              return;
+            }
+
+          n--;
+        }
+
+      memmove(&sb[i + 1], &sb[i], (n - i) * sizeof(struct tcp_sack_s));
+      n++;
+    }
+  else if (j > i + 1)
+    {
+      /* Blocks i through j-1 collapse into the single slot at index i */
+
+      memmove(&sb[i + 1], &sb[j], (n - j) * sizeof(struct tcp_sack_s));
+      n -= j - i - 1;
+    }
+
+  sb[i].left     = left;
+  sb[i].right    = right;
+  conn->nsndsack = n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Merge the blocks of a SACK option received from the peer into the
+ *   sender's scoreboard and discard everything that is now cumulatively
+ *   acknowledged.
+ *
+ ****************************************************************************/
+
+void tcp_sack_input(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                    FAR const uint8_t *opt, unsigned int optlen)
+{
+  FAR struct tcp_sack_s *sb = conn->sndsack;
+  unsigned int nblocks;
+  unsigned int i;
+  int n;
+
+  if (optlen >= TCP_OPT_SACK_LEN(1) && ((optlen - 2) & 7) == 0)
+    {
+      nblocks = (optlen - 2) >> 3;
+      for (i = 0, opt += 2; i < nblocks; i++, opt += 8)
+        {
+          uint32_t left  = tcp_sack_get32(opt);
+          uint32_t right = tcp_sack_get32(opt + 4);
+
+          /* Ignore malformed blocks, blocks below the cumulative ACK
+           * (D-SACK, RFC 2883), and blocks for data never sent.
+           */
+
+          if (!TCP_SEQ_LT(left, right) || TCP_SEQ_LTE(right, ackno) ||
+              TCP_SEQ_GT(right, conn->sndseq_max))
+            {
+              continue;
+            }
+
+          ninfo("SACK: %u-%u ackno=%u\n", left, right, ackno);
+          tcp_sack_insert(conn, left, right);
+        }
+    }
+
+  /* Discard blocks that have been cumulatively acknowledged */
+
+  n = conn->nsndsack;
+  for (i = 0; i < n && TCP_SEQ_LTE(sb[i].right, ackno); i++)
+    {
+    }
+
+  if (i > 0)
+    {
+      n -= i;
+      memmove(&sb[0], &sb[i], n * sizeof(struct tcp_sack_s));
+      conn->nsndsack = n;
+    }
+
+  if (n > 0 && TCP_SEQ_LT(sb[0].left, ackno))
+    {
+      sb[0].left = ackno;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the next range of data that must be retransmitted during loss
+ *   recovery.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn, FAR uint32_t *seqno,
+                       FAR uint32_t *len)
+{
+  FAR struct tcp_sack_s *sb = conn->sndsack;
+  uint32_t start;
+  int i;
+
+  if (conn->nsndsack == 0)
+    {
+      return true;
+    }
+
+  start = *seqno;
+  if (TCP_SEQ_GT(conn->sacknxt, start))
+    {
+      start = conn->sacknxt;
+    }
+
+  for (i = 0; i < conn->nsndsack; i++)
+    {
+      if (TCP_SEQ_LT(start, sb[i].left))
+        {
+          uint32_t hole = sb[i].left - start;
+
+          *seqno = start;
+          if (*len > hole)
+            {
+              *len = hole;
+            }
+
+          return true;
+        }
+
+      if (TCP_SEQ_LT(start, sb[i].right))
+        {
+          start = sb[i].right;
+        }
+    }
+
+  /* Every hole below the highest SACKed byte has been retransmitted */
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_pipe
+ *
+ * Description:
+ *   Estimate the number of bytes still in flight during loss recovery.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_sack_pipe(FAR struct tcp_conn_s *conn, uint32_t ackno)
+{
+  FAR struct tcp_sack_s *sb = conn->sndsack;
+  uint32_t start = ackno;
+  uint32_t end;
+  uint32_t pipe = 0;
+  int i;
+
+  /* Count the holes below each SACKed block that have been retransmitted */
+
+  for (i = 0; i < conn->nsndsack; i++)
+    {
+      if (TCP_SEQ_LT(start, sb[i].left) && TCP_SEQ_GT(conn->sacknxt, start))
+        {
+          end   = TCP_SEQ_LT(conn->sacknxt, sb[i].left) ?
+                  conn->sacknxt : sb[i].left;
+          pipe += end - start;
+        }
+
+      if (TCP_SEQ_LT(start, sb[i].right))
+        {
+          start = sb[i].right;
+        }
+    }
+
+  /* Everything sent above the highest SACKed byte is still in flight */
+
+  if (TCP_SEQ_LT(start, conn->sndseq_max))
+    {
+      pipe += conn->sndseq_max - start;
+    }
+
+  return pipe;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_rcvupdate
+ *
+ * Description:
+ *   Record that out-of-order data has been received and retained.  The
+ *   block containing the most recently received data is reported first
+ *   (RFC 2018, section 4).
+ *
+ ****************************************************************************/
+
+void tcp_sack_rcvupdate(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                        uint32_t len)
+{
+  FAR struct tcp_sack_s *sb = conn->rcvsack;
+  uint32_t left  = seqno;
+  uint32_t right = seqno + len;
+  int n = conn->nrcvsack;
+  int i = 0;
+
+  /* Remove all of the blocks that the new data joins */
+
+  while (i < n)
+    {
+      if (TCP_SEQ_LTE(sb[i].left, right) && TCP_SEQ_GTE(sb[i].right, left))
+        {
+          if (TCP_SEQ_LT(sb[i].left, left))
+            {
+              left = sb[i].left;
+            }
+
+          if (TCP_SEQ_GT(sb[i].right, right))
+            {
+              right = sb[i].right;
+            }
+
+          n--;
+          memmove(&sb[i], &sb[i + 1], (n - i) * sizeof(struct tcp_sack_s));
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  /* And put the merged block at the front, forgetting the oldest block if
+   * there is no room.
+   */
+
+  if (n >= TCP_SACK_NBLOCKS)
+    {
+      n = TCP_SACK_NBLOCKS - 1;
+    }
+
+  memmove(&sb[1], &sb[0], n * sizeof(struct tcp_sack_s));
+  sb[0].left     = left;
+  sb[0].right    = right;
+  conn->nrcvsack = n + 1;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_options
+ *
+ * Description:
+ *   Format the SACK option for an outgoing ACK.
+ *
+ ****************************************************************************/
+
+unsigned int tcp_sack_options(FAR struct tcp_conn_s *conn,
+                              FAR uint8_t *opt)
+{
+  FAR struct tcp_sack_s *sb = conn->rcvsack;
+  uint32_t rcvseq;
+  int n;
+  int i;
+
+  /* Discard blocks that have been cumulatively acknowledged */
+
+  rcvseq = tcp_getsequence(conn->rcvseq);
+  for (i = 0, n = 0; i < conn->nrcvsack; i++)
+    {
+      if (TCP_SEQ_GT(sb[i].right, rcvseq))
+        {
+          sb[n] = sb[i];
+          if (TCP_SEQ_LT(sb[n].left, rcvseq))
+            {
+              sb[n].left = rcvseq;
+            }
+
+          n++;
+        }
+    }
+
+  conn->nrcvsack = n;
+  if (n == 0 || (conn->tcpopts & TCP_NEGO_SACK) == 0)
+    {
+      return 0;
+    }
+
+  /* Two NOPs keep the blocks 32-bit aligned */
+
+  opt[0] = TCP_OPT_NOOP;
+  opt[1] = TCP_OPT_NOOP;
+  opt[2] = TCP_OPT_SACK;
+  opt[3] = TCP_OPT_SACK_LEN(n);
+
+  for (i = 0; i < n; i++)
+    {
+      tcp_setsequence(&opt[4 + 8 * i], sb[i].left);
+      tcp_setsequence(&opt[8 + 8 * i], sb[i].right);
+    }
+
+  return 2 + TCP_OPT_SACK_LEN(n);
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_SACK */
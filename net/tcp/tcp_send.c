@@ -58,6 +58,10 @@
 #  include <nuttx/semaphore.h>
 #endif
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#  include <nuttx/mm/iob.h>
+#endif
+
 #include "devif/devif.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
@@ -155,7 +159,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]      = 0;
 
   tcp->tcpchksum    = 0;
-  tcp->tcpchksum    = ~tcp_ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOAD(dev) && !NETDEV_GSO(dev))
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
 
   /* Finish initializing the IP header and calculate the IP checksum */
 
@@ -170,7 +177,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOAD(dev) && !NETDEV_GSO(dev))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   ninfo("IPv4 length: %d\n", ((int)ipv4->len[0] << 8) + ipv4->len[1]);
 
@@ -227,7 +237,10 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]     = 0;
 
   tcp->tcpchksum   = 0;
-  tcp->tcpchksum   = ~tcp_ipv6_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOAD(dev) && !NETDEV_GSO(dev))
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
 
   /* Finish initializing the IP header (no IPv6 checksum) */
 
@@ -289,6 +302,96 @@ static void tcp_sendcomplete(FAR struct net_driver_s *dev,
 #endif
 }
 
+/****************************************************************************
+ * Name: tcp_rcvwnd
+ *
+ * Description:
+ *   Get the receive window to advertise when window scaling is in use.
+ *   This is the free I/O buffer space that read-ahead buffering may use,
+ *   limited to CONFIG_NET_TCP_WINDOW_SCALE_MAXWND.  The right edge of the
+ *   window is never moved to the left of one advertised earlier.
+ *
+ * Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The TCP connection structure holding connection information
+ *   tcp  - The TCP header of the outgoing segment
+ *
+ * Return:
+ *   The value of the window field of the outgoing segment.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+static uint16_t tcp_rcvwnd(FAR struct net_driver_s *dev,
+                           FAR struct tcp_conn_s *conn,
+                           FAR struct tcp_hdr_s *tcp)
+{
+  uint32_t wnd = NET_DEV_RCVWNDO(dev);
+  uint32_t rcvseq;
+  uint32_t avail;
+  int32_t adv;
+  int navail;
+
+  /* The window field of a SYN segment is never scaled (RFC 7323) */
+
+  rcvseq = tcp_getsequence(conn->rcvseq);
+  if ((tcp->flags & TCP_SYN) != 0 ||
+      (conn->tcpopts & TCP_NEGO_WSCALE) == 0)
+    {
+      conn->rcv_adv = rcvseq + wnd;
+      return wnd;
+    }
+
+  /* Otherwise, offer the free I/O buffer space that read-ahead buffering
+   * can use to retain the data.  Read-ahead allocations are throttled so
+   * the last CONFIG_IOB_THROTTLE buffers are not available to it.
+   */
+
+  navail = iob_navail() - CONFIG_IOB_THROTTLE;
+  avail  = navail > 0 ? (uint32_t)navail * CONFIG_IOB_BUFSIZE : 0;
+
+  if (avail > wnd)
+    {
+      wnd = avail;
+    }
+
+  if (wnd > CONFIG_NET_TCP_WINDOW_SCALE_MAXWND)
+    {
+      wnd = CONFIG_NET_TCP_WINDOW_SCALE_MAXWND;
+    }
+
+  /* Never shrink the window:  Data that the peer may already have sent
+   * within the last advertised window must still be accepted.
+   */
+
+  adv = (int32_t)(conn->rcv_adv - rcvseq);
+  if (adv > 0 && (uint32_t)adv > wnd)
+    {
+      wnd = adv;
+    }
+
+  /* Round up so that the scaled window still reaches the right edge */
+
+  wnd = (wnd + (1 << conn->rcv_scale) - 1) >> conn->rcv_scale;
+  if (wnd > UINT16_MAX)
+    {
+      wnd = UINT16_MAX;
+    }
+
+  /* Remember the new right edge */
+
+  if ((int32_t)(rcvseq + (wnd << conn->rcv_scale) - conn->rcv_adv) > 0)
+    {
+      conn->rcv_adv = rcvseq + (wnd << conn->rcv_scale);
+    }
+
+  return wnd;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_sendcommon
  *
@@ -318,6 +421,9 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
   int  qentry_sem_count;
   uint32_t rwnd;
 #endif
+#ifdef CONFIG_NET_TCP_GSO
+  unsigned int hdrlen;
+#endif
 
   /* Copy the IP address into the IPv6 header */
 
@@ -377,9 +483,31 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     }
   else
     {
-      tcp->wnd[0] = ((NET_DEV_RCVWNDO(dev)) >> 8);
-      tcp->wnd[1] = ((NET_DEV_RCVWNDO(dev)) & 0xff);
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      uint16_t recvwndo = tcp_rcvwnd(dev, conn, tcp);
+#else
+      uint16_t recvwndo = NET_DEV_RCVWNDO(dev);
+#endif
+
+      tcp->wnd[0] = (recvwndo >> 8);
+      tcp->wnd[1] = (recvwndo & 0xff);
+    }
+
+#ifdef CONFIG_NET_TCP_GSO
+  /* A segment that carries more than one MSS of data is a super-segment.
+   * It will be split into MSS-sized segments and the checksums will be
+   * calculated for each of those.
+   */
+
+  hdrlen = (FAR uint8_t *)tcp - &dev->d_buf[NET_LL_HDRLEN(dev)] +
+           ((tcp->tcpoffset >> 4) << 2);
+
+  dev->d_gsosize = 0;
+  if (dev->d_len > hdrlen + conn->mss)
+    {
+      dev->d_gsosize = conn->mss;
     }
+#endif
 
   /* Finish the IP portion of the message and calculate checksums */
 
@@ -419,6 +547,33 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->flags     = flags;
   dev->d_len     = len;
   tcp->tcpoffset = (TCP_HDRLEN / 4) << 4;
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Report retained out-of-order data in pure ACKs.  Options cannot be
+   * added to a segment that carries data:  The payload is already in
+   * place just after the fixed-size TCP header.
+   */
+
+  if (flags == TCP_ACK &&
+      (FAR uint8_t *)tcp + TCP_HDRLEN == &dev->d_buf[NET_LL_HDRLEN(dev) + len])
+    {
+      unsigned int optlen;
+
+      optlen          = tcp_sack_options(conn, (FAR uint8_t *)tcp + TCP_HDRLEN);
+      dev->d_len     += optlen;
+      tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* This segment acknowledges everything received so far */
+
+  if ((flags & TCP_ACK) != 0)
+    {
+      tcp_dlyack_sent(dev, conn);
+    }
+#endif
+
   tcp_sendcommon(dev, conn, tcp);
 }
 
@@ -454,6 +609,10 @@ void tcp_reset(FAR struct net_driver_s *dev)
   tcp->flags     = TCP_RST | TCP_ACK;
   tcp->tcpoffset = 5 << 4;
 
+#ifdef CONFIG_NET_TCP_GSO
+  dev->d_gsosize = 0;
+#endif
+
   /* Flip the seqno and ackno fields in the TCP header. */
 
   seqbyte        = tcp->seqno[3];
@@ -560,6 +719,10 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
              uint8_t ack)
 {
   struct tcp_hdr_s *tcp;
+#ifdef HAVE_TCP_OPTIONS
+  FAR uint8_t *opt;
+#endif
+  uint16_t optlen;
   uint16_t tcp_mss;
 
   /* Get values that vary with the underlying IP domain */
@@ -606,7 +769,40 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->optdata[1] = TCP_OPT_MSS_LEN;
   tcp->optdata[2] = tcp_mss >> 8;
   tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  optlen          = TCP_OPT_MSS_LEN;
+
+#ifdef HAVE_TCP_OPTIONS
+  /* In a SYN, offer the other options that we support.  In a SYNACK,
+   * confirm those that the peer offered.  NOPs keep each option 32-bit
+   * aligned.
+   */
+
+  opt             = (FAR uint8_t *)tcp + TCP_HDRLEN;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((conn->tcpopts & TCP_NEGO_WSCALE) != 0)
+    {
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_WS;
+      opt[optlen++] = TCP_OPT_WS_LEN;
+      opt[optlen++] = conn->rcv_scale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  if ((conn->tcpopts & TCP_NEGO_SACK) != 0)
+    {
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_NOOP;
+      opt[optlen++] = TCP_OPT_SACK_PERM;
+      opt[optlen++] = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
+
+  dev->d_len     += optlen - TCP_OPT_MSS_LEN;
+#endif
+
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   /* Complete the common portions of the TCP message */
 
@@ -67,6 +67,7 @@
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/tcp.h>
 
 #include "netdev/netdev.h"
@@ -320,6 +321,113 @@ static inline bool psock_send_addrchck(FAR struct tcp_conn_s *conn)
 #  define psock_send_addrchck(r) (true)
 #endif /* CONFIG_NET_ETHERNET */
 
+/****************************************************************************
+ * Name: psock_fast_retransmit
+ *
+ * Description:
+ *   Retransmit one segment in response to duplicate or partial ACKs
+ *   (RFC 6582).  Without SACK, this is the first unacknowledged segment.
+ *   With SACK, it is the next hole in the data that the peer reported as
+ *   received (RFC 6675).  The remainder of the flight is left alone so that
+ *   recovery does not fall back to a full go-back-N retransmission.
+ *
+ * Parameters:
+ *   dev      The structure of the network driver that caused the event
+ *   conn     The connection structure associated with the socket
+ *   ackno    The cumulative ACK number
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+static void psock_fast_retransmit(FAR struct net_driver_s *dev,
+                                  FAR struct tcp_conn_s *conn,
+                                  uint32_t ackno)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  uint32_t seqno = ackno;
+  uint32_t sndlen = conn->mss;
+  uint32_t offset;
+  uint32_t avail;
+
+#ifdef CONFIG_NET_TCP_SACK
+  if (!tcp_sack_nexthole(conn, &seqno, &sndlen))
+    {
+      /* Nothing left to repair */
+
+      return;
+    }
+#endif
+
+  /* Find the write buffer that holds seqno.  The unacked_q holds write
+   * buffers that have been entirely sent.  The head of the write_q may
+   * also have been partially sent.
+   */
+
+  avail = 0;
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb    = (FAR struct tcp_wrbuffer_s *)entry;
+      offset = seqno - WRB_SEQNO(wrb);
+      if (offset < WRB_PKTLEN(wrb))
+        {
+          avail = WRB_PKTLEN(wrb) - offset;
+          break;
+        }
+    }
+
+  if (avail == 0)
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+      if (wrb == NULL)
+        {
+          return;
+        }
+
+      offset = seqno - WRB_SEQNO(wrb);
+      if (offset >= WRB_SENT(wrb))
+        {
+          return;
+        }
+
+      avail = WRB_SENT(wrb) - offset;
+    }
+
+  if (sndlen > avail)
+    {
+      sndlen = avail;
+    }
+
+  ninfo("FASTREXMIT: wrb=%p seqno=%u sndlen=%u\n", wrb, seqno, sndlen);
+
+  /* Resend the data.  The unacked and sent counts are not changed:  This
+   * data is already accounted for.
+   */
+
+  tcp_setsequence(conn->sndseq, seqno);
+
+#ifdef NEED_IPDOMAIN_SUPPORT
+  send_ipselect(dev, conn);
+#endif
+
+  devif_iob_send(dev, WRB_IOB(wrb), sndlen, offset);
+
+#ifdef CONFIG_NET_TCP_SACK
+  conn->sacknxt = seqno + sndlen;
+#endif
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.rexmit++;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -370,6 +478,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_CC
+      bool rexmit;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -503,6 +614,32 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, WRB_SEQNO(wrb), WRB_PKTLEN(wrb), WRB_SENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Let congestion control account for the ACK.  On the third
+       * duplicate ACK, or a partial ACK during recovery, the first
+       * unacknowledged segment is retransmitted immediately.  With SACK,
+       * any other ACK received during recovery may repair another hole,
+       * but only while the data in flight is below the congestion window
+       * (RFC 6675).  That is only possible if the ACK carried no data that
+       * still must be processed.
+       */
+
+      rexmit = tcp_cc_ack(conn, ackno, conn->winsize,
+                          (flags & TCP_NEWDATA) == 0);
+#ifdef CONFIG_NET_TCP_SACK
+      if (!rexmit && (conn->ccflags & TCP_CC_RECOVERY) != 0 &&
+          conn->nsndsack > 0)
+        {
+          rexmit = tcp_sack_pipe(conn, ackno) < conn->cwnd;
+        }
+#endif
+
+      if (rexmit && (flags & TCP_NEWDATA) == 0 && dev->d_sndlen == 0)
+        {
+          psock_fast_retransmit(dev, conn, ackno);
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -698,7 +835,17 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
+#ifdef CONFIG_NET_TCP_CC
+      /* With congestion control, each ACK that opens the window may clock
+       * out new data without waiting for the next poll.
+       */
+
+      ((flags & (TCP_POLL | TCP_REXMIT)) != 0 ||
+       (flags & (TCP_ACKDATA | TCP_NEWDATA)) == TCP_ACKDATA) &&
+      tcp_cc_sndwnd(conn) > 0 &&
+#else
       (flags & (TCP_POLL | TCP_REXMIT)) &&
+#endif
       !(sq_empty(&conn->write_q)))
     {
       /* Check if the destination IP address is in the ARP  or Neighbor
@@ -727,15 +874,24 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            */
 
           sndlen = WRB_PKTLEN(wrb) - WRB_SENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > tcp_gso_sndsize(dev, conn))
             {
-              sndlen = conn->mss;
+              sndlen = tcp_gso_sndsize(dev, conn);
             }
 
+#ifdef CONFIG_NET_TCP_CC
+          /* Limit the data in flight to the congestion window */
+
+          if (sndlen > tcp_cc_sndwnd(conn))
+            {
+              sndlen = tcp_cc_sndwnd(conn);
+            }
+#else
           if (sndlen > conn->winsize)
             {
               sndlen = conn->winsize;
             }
+#endif
 
           ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u\n",
                 wrb, WRB_PKTLEN(wrb), WRB_SENT(wrb), sndlen);
@@ -103,6 +103,7 @@ struct send_s
   FAR const uint8_t      *snd_buffer;  /* Points to the buffer of data to send */
   size_t                  snd_buflen;  /* Number of bytes in the buffer to send */
   ssize_t                 snd_sent;    /* The number of bytes sent */
+  uint32_t                snd_max;     /* Highest number of bytes ever sent */
   uint32_t                snd_isn;     /* Initial sequence number */
   uint32_t                snd_acked;   /* The number of bytes acked */
 #ifdef CONFIG_NET_SOCKOPTS
@@ -297,6 +298,9 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pvconn;
   FAR struct send_s *pstate = (FAR struct send_s *)pvpriv;
+#ifdef CONFIG_NET_TCP_CC
+  ssize_t rexmit_sent = 0;
+#endif
 
   /* The TCP socket is connected and, hence, should be bound to a device.
    * Make sure that the polling device is the one that we are bound to.
@@ -318,6 +322,7 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
   if ((flags & TCP_ACKDATA) != 0)
     {
       FAR struct tcp_hdr_s *tcp;
+      uint32_t acked;
 
       /* Update the timeout */
 
@@ -353,7 +358,38 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
        * of bytes to be acknowledged.
        */
 
-      pstate->snd_acked = tcp_getsequence(tcp->ackno) - pstate->snd_isn;
+      acked = tcp_getsequence(tcp->ackno) - pstate->snd_isn;
+      if (acked > pstate->snd_acked)
+        {
+          pstate->snd_acked = acked;
+        }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Let congestion control account for the ACK.  On the third
+       * duplicate ACK, or a partial ACK during recovery, resend the first
+       * unacknowledged segment now.  Only that segment is resent: snd_sent
+       * is restored once it has gone out.
+       */
+
+      if (tcp_cc_ack(conn, tcp_getsequence(tcp->ackno), conn->winsize,
+                     (flags & TCP_NEWDATA) == 0) &&
+          pstate->snd_acked < pstate->snd_sent)
+        {
+          rexmit_sent      = pstate->snd_sent;
+          pstate->snd_sent = pstate->snd_acked;
+        }
+#endif
+
+      /* After a retransmission, the peer may acknowledge data beyond the
+       * point where we resumed sending (it may have queued the later
+       * segments out-of-order).  Don't send those bytes again.
+       */
+
+      if (pstate->snd_acked > pstate->snd_sent)
+        {
+          pstate->snd_sent = pstate->snd_acked;
+        }
+
       ninfo("ACK: acked=%d sent=%d buflen=%d\n",
             pstate->snd_acked, pstate->snd_sent, pstate->snd_buflen);
 
@@ -527,15 +563,34 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
 
 #endif /* CONFIG_NET_TCP_SPLIT */
 
-      if (sndlen > conn->mss)
+      if (sndlen > tcp_gso_sndsize(dev, conn))
+        {
+          sndlen = tcp_gso_sndsize(dev, conn);
+        }
+
+      sndlen = tcp_gso_wndtrim(conn, sndlen,
+                               pstate->snd_sent - pstate->snd_acked);
+
+#ifdef CONFIG_NET_TCP_CC
+      /* A fast retransmission resends a single segment */
+
+      if (rexmit_sent > 0 && sndlen > conn->mss)
         {
           sndlen = conn->mss;
         }
+#endif
 
-      /* Check if we have "space" in the window */
+      /* Check if we have "space" in the window.  Up to a full window of
+       * data from the caller's buffer may be in flight at any time; the
+       * caller remains blocked (and the buffer pinned) until all of it has
+       * been ACKed.
+       */
 
-      if ((pstate->snd_sent - pstate->snd_acked + sndlen) < conn->winsize)
+      if ((pstate->snd_sent - pstate->snd_acked + sndlen) <=
+          TCP_WNDSIZE(conn))
         {
+          uint32_t sndmax;
+
           /* Set the sequence number for this packet.  NOTE:  The network updates
            * sndseq on receipt of ACK *before* this function is called.  In that
            * case sndseq will point to the next unacknowledged byte (which might
@@ -547,6 +602,25 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
           ninfo("SEND: sndseq %08x->%08x\n", conn->sndseq, seqno);
           tcp_setsequence(conn->sndseq, seqno);
 
+          /* Set up conn->unacked so that sndseq + unacked still refers to
+           * the end of all data sent so far, even when this packet is a
+           * retransmission that lies below data that is already in flight.
+           * tcp_appsend() will add sndlen to conn->unacked;  tcp_rexmit()
+           * (called directly on a retransmission timeout) does not.
+           */
+
+          sndmax = pstate->snd_sent + sndlen;
+          if (sndmax < pstate->snd_max)
+            {
+              sndmax = pstate->snd_max;
+            }
+
+          conn->unacked = sndmax - pstate->snd_sent;
+          if ((flags & TCP_REXMIT) == 0)
+            {
+              conn->unacked -= sndlen;
+            }
+
 #ifdef NEED_IPDOMAIN_SUPPORT
           /* If both IPv4 and IPv6 support are enabled, then we will need to
            * select which one to use when generating the outgoing packet.
@@ -572,13 +646,34 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
               /* Update the amount of data sent (but not necessarily ACKed) */
 
               pstate->snd_sent += sndlen;
+              pstate->snd_max   = sndmax;
               ninfo("SEND: acked=%d sent=%d buflen=%d\n",
                     pstate->snd_acked, pstate->snd_sent, pstate->snd_buflen);
 
+              /* If there is more data to send and the window will accept
+               * another segment, ask the driver to poll again rather than
+               * waiting for the ACK of this one.
+               */
+
+              if (pstate->snd_sent < pstate->snd_buflen &&
+                  (pstate->snd_sent - pstate->snd_acked + conn->mss) <=
+                  TCP_WNDSIZE(conn))
+                {
+                  netdev_txnotify_dev(dev);
+                }
             }
         }
     }
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Resume after the data that was in flight before a fast retransmit */
+
+  if (rexmit_sent > pstate->snd_sent)
+    {
+      pstate->snd_sent = rexmit_sent;
+    }
+#endif
+
 #ifdef CONFIG_NET_SOCKOPTS
   /* All data has been sent and we are just waiting for ACK or re-transmit
    * indications to complete the send.  Check for a timeout.
@@ -58,6 +58,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -99,6 +100,7 @@ struct sendfile_s
   FAR struct devif_callback_s *snd_datacb; /* Data callback */
   FAR struct devif_callback_s *snd_ackcb;  /* ACK callback */
   FAR struct file   *snd_file;    /* File structure of the input file */
+  FAR const uint8_t *snd_xipbase; /* Directly addressable file data (or NULL) */
   sem_t              snd_sem;     /* Used to wake up the waiting thread */
   off_t              snd_foffset; /* Input file offset */
   size_t             snd_flen;    /* File length */
@@ -418,21 +420,36 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
+          if (pstate->snd_xipbase != NULL)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
+              /* The file data is directly addressable.  Copy it straight
+               * into the packet buffer.
+               */
 
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-          if (ret < 0)
+              memcpy(dev->d_appdata, pstate->snd_xipbase +
+                     pstate->snd_foffset + pstate->snd_sent, sndlen);
+              ret = sndlen;
+            }
+          else
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              ret = file_seek(pstate->snd_file,
+                              pstate->snd_foffset + pstate->snd_sent,
+                              SEEK_SET);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to lseek: %d\n", ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
+
+              ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to read from input file: %d\n",
+                       (int)ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
             }
 
           dev->d_sndlen = sndlen;
@@ -509,6 +526,76 @@ wait:
   return flags;
 }
 
+/****************************************************************************
+ * Name: tcp_sendfile_xipbase
+ *
+ * Description:
+ *   Determine if the input file is a file system file whose data is
+ *   directly addressable in memory (i.e., the file system supports the
+ *   FIOC_MMAP ioctl).
+ *
+ * Parameters:
+ *   infile - The input file
+ *   offset - The offset into the file where the transfer begins
+ *   count  - The requested transfer size.  Truncated to the end of the
+ *            file if the file is directly addressable.
+ *
+ * Returned Value:
+ *   The address of the beginning of the file data or NULL if the file data
+ *   is not directly addressable.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *tcp_sendfile_xipbase(FAR struct file *infile,
+                                               off_t offset,
+                                               FAR size_t *count)
+{
+  FAR uint8_t *xipbase = NULL;
+  off_t curpos;
+  off_t endpos;
+  int ret;
+
+  if (infile->f_inode == NULL || !INODE_IS_MOUNTPT(infile->f_inode))
+    {
+      return NULL;
+    }
+
+  ret = file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&xipbase));
+  if (ret < 0 || xipbase == NULL)
+    {
+      return NULL;
+    }
+
+  /* Get the size of the file so that we never reference beyond the end of
+   * the file data.
+   */
+
+  curpos = file_seek(infile, 0, SEEK_CUR);
+  if (curpos < 0)
+    {
+      return NULL;
+    }
+
+  endpos = file_seek(infile, 0, SEEK_END);
+  (void)file_seek(infile, curpos, SEEK_SET);
+
+  if (endpos < 0)
+    {
+      return NULL;
+    }
+
+  if (offset >= endpos)
+    {
+      *count = 0;
+    }
+  else if (*count > (size_t)(endpos - offset))
+    {
+      *count = endpos - offset;
+    }
+
+  return xipbase;
+}
+
 /****************************************************************************
  * Name: sendfile_txnotify
  *
@@ -584,6 +671,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
   FAR struct tcp_conn_s *conn;
+  FAR const uint8_t *xipbase;
   struct sendfile_s state;
   int ret;
 
@@ -631,6 +719,18 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+  /* Check if the file data is directly addressable (as it is, for example,
+   * for a ROMFS file system on XIP media).  If so, the data may be copied
+   * directly into the packet buffers without seeking and reading the file
+   * on each packet.
+   */
+
+  xipbase = tcp_sendfile_xipbase(infile, offset ? *offset : 0, &count);
+  if (xipbase != NULL && count == 0)
+    {
+      return 0;
+    }
+
   /* Set the socket state to sending */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
@@ -654,6 +754,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : 0; /* Input file offset */
   state.snd_flen    = count;                /* Number of bytes to send */
   state.snd_file    = infile;               /* File to read from */
+  state.snd_xipbase = xipbase;              /* Directly addressable data */
 
   /* Allocate resources to receive a callback */
 
@@ -41,6 +41,7 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -82,40 +83,135 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *wordptr;
+  uint32_t acc = 0;
+  uint32_t t;
+  bool odd = false;
+  uint8_t first = 0;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* The one's complement sum does not depend on byte order (RFC1071), so
+   * the words are summed in native byte order and the result is swapped
+   * into network order at the end.  If the data begins on an odd address,
+   * the first byte is set aside and the sum of the rest of the data is
+   * byte swapped.
+   */
+
+  if (((uintptr_t)data & 1) != 0)
+    {
+      first = *data++;
+      odd   = true;
+      len--;
+    }
+
+  /* Get 32-bit alignment */
+
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc   = *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-  while (dataptr < last_byte)
+  /* Accumulate 32-bits at a time, four words per iteration.  The carry out
+   * of the 32-bit accumulator is folded back in (end-around carry).
+   */
+
+  wordptr = (FAR const uint32_t *)data;
+  while (len >= 16)
     {
-      /* At least two more bytes */
+      t = wordptr[0];
+      acc += t;
+      acc += (acc < t);
+
+      t = wordptr[1];
+      acc += t;
+      acc += (acc < t);
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      t = wordptr[2];
+      acc += t;
+      acc += (acc < t);
 
-      dataptr += 2;
+      t = wordptr[3];
+      acc += t;
+      acc += (acc < t);
+
+      wordptr += 4;
+      len     -= 16;
+    }
+
+  while (len >= 4)
+    {
+      t = *wordptr++;
+      acc += t;
+      acc += (acc < t);
+      len -= 4;
     }
 
-  if (dataptr == last_byte)
+  data = (FAR const uint8_t *)wordptr;
+  if (len >= 2)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      t = *(FAR const uint16_t *)data;
+      acc += t;
+      acc += (acc < t);
+      data += 2;
+      len  -= 2;
     }
 
+  /* A trailing byte is the most significant byte of a zero padded
+   * 16-bit word in network order.
+   */
+
+  if (len > 0)
+    {
+      union
+      {
+        uint16_t word;
+        uint8_t  byte[2];
+      } pad;
+
+      pad.byte[0] = *data;
+      pad.byte[1] = 0;
+
+      t = pad.word;
+      acc += t;
+      acc += (acc < t);
+    }
+
+  /* Fold the 32-bit accumulator into 16 bits */
+
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  /* Convert the sum to host order and restore the odd leading byte */
+
+#ifndef CONFIG_ENDIAN_BIG
+  if (!odd)
+#else
+  if (odd)
+#endif
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+  if (odd)
+    {
+      acc += (uint32_t)first << 8;
+    }
+
+  /* Add the partial sum passed by the caller */
+
+  acc += sum;
+  acc  = (acc >> 16) + (acc & 0xffff);
+  acc  = (acc >> 16) + (acc & 0xffff);
+
   /* Return sum in host byte order. */
 
-  return sum;
+  return (uint16_t)acc;
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
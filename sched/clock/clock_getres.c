@@ -44,6 +44,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/arch.h>
+
 #include "clock/clock.h"
 
 /****************************************************************************
@@ -64,7 +66,20 @@ int clock_getres(clockid_t clock_id, struct timespec *res)
 
   sinfo("clock_id=%d\n", clock_id);
 
-  /* Only CLOCK_REALTIME is supported */
+#ifdef CONFIG_SCHED_CPUTIME
+  /* CLOCK_THREAD_CPUTIME_ID has the resolution of the perf counter */
+
+  if (clock_id == CLOCK_THREAD_CPUTIME_ID)
+    {
+      uint32_t freq = up_perf_getfreq();
+
+      res->tv_sec  = 0;
+      res->tv_nsec = freq < NSEC_PER_SEC ? NSEC_PER_SEC / freq : 1;
+    }
+  else
+#endif
+
+  /* Otherwise, only CLOCK_REALTIME is supported */
 
   if (clock_id != CLOCK_REALTIME)
     {
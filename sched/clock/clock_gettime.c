@@ -49,6 +49,10 @@
 #include <nuttx/arch.h>
 
 #include "clock/clock.h"
+#ifdef CONFIG_SCHED_CPUTIME
+#  include <nuttx/clock.h>
+#  include "sched/sched.h"
+#endif
 #ifdef CONFIG_CLOCK_TIMEKEEPING
 #  include "clock/clock_timekeeping.h"
 #endif
@@ -131,6 +135,23 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
   else
 #endif
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* CLOCK_THREAD_CPUTIME_ID is the CPU time used by the calling thread */
+
+  if (clock_id == CLOCK_THREAD_CPUTIME_ID)
+    {
+      uint64_t nsec;
+
+      ret = clock_cputime(this_task()->pid, &nsec);
+      if (ret == OK)
+        {
+          tp->tv_sec  = (time_t)(nsec / NSEC_PER_SEC);
+          tp->tv_nsec = (long)(nsec % NSEC_PER_SEC);
+        }
+    }
+  else
+#endif
+
   /* CLOCK_REALTIME - POSIX demands this to be present.  CLOCK_REALTIME
    * represents the machine's best-guess as to the current wall-clock,
    * time-of-day time. This means that CLOCK_REALTIME can jump forward and
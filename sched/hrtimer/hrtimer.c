@@ -0,0 +1,473 @@
+/****************************************************************************
+ * sched/hrtimer/hrtimer.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/tree.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/timers/oneshot.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The oneshot timer is never programmed for less than one microsecond (most
+ * lower halves cannot represent less) or for more than one hour (to avoid
+ * overflow in lower halves that convert the delay to timer counts).
+ */
+
+#define HRTIMER_MINDELAY  NSEC_PER_USEC
+#define HRTIMER_MAXDELAY  (3600ull * NSEC_PER_SEC)
+
+/* If the oneshot timer has no clock of its own, the current time is read
+ * from the system clock.  Unless CONFIG_SCHED_TICKLESS or CONFIG_RTC_HIRES
+ * is selected, that lags the true time by up to one tick.  The oneshot
+ * delay is then extended by one tick so that timers do not expire early.
+ */
+
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_RTC_HIRES)
+#  define HRTIMER_SYSSLACK 0
+#else
+#  define HRTIMER_SYSSLACK NSEC_PER_TICK
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The active timers are kept in a red-black tree ordered by expiration
+ * time.  The left-most node is the next timer to expire.
+ */
+
+RB_HEAD(hrtimer_tree_s, hrtimer_s);
+
+struct hrtimer_state_s
+{
+  FAR struct oneshot_lowerhalf_s *oneshot; /* Bound oneshot timer */
+  struct hrtimer_tree_s tree;              /* Active timers */
+  uint64_t maxdelay;                       /* Max oneshot delay (ns) */
+  uint64_t armed;                          /* Oneshot expiry (ns) or zero */
+  uint64_t floor;                          /* Lower bound on current time */
+  bool hasclock;                           /* True: Time from the oneshot */
+  bool expiring;                           /* True: Processing expirations */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b);
+static uint64_t hrtimer_now(void);
+static void hrtimer_reprogram(uint64_t now);
+static void hrtimer_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg);
+
+RB_PROTOTYPE_STATIC(hrtimer_tree_s, hrtimer_s, node, hrtimer_compare);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct hrtimer_state_s g_hrtimer =
+{
+  NULL,
+  RB_INITIALIZER(&g_hrtimer.tree)
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+RB_GENERATE_STATIC(hrtimer_tree_s, hrtimer_s, node, hrtimer_compare);
+
+/****************************************************************************
+ * Name: hrtimer_compare
+ *
+ * Description:
+ *   Order two timers by expiration time.  Timers with the same expiration
+ *   time are ordered by address so that every node has a unique key.
+ *
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b)
+{
+  if (a->expired != b->expired)
+    {
+      return a->expired < b->expired ? -1 : 1;
+    }
+
+  if (a != b)
+    {
+      return (uintptr_t)a < (uintptr_t)b ? -1 : 1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: hrtimer_now
+ *
+ * Description:
+ *   Return the current time in nanoseconds.
+ *
+ *   If the oneshot timer provides the free-running clock that its delays
+ *   are measured against, that clock is used.  Otherwise the system clock
+ *   is used.  The system clock may be coarser than the oneshot timer (it
+ *   advances only on each tick unless CONFIG_SCHED_TICKLESS or
+ *   CONFIG_RTC_HIRES is selected).  Once the oneshot timer has fired,
+ *   however, we know that at least the programmed time has elapsed.  That
+ *   is retained as a floor so that expired timers are not re-armed for the
+ *   sub-tick remainder.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static uint64_t hrtimer_now(void)
+{
+  struct timespec ts;
+  uint64_t now;
+
+  if (g_hrtimer.hasclock && ONESHOT_CURRENT(g_hrtimer.oneshot, &ts) == OK)
+    {
+      return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+    }
+
+  (void)clock_systimespec(&ts);
+  now = (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+
+  if (now < g_hrtimer.floor)
+    {
+      now = g_hrtimer.floor;
+    }
+
+  return now;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   (Re-)program the oneshot timer for the earliest active hrtimer.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static void hrtimer_reprogram(uint64_t now)
+{
+  FAR struct hrtimer_s *first;
+  struct timespec ts;
+  uint64_t delay;
+
+  if (g_hrtimer.armed != 0)
+    {
+      (void)ONESHOT_CANCEL(g_hrtimer.oneshot, &ts);
+      g_hrtimer.armed = 0;
+    }
+
+  first = RB_MIN(hrtimer_tree_s, &g_hrtimer.tree);
+  if (first == NULL)
+    {
+      return;
+    }
+
+  delay = first->expired > now ? first->expired - now : 0;
+  if (!g_hrtimer.hasclock)
+    {
+      delay += HRTIMER_SYSSLACK;
+    }
+
+  if (delay < HRTIMER_MINDELAY)
+    {
+      delay = HRTIMER_MINDELAY;
+    }
+  else if (delay > g_hrtimer.maxdelay)
+    {
+      delay = g_hrtimer.maxdelay;
+    }
+
+  g_hrtimer.armed = now + delay;
+
+  ts.tv_sec  = (time_t)(delay / NSEC_PER_SEC);
+  ts.tv_nsec = (long)(delay % NSEC_PER_SEC);
+
+  DEBUGVERIFY(ONESHOT_START(g_hrtimer.oneshot, hrtimer_callback, NULL, &ts));
+}
+
+/****************************************************************************
+ * Name: hrtimer_callback
+ *
+ * Description:
+ *   This is the callback function that will be invoked when the oneshot
+ *   timer expires.  Every hrtimer that has expired is removed from the tree
+ *   and its callback is invoked.  Then the oneshot is re-programmed for the
+ *   next timer.
+ *
+ * Input Parameters:
+ *   lower - An instance of the lower half driver
+ *   arg   - The opaque argument provided when the interrupt was registered
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void hrtimer_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg)
+{
+  FAR struct hrtimer_s *hrtimer;
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = enter_critical_section();
+
+  /* The oneshot has fired so the time that it was armed for has passed */
+
+  if (g_hrtimer.armed > g_hrtimer.floor)
+    {
+      g_hrtimer.floor = g_hrtimer.armed;
+    }
+
+  g_hrtimer.armed    = 0;
+  g_hrtimer.expiring = true;
+
+  /* Process every timer that has expired.  The callbacks may restart
+   * timers; the oneshot is not re-programmed until all are processed.
+   */
+
+  now = hrtimer_now();
+  while ((hrtimer = RB_MIN(hrtimer_tree_s, &g_hrtimer.tree)) != NULL &&
+         hrtimer->expired <= now)
+    {
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer.tree, hrtimer);
+      hrtimer->active = false;
+
+      hrtimer->func(hrtimer);
+      now = hrtimer_now();
+    }
+
+  g_hrtimer.expiring = false;
+  hrtimer_reprogram(now);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Bind the high resolution timer subsystem to a oneshot timer as
+ *   described in include/nuttx/timers/oneshot.h.
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot timer interface.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void hrtimer_initialize(FAR struct oneshot_lowerhalf_s *lower)
+{
+  struct timespec ts;
+  irqstate_t flags;
+  uint64_t maxdelay;
+
+  DEBUGASSERT(lower != NULL && lower->ops != NULL);
+  DEBUGASSERT(lower->ops->start != NULL && lower->ops->cancel != NULL);
+
+  /* Get the maximum delay */
+
+  maxdelay = HRTIMER_MAXDELAY;
+  if (lower->ops->max_delay != NULL && ONESHOT_MAX_DELAY(lower, &ts) == OK)
+    {
+      uint64_t limit = (uint64_t)ts.tv_sec * NSEC_PER_SEC +
+                       (uint64_t)ts.tv_nsec;
+
+      if (limit < maxdelay)
+        {
+          maxdelay = limit;
+        }
+    }
+
+  DEBUGASSERT(maxdelay > HRTIMER_MINDELAY);
+  tmrinfo("maxdelay = %llu nsec\n", (unsigned long long)maxdelay);
+
+  flags              = enter_critical_section();
+  g_hrtimer.oneshot  = lower;
+  g_hrtimer.maxdelay = maxdelay;
+
+  /* Use the clock of the oneshot timer if it has one */
+
+  g_hrtimer.hasclock = lower->ops->current != NULL &&
+                       ONESHOT_CURRENT(lower, &ts) == OK;
+
+  hrtimer_reprogram(hrtimer_now());
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the current value of the monotonic clock that is used to
+ *   interpret hrtimer expiration times.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void)
+{
+  irqstate_t flags;
+  uint64_t now;
+
+  flags = enter_critical_section();
+  now   = hrtimer_now();
+  leave_critical_section(flags);
+
+  return now;
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start (or restart) a high resolution timer.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, hrtimer_cb_t func,
+                  FAR void *arg, uint64_t expired)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(hrtimer != NULL && func != NULL);
+
+  flags = enter_critical_section();
+  if (g_hrtimer.oneshot == NULL)
+    {
+      leave_critical_section(flags);
+      return -ENODEV;
+    }
+
+  if (hrtimer->active)
+    {
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer.tree, hrtimer);
+    }
+
+  hrtimer->expired = expired;
+  hrtimer->func    = func;
+  hrtimer->arg     = arg;
+  hrtimer->active  = true;
+
+  (void)RB_INSERT(hrtimer_tree_s, &g_hrtimer.tree, hrtimer);
+
+  /* Re-program the oneshot only if this timer is now the first to expire.
+   * If we are called from a callback, hrtimer_callback() will do that
+   * after all expired timers have been processed.
+   */
+
+  if (!g_hrtimer.expiring &&
+      (g_hrtimer.armed == 0 || expired < g_hrtimer.armed))
+    {
+      hrtimer_reprogram(hrtimer_now());
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_cancel(FAR struct hrtimer_s *hrtimer)
+{
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  flags = enter_critical_section();
+  if (hrtimer->active)
+    {
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer.tree, hrtimer);
+      hrtimer->active = false;
+
+      now = hrtimer_now();
+      if (hrtimer->expired > now)
+        {
+          remaining = hrtimer->expired - now;
+        }
+
+      /* The oneshot is left running even if this was the first timer.  A
+       * spurious expiration is harmless and cheaper than re-programming.
+       */
+    }
+
+  leave_critical_section(flags);
+  return remaining;
+}
+
+#endif /* CONFIG_HRTIMER */
@@ -839,6 +839,12 @@ void os_start(void)
         }
 #endif
 
+#ifdef CONFIG_SCHED_BALANCE
+      /* Pull any ready-to-run task that could be running on this CPU */
+
+      sched_idle_balance();
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
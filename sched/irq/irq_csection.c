@@ -122,6 +122,10 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #ifdef CONFIG_SMP
 static inline bool irq_waitlock(int cpu)
 {
+#ifdef CONFIG_SPINLOCK_STATS
+  uint32_t nspins = 0;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = this_task();
 
@@ -153,6 +157,9 @@ static inline bool irq_waitlock(int cpu)
           return false;
         }
 
+#ifdef CONFIG_SPINLOCK_STATS
+      nspins++;
+#endif
       SP_DSB();
     }
 
@@ -165,6 +172,7 @@ static inline bool irq_waitlock(int cpu)
 #endif
 
   SP_DMB();
+  spin_stats_update(&g_cpu_irqlock, nspins);
   return true;
 }
 #endif
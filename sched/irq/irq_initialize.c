@@ -90,4 +90,10 @@ void irq_initialize(void)
       g_irqvector[i].handler = irq_unexpected_isr;
       g_irqvector[i].arg     = NULL;
     }
+
+#ifdef CONFIG_SMP
+  /* Monitor contention on the global critical section lock */
+
+  spin_stats_register(&g_cpu_irqlock, "irq");
+#endif
 }
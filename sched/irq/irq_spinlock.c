@@ -51,7 +51,7 @@
 
 /* Used for access control */
 
-static volatile spinlock_t g_irq_spin SP_SECTION = SP_UNLOCKED;
+static kspinlock_t g_irq_spin SP_SECTION = KSPINLOCK_INITIALIZER;
 
 /* Handles nested calls to spin_lock_irqsave and spin_unlock_irqrestore */
 
@@ -66,9 +66,13 @@ static volatile uint8_t g_irq_spin_count[CONFIG_SMP_NCPUS];
  *
  * Description:
  *   If SMP and SPINLOCK_IRQ are enabled:
- *     Disable local interrupts and take the global spinlock (g_irq_spin)
- *     if the call counter (g_irq_spin_count[cpu]) equals to 0. Then the
- *     counter on the CPU is increment to allow nested call.
+ *     If the argument lock is not specified (i.e. NULL), disable local
+ *     interrupts and take the global spinlock (g_irq_spin) if the call
+ *     counter (g_irq_spin_count[cpu]) equals to 0. Then the counter on the
+ *     CPU is increment to allow nested call.
+ *
+ *     If the argument lock is specified, disable local interrupts and take
+ *     the lock spinlock.  This is not nestable.
  *
  *     NOTE: This API is very simple to protect data (e.g. H/W register
  *     or internal data structure) in SMP mode. But do not use this API
@@ -78,27 +82,35 @@ static volatile uint8_t g_irq_spin_count[CONFIG_SMP_NCPUS];
  *     This function is equivalent to enter_critical_section().
  *
  * Input Parameters:
- *   None
+ *   lock - Caller specific spinlock, or NULL to use the global spinlock.
  *
  * Returned Value:
  *   An opaque, architecture-specific value that represents the state of
- *   the interrupts prior to the call to spin_lock_irqsave();
+ *   the interrupts prior to the call to spin_lock_irqsave(lock);
  *
  ****************************************************************************/
 
-irqstate_t spin_lock_irqsave(void)
+irqstate_t spin_lock_irqsave(FAR kspinlock_t *lock)
 {
   irqstate_t ret;
   ret = up_irq_save();
 
-  int me = this_cpu();
-  if (0 == g_irq_spin_count[me])
+  if (NULL == lock)
+    {
+      int me = this_cpu();
+      if (0 == g_irq_spin_count[me])
+        {
+          kspin_lock(&g_irq_spin);
+        }
+
+      g_irq_spin_count[me]++;
+      ASSERT(0 != g_irq_spin_count[me]);
+    }
+  else
     {
-      spin_lock(&g_irq_spin);
+      kspin_lock(lock);
     }
 
-  g_irq_spin_count[me]++;
-  ASSERT(0 != g_irq_spin_count[me]);
   return ret;
 }
 
@@ -107,33 +119,45 @@ irqstate_t spin_lock_irqsave(void)
  *
  * Description:
  *   If SMP and SPINLOCK_IRQ are enabled:
- *     Decrement the call counter (g_irq_spin_count[cpu]) and if it
- *     decrements to zero then release the spinlock (g_irq_spin) and
- *     restore the interrupt state as it was prior to the previous call to
- *     spin_lock_irqsave().
+ *     If the argument lock is not specified (i.e. NULL), decrement the call
+ *     counter (g_irq_spin_count[cpu]) and if it decrements to zero then
+ *     release the spinlock (g_irq_spin) and restore the interrupt state as
+ *     it was prior to the previous call to spin_lock_irqsave(NULL).
+ *
+ *     If the argument lock is specified, release the lock and restore the
+ *     interrupt state as it was prior to the previous call to
+ *     spin_lock_irqsave(lock).
  *
  *   If SMP and SPINLOCK_IRQ are not enabled:
  *     This function is equivalent to leave_critical_section().
  *
  * Input Parameters:
+ *   lock  - Caller specific spinlock, or NULL to use the global spinlock.
  *   flags - The architecture-specific value that represents the state of
- *           the interrupts prior to the call to spin_lock_irqsave();
+ *           the interrupts prior to the call to spin_lock_irqsave(lock);
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-void spin_unlock_irqrestore(irqstate_t flags)
+void spin_unlock_irqrestore(FAR kspinlock_t *lock, irqstate_t flags)
 {
-  int me = this_cpu();
+  if (NULL == lock)
+    {
+      int me = this_cpu();
 
-  ASSERT(0 < g_irq_spin_count[me]);
-  g_irq_spin_count[me]--;
+      ASSERT(0 < g_irq_spin_count[me]);
+      g_irq_spin_count[me]--;
 
-  if (0 == g_irq_spin_count[me])
+      if (0 == g_irq_spin_count[me])
+        {
+          kspin_unlock(&g_irq_spin);
+        }
+    }
+  else
     {
-      spin_unlock(&g_irq_spin);
+      kspin_unlock(lock);
     }
 
   up_irq_restore(flags);
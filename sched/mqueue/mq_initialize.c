@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <queue.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 
 #include "mqueue/mqueue.h"
 
@@ -74,6 +75,12 @@ sq_queue_t  g_msgfree;
 
 sq_queue_t  g_msgfreeirq;
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+/* This spinlock protects g_msgfree and g_msgfreeirq */
+
+kspinlock_t g_msgfreelock SP_SECTION = KSPINLOCK_INITIALIZER;
+#endif
+
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
  * pool is a constant.
@@ -172,6 +179,10 @@ void nxmq_initialize(void)
   sq_init(&g_msgfreeirq);
   sq_init(&g_desalloc);
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+  spin_stats_register(&g_msgfreelock, "mqueue");
+#endif
+
   /* Allocate a block of messages for general use */
 
   g_msgalloc =
@@ -52,6 +52,7 @@
 #include <signal.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/spinlock.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -125,6 +126,14 @@ EXTERN sq_queue_t  g_msgfree;
 
 EXTERN sq_queue_t  g_msgfreeirq;
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+/* This spinlock protects g_msgfree and g_msgfreeirq in place of the
+ * global critical section.
+ */
+
+EXTERN kspinlock_t g_msgfreelock;
+#endif
+
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
  * pool is a constant.
@@ -422,6 +422,10 @@ void sched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 int  sched_cpu_select(cpu_set_t affinity);
 int  sched_cpu_pause(FAR struct tcb_s *tcb);
 #  define sched_islocked(tcb) spin_islocked(&g_cpu_schedlock)
+#  ifdef CONFIG_SCHED_BALANCE
+void sched_balance(void);
+void sched_idle_balance(void);
+#  endif
 #else
 #  define sched_cpu_select(a) (0)
 #  define sched_cpu_pause(t)  (-38)  /* -ENOSYS */
@@ -434,6 +438,27 @@ int  sched_cpu_pause(FAR struct tcb_s *tcb);
 void weak_function sched_process_cpuload(void);
 #endif
 
+/* Latency measurement support */
+
+#ifdef CONFIG_SCHED_LATENCY
+void sched_latency_ready(FAR struct tcb_s *tcb);
+void sched_latency_resume(FAR struct tcb_s *tcb);
+void sched_latency_semwait(FAR struct tcb_s *tcb, uint32_t start);
+#  define sched_latency_suspend(tcb) ((tcb)->readytime = 0)
+#else
+#  define sched_latency_ready(tcb)
+#  define sched_latency_resume(tcb)
+#  define sched_latency_suspend(tcb)
+#endif
+
+/* CPU time accounting support */
+
+#ifdef CONFIG_SCHED_CPUTIME
+void sched_cputime_resume(FAR struct tcb_s *tcb);
+void sched_cputime_suspend(FAR struct tcb_s *tcb);
+void sched_process_cputime(void);
+#endif
+
 /* TCB operations */
 
 bool sched_verifytcb(FAR struct tcb_s *tcb);
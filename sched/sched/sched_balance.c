@@ -0,0 +1,224 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_BALANCE
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The tick at which each CPU last balanced from its IDLE loop.  This keeps
+ * an IDLE CPU from hammering the critical section when the only ready
+ * tasks are not permitted to run on it.
+ */
+
+static systime_t g_balance_lasttick[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  sched_balance_candidate
+ *
+ * Description:
+ *   Find a task in the g_readytorun list that has a higher priority than
+ *   the task running on some CPU that it is permitted to run on.
+ *
+ * Return Value:
+ *   The TCB of the task to be pulled, or NULL if the load is balanced.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *sched_balance_candidate(void)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      rtcb = current_task(cpu);
+
+      /* The g_readytorun list is ordered by priority, so the first task
+       * that may run on this CPU is the best candidate for it.
+       */
+
+      for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+           tcb != NULL && !CPU_ISSET(cpu, &tcb->affinity);
+           tcb = tcb->flink);
+
+      if (tcb != NULL && tcb->sched_priority > rtcb->sched_priority)
+        {
+          return tcb;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  sched_balance
+ *
+ * Description:
+ *   Pull ready-to-run tasks from the g_readytorun list onto any CPU that is
+ *   idle or that is running a lower priority task.
+ *
+ *   Normally a task is placed on the best CPU when it becomes ready-to-run
+ *   and a CPU takes the next task from g_readytorun when its running task
+ *   is suspended.  But neither happens while pre-emption is locked or
+ *   another CPU holds the critical section:  The CPU then falls back to the
+ *   next task in its own assigned task list (usually its IDLE task) and the
+ *   ready-to-run tasks are stranded until the next context switch.  This
+ *   function repairs that condition.
+ *
+ *   Each task moved is counted in its TCB (nmigrations).
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler or from the IDLE loop.  A
+ *   context switch may occur on this CPU.
+ *
+ ****************************************************************************/
+
+void sched_balance(void)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int npulls;
+  int me;
+
+  /* Avoid the critical section in the common case of nothing to do */
+
+  if (g_readytorun.head == NULL)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+  me    = this_cpu();
+
+  /* Each pass places one task on some CPU, so no more than one pass per
+   * CPU can be useful.
+   */
+
+  for (npulls = 0; npulls < CONFIG_SMP_NCPUS; npulls++)
+    {
+      /* Tasks cannot be started while pre-emption is locked or while
+       * another CPU is in a critical section.
+       */
+
+      if (spin_islocked(&g_cpu_schedlock) || irq_cpu_locked(me))
+        {
+          break;
+        }
+
+      tcb = sched_balance_candidate();
+      if (tcb == NULL)
+        {
+          break;
+        }
+
+      /* Re-inserting the task at the same priority removes it from
+       * g_readytorun and assigns it to the CPU running the lowest priority
+       * task that it may run on, which must now be lower than its own.
+       * This may cause a context switch on this CPU.
+       */
+
+      tcb->nmigrations++;
+      up_reprioritize_rtr(tcb, tcb->sched_priority);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name:  sched_idle_balance
+ *
+ * Description:
+ *   Called from the IDLE loop of each CPU.  Performs sched_balance() no
+ *   more than once per tick per CPU.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_idle_balance(void)
+{
+  systime_t now = clock_systimer();
+  int me        = this_cpu();
+
+  if (g_readytorun.head != NULL && now != g_balance_lasttick[me])
+    {
+      g_balance_lasttick[me] = now;
+      sched_balance();
+    }
+}
+
+#endif /* CONFIG_SCHED_BALANCE */
@@ -273,6 +273,16 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
     }
 
   leave_critical_section(flags);
+
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Also return the exact CPU time of the thread */
+
+  if (ret == OK)
+    {
+      ret = clock_cputime(pid, &cpuload->runtime);
+    }
+#endif
+
   return ret;
 }
 
@@ -0,0 +1,245 @@
+/****************************************************************************
+ * sched/sched/sched_cputime.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_CPUTIME
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cputime_charge
+ *
+ * Description:
+ *   Add the time since the thread was switched in to its CPU time.
+ *
+ ****************************************************************************/
+
+static inline void cputime_charge(FAR struct tcb_s *tcb, uint32_t now)
+{
+  if (tcb->runstart != 0)
+    {
+      tcb->runtime += (uint32_t)(now - tcb->runstart);
+    }
+}
+
+/****************************************************************************
+ * Name: cputime_start
+ *
+ * Description:
+ *   Note when the thread was switched in.  Zero is reserved to mean that
+ *   the thread is not running.
+ *
+ ****************************************************************************/
+
+static inline void cputime_start(FAR struct tcb_s *tcb, uint32_t now)
+{
+  tcb->runstart = now != 0 ? now : 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cputime_resume
+ *
+ * Description:
+ *   Called from sched_resume_scheduler() when a thread is switched in.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is about to run.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_cputime_resume(FAR struct tcb_s *tcb)
+{
+  cputime_start(tcb, up_perf_gettime());
+}
+
+/****************************************************************************
+ * Name: sched_cputime_suspend
+ *
+ * Description:
+ *   Called from sched_suspend_scheduler() when a thread is switched out.
+ *   The time since the thread was switched in is charged to the thread.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is being suspended.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_cputime_suspend(FAR struct tcb_s *tcb)
+{
+  cputime_charge(tcb, up_perf_gettime());
+  tcb->runstart = 0;
+}
+
+/****************************************************************************
+ * Name: sched_process_cputime
+ *
+ * Description:
+ *   Called on each system timer tick.  The running thread on each CPU is
+ *   charged for the time used so far so that a long-running thread never
+ *   runs for more than one period of the 32-bit counter without being
+ *   charged.  This also starts the accounting for the threads that were
+ *   not started with a context switch (such as the IDLE threads).
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_process_cputime(void)
+{
+  FAR struct tcb_s *rtcb;
+  uint32_t now;
+
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+  int cpu;
+
+  /* Perform the accounting for all CPUs. */
+
+  flags = enter_critical_section();
+  now   = up_perf_gettime();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      rtcb = current_task(cpu);
+      cputime_charge(rtcb, now);
+      cputime_start(rtcb, now);
+    }
+
+  leave_critical_section(flags);
+#else
+  now  = up_perf_gettime();
+  rtcb = this_task();
+
+  cputime_charge(rtcb, now);
+  cputime_start(rtcb, now);
+#endif
+}
+
+/****************************************************************************
+ * Name:  clock_cputime
+ *
+ * Description:
+ *   Return the exact CPU time used by a thread.
+ *
+ * Parameters:
+ *   pid - The task ID of the thread of interest.  pid == 0 is the IDLE thread.
+ *   nsec - The location to return the CPU time in nanoseconds
+ *
+ * Return Value:
+ *   OK (0) on success; -ESRCH if 'pid' does not refer to a valid thread.
+ *
+ ****************************************************************************/
+
+int clock_cputime(int pid, FAR uint64_t *nsec)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  uint64_t counts;
+  uint32_t freq;
+
+  DEBUGASSERT(nsec != NULL);
+
+  /* The TCB must stay valid and the counts must be consistent while they
+   * are sampled.
+   */
+
+  flags = enter_critical_section();
+
+  tcb = sched_gettcb((pid_t)pid);
+  if (tcb == NULL)
+    {
+      leave_critical_section(flags);
+      return -ESRCH;
+    }
+
+  /* Include the time used so far if the thread is running now */
+
+  counts = tcb->runtime;
+  if (tcb->runstart != 0)
+    {
+      counts += (uint32_t)(up_perf_gettime() - tcb->runstart);
+    }
+
+  leave_critical_section(flags);
+
+  /* Convert counts to nanoseconds without overflowing 64 bits */
+
+  freq  = up_perf_getfreq();
+  *nsec = (counts / freq) * NSEC_PER_SEC +
+          ((counts % freq) * NSEC_PER_SEC) / freq;
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_CPUTIME */
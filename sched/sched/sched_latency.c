@@ -0,0 +1,268 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* System-wide histograms */
+
+static struct latency_hist_s g_schedlat;
+static struct latency_hist_s g_semwait;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_usec
+ *
+ * Description:
+ *   Convert the up_perf_gettime() count since start to microseconds.
+ *
+ ****************************************************************************/
+
+static uint32_t latency_usec(uint32_t start)
+{
+  uint32_t elapsed = up_perf_gettime() - start;
+  uint32_t freq = up_perf_getfreq();
+
+  /* Avoid the 64-bit division in the usual case of a counter clocked at a
+   * whole number of MHz.
+   */
+
+  if (freq >= 1000000 && (freq % 1000000) == 0)
+    {
+      return elapsed / (freq / 1000000);
+    }
+
+  return (uint32_t)(((uint64_t)elapsed * 1000000) / freq);
+}
+
+/****************************************************************************
+ * Name: latency_add
+ *
+ * Description:
+ *   Count one latency in the histogram.
+ *
+ ****************************************************************************/
+
+static void latency_add(FAR struct latency_hist_s *hist, uint32_t usec)
+{
+  uint32_t tmp = usec;
+  int ndx = 0;
+
+  /* Bucket n holds latencies in the range [2**(n-1), 2**n) */
+
+  while (tmp != 0 && ndx < CONFIG_SCHED_LATENCY_NBUCKETS - 1)
+    {
+      tmp >>= 1;
+      ndx++;
+    }
+
+  hist->lh_count[ndx]++;
+  if (usec > hist->lh_max)
+    {
+      hist->lh_max = usec;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_latency_ready
+ *
+ * Description:
+ *   Called from sched_addreadytorun() to note when a thread was made ready-
+ *   to-run.  A thread that is already waiting to run (for example, when it
+ *   is moved from the pending list or re-prioritized) keeps its original
+ *   time.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread being made ready-to-run.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void sched_latency_ready(FAR struct tcb_s *tcb)
+{
+  if (tcb->readytime == 0)
+    {
+      uint32_t now = up_perf_gettime();
+
+      /* Zero means no pending measurement */
+
+      tcb->readytime = now != 0 ? now : 1;
+    }
+}
+
+/****************************************************************************
+ * Name: sched_latency_resume
+ *
+ * Description:
+ *   Called from sched_resume_scheduler() when a thread runs.  If the thread
+ *   was made ready-to-run since it last ran, then the elapsed time is added
+ *   to the wake-up latency histograms.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is about to run.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void sched_latency_resume(FAR struct tcb_s *tcb)
+{
+  uint32_t usec;
+
+  if (tcb->readytime != 0)
+    {
+      usec           = latency_usec(tcb->readytime);
+      tcb->readytime = 0;
+
+      latency_add(&tcb->schedlat, usec);
+      latency_add(&g_schedlat, usec);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_latency_semwait
+ *
+ * Description:
+ *   Called from nxsem_wait() after the thread was blocked waiting for the
+ *   semaphore.  The time since start is added to the semaphore wait
+ *   histograms.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread that waited.
+ *   start - The up_perf_gettime() value when the thread blocked.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void sched_latency_semwait(FAR struct tcb_s *tcb, uint32_t start)
+{
+  uint32_t usec = latency_usec(start);
+
+  latency_add(&tcb->semwait, usec);
+  latency_add(&g_semwait, usec);
+}
+
+/****************************************************************************
+ * Name: sched_latency
+ *
+ * Description:
+ *   Return a snapshot of the wake-up latency and semaphore wait histograms
+ *   of one thread or of the whole system.
+ *
+ * Input Parameters:
+ *   pid      - The ID of the thread or a negative value for the system-wide
+ *              histograms.
+ *   schedlat - Location to return the wake-up latency histogram.
+ *   semwait  - Location to return the semaphore wait histogram.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ESRCH if there is no thread with this pid.
+ *
+ ****************************************************************************/
+
+int sched_latency(pid_t pid, FAR struct latency_hist_s *schedlat,
+                  FAR struct latency_hist_s *semwait)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+
+  if (pid < 0)
+    {
+      memcpy(schedlat, &g_schedlat, sizeof(struct latency_hist_s));
+      memcpy(semwait, &g_semwait, sizeof(struct latency_hist_s));
+    }
+  else
+    {
+      tcb = sched_gettcb(pid);
+      if (tcb != NULL)
+        {
+          memcpy(schedlat, &tcb->schedlat, sizeof(struct latency_hist_s));
+          memcpy(semwait, &tcb->semwait, sizeof(struct latency_hist_s));
+        }
+      else
+        {
+          ret = -ESRCH;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_LATENCY */
@@ -39,11 +39,16 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
@@ -57,6 +62,25 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* With CONFIG_SCHED_NOTE_PERCPU, there is one circular buffer per CPU.
+ * Each buffer has a single writer (its own CPU) and notes are never
+ * overwritten by the writer:  The writer only advances the head index and
+ * the reader only advances the tail index.  No lock is then needed between
+ * the writer and the reader.
+ */
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+#  define NOTE_NBUFFERS CONFIG_SMP_NCPUS
+#else
+#  define NOTE_NBUFFERS 1
+#endif
+
+/* Returned by note_bprintf_put() if there is no space for the argument.
+ * Zero cannot be used:  It is a valid length if nothing was stored yet.
+ */
+
+#define NOTE_BPRINTF_FULL ((size_t)-1)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -65,6 +89,9 @@ struct note_info_s
 {
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  unsigned long ni_dropped;     /* Number of notes lost because buffer full */
+#endif
   uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
 };
 
@@ -92,7 +119,15 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
+static struct note_info_s g_note_info[NOTE_NBUFFERS];
+
+#if defined(CONFIG_SCHED_NOTE_PERCPU) && defined(CONFIG_SCHED_NOTE_GET)
+/* Serializes readers.  This is deliberately not a spinlock_t handled by
+ * spin_lock():  That would generate spinlock notes for each note read.
+ */
+
+static volatile spinlock_t g_note_readlock;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -144,7 +179,11 @@ static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
 static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_PERFTIME
+  uint32_t systime    = up_perf_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -157,7 +196,9 @@ static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
   note->nc_pid[0]     = (uint8_t)(tcb->pid & 0xff);
   note->nc_pid[1]     = (uint8_t)((tcb->pid >> 8) & 0xff);
 
-  /* Save the LS 32-bits of the system timer in little endian order */
+  /* Save the LS 32-bits of the system timer (or of the high resolution
+   * counter) in little endian order
+   */
 
   note->nc_systime[0] = (uint8_t)( systime        & 0xff);
   note->nc_systime[1] = (uint8_t)((systime >> 8)  & 0xff);
@@ -205,17 +246,17 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-static unsigned int note_length(void)
+static unsigned int note_length(FAR struct note_info_s *info)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  unsigned int head = info->ni_head;
+  unsigned int tail = info->ni_tail;
 
   if (tail > head)
     {
@@ -232,17 +273,18 @@ static unsigned int note_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are within a critical section or, with CONFIG_SCHED_NOTE_PERCPU, we
+ *   are the only reader.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+static void note_remove(FAR struct note_info_s *info)
 {
   FAR struct note_common_s *note;
   unsigned int tail;
@@ -250,20 +292,20 @@ static void note_remove(void)
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note   = (FAR struct note_common_s *)&info->ni_buffer[tail];
   length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  DEBUGASSERT(length <= note_length(info));
 
   /* Increment the tail index to remove the entire note from the circular
    * buffer.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  info->ni_tail = note_next(tail, length);
 }
 
 /****************************************************************************
@@ -279,14 +321,20 @@ static void note_remove(void)
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are within a critical section (unless CONFIG_SCHED_NOTE_PERCPU is
+ *   selected).
  *
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
+  FAR struct note_info_s *info;
   unsigned int head;
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  irqstate_t flags;
+#else
   unsigned int next;
+#endif
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
@@ -299,6 +347,48 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
     }
 #endif
 
+  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  /* Each CPU writes only to its own buffer, so it is sufficient to disable
+   * local interrupts to keep nested notes from interleaving.  Other CPUs
+   * are not affected.
+   */
+
+  flags = up_irq_save();
+  info  = &g_note_info[this_cpu()];
+
+  /* If there is not enough space for the entire note, then drop it.  We
+   * cannot remove notes at the tail of the buffer because the reader owns
+   * the tail index.
+   */
+
+  if (notelen >= CONFIG_SCHED_NOTE_BUFSIZE - note_length(info))
+    {
+      info->ni_dropped++;
+      up_irq_restore(flags);
+      return;
+    }
+
+  /* Copy the note into the buffer beginning at the head index */
+
+  head = info->ni_head;
+  while (notelen > 0)
+    {
+      info->ni_buffer[head] = *note++;
+      head = note_next(head, 1);
+      notelen--;
+    }
+
+  /* Make sure that the note data is visible to the reader before the head
+   * index is updated.
+   */
+
+  SP_DMB();
+  info->ni_head = head;
+  up_irq_restore(flags);
+
+#else
   /* REVISIT: In the single CPU case, the following should be safe because
    * the logic is always called within a critical section, but in the SMP
    * case we have protection.  One option would be to precalculate and
@@ -312,13 +402,13 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
    * remove entries at the tail of the buffer as necessary to make certain
    * that there will be space for the new note at the beginning of the
    * buffer.  I am less certain that this can be done safely in the SMP
-   * case.
+   * case.  CONFIG_SCHED_NOTE_PERCPU avoids these problems.
    */
 
   /* Get the index to the head of the circular buffer */
 
-  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
+  info = &g_note_info[0];
+  head = info->ni_head;
 
   /* Loop until all bytes have been transferred to the circular buffer */
 
@@ -329,24 +419,376 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
        */
 
       next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
+      if (next == info->ni_tail)
         {
           /* Yes, then remove the note at the tail index */
 
-          note_remove();
+          note_remove(info);
         }
 
       /* Save the next byte at the head index */
 
-      g_note_info.ni_buffer[head] = *note++;
+      info->ni_buffer[head] = *note++;
 
       head = next;
       notelen--;
     }
 
-  g_note_info.ni_head = head;
+  info->ni_head = head;
+#endif
 }
 
+/****************************************************************************
+ * Name: note_select
+ *
+ * Description:
+ *   Select the circular buffer from which the next note will be read.
+ *   With CONFIG_SCHED_NOTE_PERCPU, this is the buffer with the oldest note
+ *   at its tail so that the notes from all CPUs are merged in time order.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The selected buffer or NULL if all buffers are empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static FAR struct note_info_s *note_select(void)
+{
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  FAR struct note_info_s *selected = NULL;
+  uint32_t oldest = 0;
+  uint32_t systime;
+  unsigned int ndx;
+  int cpu;
+  int i;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct note_info_s *info = &g_note_info[cpu];
+
+      if (note_length(info) == 0)
+        {
+          continue;
+        }
+
+      /* The note data was written before the head index was updated */
+
+      SP_DMB();
+
+      /* The note may wrap around the end of the circular buffer, so the
+       * timestamp must be gathered one byte at a time.
+       */
+
+      ndx     = note_next(info->ni_tail,
+                          offsetof(struct note_common_s, nc_systime));
+      systime = 0;
+
+      for (i = 0; i < 4; i++)
+        {
+          systime |= (uint32_t)info->ni_buffer[ndx] << (8 * i);
+          ndx      = note_next(ndx, 1);
+        }
+
+      /* The timestamps wrap around so compare the signed difference */
+
+      if (selected == NULL || (int32_t)(systime - oldest) < 0)
+        {
+          selected = info;
+          oldest   = systime;
+        }
+    }
+
+  return selected;
+#else
+  return note_length(&g_note_info[0]) > 0 ? &g_note_info[0] : NULL;
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: note_lock and note_unlock
+ *
+ * Description:
+ *   Serialize readers of the circular buffer(s).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static irqstate_t note_lock(void)
+{
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  irqstate_t flags = up_irq_save();
+
+  while (up_testset(&g_note_readlock) == SP_LOCKED)
+    {
+      SP_DSB();
+    }
+
+  SP_DMB();
+  return flags;
+#else
+  return enter_critical_section();
+#endif
+}
+
+static void note_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  SP_DMB();
+  g_note_readlock = SP_UNLOCKED;
+  up_irq_restore(flags);
+#else
+  leave_critical_section(flags);
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: note_bprintf_put
+ *
+ * Description:
+ *   Append one raw argument value to the binary printf note data.
+ *
+ * Input Parameters:
+ *   data    - The note data buffer
+ *   size    - The size of the note data buffer
+ *   len     - The number of bytes already in the buffer
+ *   arg     - The argument value to append
+ *   argsize - The size of the argument value
+ *
+ * Returned Value:
+ *   The new length of the data on success; NOTE_BPRINTF_FULL if there is
+ *   no space for the argument.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+static size_t note_bprintf_put(FAR uint8_t *data, size_t size, size_t len,
+                               FAR const void *arg, size_t argsize)
+{
+  if (len + argsize > size)
+    {
+      return NOTE_BPRINTF_FULL;
+    }
+
+  memcpy(&data[len], arg, argsize);
+  return len + argsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_bprintf_args
+ *
+ * Description:
+ *   Scan the format string and copy the raw argument values into the
+ *   binary printf note data.  The scan only identifies the type of each
+ *   argument; no formatting is performed.  The decoder must scan the
+ *   format string in the same way to recover the arguments.
+ *
+ * Input Parameters:
+ *   data - The note data buffer
+ *   size - The size of the note data buffer
+ *   fmt  - The printf-style format string
+ *   ap   - The argument list
+ *
+ * Returned Value:
+ *   The number of bytes of argument data.  Arguments that do not fit are
+ *   silently dropped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+static size_t note_bprintf_args(FAR uint8_t *data, size_t size,
+                                FAR const IPTR char *fmt, va_list ap)
+{
+  FAR const char *str;
+  size_t newlen;
+  size_t len = 0;
+  size_t slen;
+  int nlong;
+  int ch;
+
+  while ((ch = *fmt++) != '\0')
+    {
+      if (ch != '%')
+        {
+          continue;
+        }
+
+      /* Skip over the flags, field width, and precision.  A '*' field
+       * width or precision consumes an int argument.
+       */
+
+      while ((ch = *fmt) != '\0' &&
+             (strchr("-+ #0123456789.", ch) != NULL || ch == '*'))
+        {
+          if (ch == '*')
+            {
+              int value = va_arg(ap, int);
+              newlen = note_bprintf_put(data, size, len, &value,
+                                        sizeof(int));
+              if (newlen == NOTE_BPRINTF_FULL)
+                {
+                  return len;
+                }
+
+              len = newlen;
+            }
+
+          fmt++;
+        }
+
+      /* Length modifiers.  'z', 'j', and 't' are treated like 'l' or 'll'
+       * based on the size of the type.  'h' and 'hh' arguments are promoted
+       * to int.  'L' (long double) is not supported.
+       */
+
+      nlong = 0;
+      while ((ch = *fmt) != '\0' && strchr("hlzjtL", ch) != NULL)
+        {
+          if (ch == 'l')
+            {
+              nlong++;
+            }
+          else if (ch == 'z' || ch == 't')
+            {
+              nlong = sizeof(size_t) == sizeof(long) ? 1 : 2;
+            }
+          else if (ch == 'j')
+            {
+              nlong = 2;
+            }
+          else if (ch == 'L')
+            {
+              nlong = 3;
+            }
+
+          fmt++;
+        }
+
+      /* Then the conversion itself */
+
+      ch = *fmt++;
+      switch (ch)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+            if (nlong == 0)
+              {
+                int value = va_arg(ap, int);
+                newlen = note_bprintf_put(data, size, len, &value,
+                                          sizeof(int));
+              }
+            else if (nlong == 1)
+              {
+                long value = va_arg(ap, long);
+                newlen = note_bprintf_put(data, size, len, &value,
+                                          sizeof(long));
+              }
+            else
+              {
+                long long value = va_arg(ap, long long);
+                newlen = note_bprintf_put(data, size, len, &value,
+                                          sizeof(long long));
+              }
+            break;
+
+          case 'p':
+            {
+              uintptr_t value = (uintptr_t)va_arg(ap, FAR void *);
+              newlen = note_bprintf_put(data, size, len, &value,
+                                        sizeof(uintptr_t));
+            }
+            break;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            if (nlong == 3)
+              {
+                /* long double is not supported */
+
+                return len;
+              }
+
+            {
+              double value = va_arg(ap, double);
+              newlen = note_bprintf_put(data, size, len, &value,
+                                        sizeof(double));
+            }
+            break;
+
+          case 's':
+            {
+              /* Copy the string (including the NUL terminator), truncating
+               * it if necessary.
+               */
+
+              str = va_arg(ap, FAR const char *);
+              if (str == NULL)
+                {
+                  str = "(null)";
+                }
+
+              if (len + 1 >= size)
+                {
+                  return len;
+                }
+
+              slen = strlen(str);
+              if (slen > size - len - 1)
+                {
+                  slen = size - len - 1;
+                }
+
+              memcpy(&data[len], str, slen);
+              data[len + slen] = '\0';
+              newlen = len + slen + 1;
+            }
+            break;
+
+          case 'n':
+            (void)va_arg(ap, FAR void *);
+            newlen = len;
+            break;
+
+          case '%':
+            newlen = len;
+            break;
+
+          default:
+            /* End of the format string or an unsupported conversion:  We
+             * cannot know how to continue.
+             */
+
+            return len;
+        }
+
+      if (newlen == NOTE_BPRINTF_FULL)
+        {
+          return len;
+        }
+
+      len = newlen;
+    }
+
+  return len;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -567,6 +1009,109 @@ void sched_note_csection(FAR struct tcb_s *tcb, bool enter)
 }
 #endif
 
+/****************************************************************************
+ * Name: sched_note_bprintf and sched_note_vbprintf
+ *
+ * Description:
+ *   Add a binary printf-style note to the instrumentation buffer.  Only the
+ *   address of the format string and the raw argument values are recorded;
+ *   formatting is deferred until the note is read out.
+ *
+ * Input Parameters:
+ *   level - The SYSLOG priority of the message (LOG_EMERG..LOG_DEBUG).
+ *   fmt   - The printf-style format string.
+ *   ap    - The argument list.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from any context.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_BPRINTF
+void sched_note_vbprintf(uint8_t level, FAR const IPTR char *fmt,
+                         va_list ap)
+{
+  uint8_t buffer[UINT8_MAX];
+  FAR struct note_bprintf_s *note = (FAR struct note_bprintf_s *)buffer;
+  uintptr_t addr = (uintptr_t)fmt;
+#ifndef CONFIG_SCHED_NOTE_PERCPU
+  irqstate_t flags;
+#endif
+  size_t length;
+  int i;
+
+  /* Copy the raw arguments into the note.  This does not require the
+   * critical section.
+   */
+
+  length = note_bprintf_args(note->nbp_data,
+                             sizeof(buffer) - SIZEOF_NOTE_BPRINTF(0),
+                             fmt, ap);
+  length = SIZEOF_NOTE_BPRINTF(length);
+
+  /* Save the format string address in little endian order */
+
+  note->nbp_level = level;
+  for (i = 0; i < sizeof(uintptr_t); i++)
+    {
+      note->nbp_fmt[i] = (uint8_t)(addr & 0xff);
+      addr >>= 8;
+    }
+
+  /* Format the common fields and add the note to circular buffer.  The
+   * per-CPU buffers need no critical section.
+   */
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  note_common(this_task(), &note->nbp_cmn, (uint8_t)length, NOTE_BPRINTF);
+  note_add(buffer, (uint8_t)length);
+#else
+  flags = enter_critical_section();
+  note_common(this_task(), &note->nbp_cmn, (uint8_t)length, NOTE_BPRINTF);
+  note_add(buffer, (uint8_t)length);
+  leave_critical_section(flags);
+#endif
+}
+
+void sched_note_bprintf(uint8_t level, FAR const IPTR char *fmt, ...)
+{
+  va_list ap;
+
+  va_start(ap, fmt);
+  sched_note_vbprintf(level, fmt, ap);
+  va_end(ap);
+}
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+void sched_note_irqhandler(int irq, FAR void *handler, bool enter)
+{
+  struct note_irqhandler_s note;
+  uintptr_t addr = (uintptr_t)handler;
+  int i;
+
+  /* Format the note */
+
+  note_common(this_task(), &note.nih_cmn, sizeof(struct note_irqhandler_s),
+              enter ? NOTE_IRQ_ENTER : NOTE_IRQ_LEAVE);
+
+  for (i = 0; i < sizeof(uintptr_t); i++)
+    {
+      note.nih_handler[i] = (uint8_t)(addr & 0xff);
+      addr >>= 8;
+    }
+
+  note.nih_irq = (uint8_t)irq;
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, sizeof(struct note_irqhandler_s));
+}
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
 void sched_note_spinlock(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 {
@@ -609,35 +1154,35 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
+  FAR struct note_info_s *info;
   FAR struct note_common_s *note;
   irqstate_t flags;
   unsigned int remaining;
   unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
+  flags = note_lock();
 
   /* Verify that the circular buffer is not empty */
 
-  circlen = note_length();
-  if (circlen <= 0)
+  info = note_select();
+  if (info == NULL)
     {
       notelen = 0;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
   /* Get the index to the tail of the circular buffer */
 
-  tail    = g_note_info.ni_tail;
+  tail    = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note    = (FAR struct note_common_s *)&info->ni_buffer[tail];
   notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  DEBUGASSERT(notelen <= note_length(info));
 
   /* Is the user buffer large enough to hold the note? */
 
@@ -645,12 +1190,12 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Remove the large note so that we do not get constipated. */
 
-      note_remove();
+      note_remove(info);
 
       /* and return an error */
 
       notelen = -EFBIG;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
   /* Loop until the note has been transferred to the user buffer */
@@ -660,7 +1205,7 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Copy the next byte at the tail index */
 
-      *buffer++ = g_note_info.ni_buffer[tail];
+      *buffer++ = info->ni_buffer[tail];
 
       /* Adjust indices and counts */
 
@@ -668,10 +1213,17 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
       remaining--;
     }
 
-  g_note_info.ni_tail = tail;
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  /* The note data must be read before the space is returned to the
+   * writer.
+   */
 
-errout_with_csection:
-  leave_critical_section(flags);
+  SP_DMB();
+#endif
+  info->ni_tail = tail;
+
+errout_with_lock:
+  note_unlock(flags);
   return notelen;
 }
 #endif
@@ -694,38 +1246,68 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
+  FAR struct note_info_s *info;
   FAR struct note_common_s *note;
   irqstate_t flags;
   unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
 
-  flags = enter_critical_section();
+  flags = note_lock();
 
   /* Verify that the circular buffer is not empty */
 
-  circlen = note_length();
-  if (circlen <= 0)
+  info = note_select();
+  if (info == NULL)
     {
       notelen = 0;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
   /* Get the index to the tail of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note    = (FAR struct note_common_s *)&info->ni_buffer[tail];
   notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  DEBUGASSERT(notelen <= note_length(info));
 
-errout_with_csection:
-  leave_critical_section(flags);
+errout_with_lock:
+  note_unlock(flags);
   return notelen;
 }
 #endif
 
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were discarded because a per-CPU note
+ *   buffer was full.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of notes dropped on all CPUs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+unsigned long sched_note_dropped(void)
+{
+  unsigned long dropped = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < NOTE_NBUFFERS; cpu++)
+    {
+      dropped += g_note_info[cpu].ni_dropped;
+    }
+
+  return dropped;
+}
+#endif
+
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
@@ -46,6 +46,11 @@
 #  include <nuttx/arch.h>
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_ARCH_HAVE_PROFILE_TIMER)
+#  include <nuttx/arch.h>
+#  include <nuttx/sched_profile.h>
+#endif
+
 #include "sched/sched.h"
 #include "wdog/wdog.h"
 #include "clock/clock.h"
@@ -153,6 +158,36 @@ static inline void sched_process_scheduler(void)
 #  define sched_process_scheduler()
 #endif
 
+/****************************************************************************
+ * Name:  sched_process_balance
+ *
+ * Description:
+ *   Periodically pull stranded ready-to-run tasks onto idle or lower
+ *   priority CPUs.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_BALANCE
+static inline void sched_process_balance(void)
+{
+  static unsigned int ticks;
+
+  if (++ticks >= CONFIG_SCHED_BALANCE_INTERVAL)
+    {
+      ticks = 0;
+      sched_balance();
+    }
+}
+#else
+#  define sched_process_balance()
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -185,6 +220,12 @@ static inline void sched_process_scheduler(void)
 
 void sched_process_timer(void)
 {
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_ARCH_HAVE_PROFILE_TIMER)
+  /* Sample the interrupted program counter for the profiler */
+
+  sched_profile_sample(up_profile_pc());
+#endif
+
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   /* Process wall time */
 
@@ -200,6 +241,12 @@ void sched_process_timer(void)
       clock_timer();
     }
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Charge CPU time to the running threads */
+
+  sched_process_cputime();
+#endif
+
 #if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK)
   /* Perform CPU load measurements (before any timer-initiated context
    * switches can occur)
@@ -222,4 +269,8 @@ void sched_process_timer(void)
    */
 
   sched_process_scheduler();
+
+  /* Check for tasks that could be running on an idle CPU */
+
+  sched_process_balance();
 }
@@ -0,0 +1,383 @@
+/****************************************************************************
+ * sched/sched/sched_profile.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/sched_profile.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* There is one circular sample buffer per CPU.  Each buffer has a single
+ * writer (the timer interrupt on its own CPU) that only advances the head
+ * index and readers only advance the tail index, so the writer never has
+ * to wait for a reader.  The buffer is full when advancing the head would
+ * make it equal to the tail.
+ */
+
+#ifdef CONFIG_SMP
+#  define PROFILE_NBUFFERS CONFIG_SMP_NCPUS
+#else
+#  define PROFILE_NBUFFERS 1
+#endif
+
+#define PROFILE_NENTRIES (CONFIG_SCHED_PROFILE_NSAMPLES + 1)
+
+/* The entries are volatile so that the compiler keeps the accesses to an
+ * entry ordered with respect to the head and tail updates.  On SMP, the
+ * hardware must also be told.
+ */
+
+#ifdef CONFIG_SPINLOCK
+#  define PROFILE_DMB() SP_DMB()
+#else
+#  define PROFILE_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct profile_entry_s
+{
+  uintptr_t pe_pc;                /* Interrupted program counter */
+  pid_t pe_pid;                   /* ID of the interrupted task */
+};
+
+struct profile_info_s
+{
+  volatile unsigned int pi_head;  /* Next entry written by the CPU */
+  volatile unsigned int pi_tail;  /* Next entry to be read */
+  unsigned long pi_dropped;       /* Samples lost because buffer full */
+  volatile bool pi_busy;          /* The CPU is recording a sample */
+  volatile struct profile_entry_s pi_entry[PROFILE_NENTRIES];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct profile_info_s g_profile_info[PROFILE_NBUFFERS];
+
+/* Sampling is enabled when the system boots */
+
+static volatile bool g_profile_enabled = true;
+
+#ifdef CONFIG_SMP
+/* Serializes readers on different CPUs */
+
+static volatile spinlock_t g_profile_lock SP_SECTION = SP_UNLOCKED;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_next
+ *
+ * Description:
+ *   Return the circular buffer index following ndx, handling wraparound.
+ *
+ ****************************************************************************/
+
+static inline unsigned int profile_next(unsigned int ndx)
+{
+  return ++ndx >= PROFILE_NENTRIES ? 0 : ndx;
+}
+
+/****************************************************************************
+ * Name: profile_lock and profile_unlock
+ *
+ * Description:
+ *   Serialize the readers of the sample buffers.  The writers do not
+ *   participate.
+ *
+ ****************************************************************************/
+
+static inline void profile_lock(void)
+{
+  sched_lock();
+#ifdef CONFIG_SMP
+  spin_lock(&g_profile_lock);
+#endif
+}
+
+static inline void profile_unlock(void)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&g_profile_lock);
+#endif
+  sched_unlock();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Record one profiler sample:  The interrupted program counter and the
+ *   ID of the task running on this CPU.  This is called from
+ *   sched_process_timer() or, if CONFIG_ARCH_HAVE_PROFILE_TIMER is selected,
+ *   from the architecture's profiling timer.
+ *
+ * Input Parameters:
+ *   pc - The interrupted program counter.  Zero values are ignored.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt.  Never called concurrently on the
+ *   same CPU.
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(uintptr_t pc)
+{
+  FAR struct profile_info_s *info;
+  FAR volatile struct profile_entry_s *entry;
+  unsigned int head;
+  unsigned int next;
+  int cpu;
+
+  if (pc == 0)
+    {
+      return;
+    }
+
+  cpu  = this_cpu();
+  info = &g_profile_info[cpu];
+
+  /* Let sched_profile_start() know that this buffer is being modified.
+   * The flag must be visible before sampling enabled state is checked.
+   */
+
+  info->pi_busy = true;
+  PROFILE_DMB();
+
+  if (g_profile_enabled)
+    {
+      head = info->pi_head;
+      next = profile_next(head);
+
+      if (next == info->pi_tail)
+        {
+          info->pi_dropped++;
+        }
+      else
+        {
+          entry         = &info->pi_entry[head];
+          entry->pe_pc  = pc;
+          entry->pe_pid = this_task()->pid;
+
+          /* Make sure that the entry is visible before the updated head */
+
+          PROFILE_DMB();
+          info->pi_head = next;
+        }
+    }
+
+  PROFILE_DMB();
+  info->pi_busy = false;
+}
+
+/****************************************************************************
+ * Name: sched_profile_start and sched_profile_stop
+ *
+ * Description:
+ *   sched_profile_start() discards all buffered samples and starts
+ *   sampling.  sched_profile_stop() stops sampling.
+ *
+ ****************************************************************************/
+
+void sched_profile_start(void)
+{
+  FAR struct profile_info_s *info;
+  int cpu;
+
+  profile_lock();
+
+  /* Disable sampling.  Any CPU that did not see the change is still
+   * recording a sample and must be allowed to finish before its buffer is
+   * reset.
+   */
+
+  g_profile_enabled = false;
+  PROFILE_DMB();
+
+  for (cpu = 0; cpu < PROFILE_NBUFFERS; cpu++)
+    {
+      info = &g_profile_info[cpu];
+      while (info->pi_busy)
+        {
+        }
+
+      info->pi_head    = 0;
+      info->pi_tail    = 0;
+      info->pi_dropped = 0;
+    }
+
+  /* Make sure that the reset buffers are visible before sampling resumes */
+
+  PROFILE_DMB();
+  g_profile_enabled = true;
+  profile_unlock();
+}
+
+void sched_profile_stop(void)
+{
+  g_profile_enabled = false;
+}
+
+/****************************************************************************
+ * Name: sched_profile_get
+ *
+ * Description:
+ *   Remove the oldest buffered samples, taking them from each CPU's buffer
+ *   in turn.
+ *
+ * Input Parameters:
+ *   samples  - Location to return the samples
+ *   nsamples - The maximum number of samples to return
+ *
+ * Returned Value:
+ *   The number of samples returned.  Zero is returned if no samples are
+ *   buffered.
+ *
+ ****************************************************************************/
+
+size_t sched_profile_get(FAR struct profile_sample_s *samples,
+                         size_t nsamples)
+{
+  FAR struct profile_info_s *info;
+  FAR volatile struct profile_entry_s *entry;
+  unsigned int tail;
+  uintptr_t pc;
+  size_t count = 0;
+  bool more = true;
+  int cpu;
+  int i;
+
+  profile_lock();
+
+  while (more && count < nsamples)
+    {
+      more = false;
+
+      for (cpu = 0; cpu < PROFILE_NBUFFERS && count < nsamples; cpu++)
+        {
+          info = &g_profile_info[cpu];
+          tail = info->pi_tail;
+
+          if (tail == info->pi_head)
+            {
+              continue;
+            }
+
+          /* Make sure that the entry is read after the head */
+
+          PROFILE_DMB();
+
+          entry = &info->pi_entry[tail];
+          pc    = entry->pe_pc;
+
+          for (i = 0; i < sizeof(uintptr_t); i++)
+            {
+              samples->ps_pc[i] = (uint8_t)(pc & 0xff);
+              pc >>= 8;
+            }
+
+          samples->ps_pid[0] = (uint8_t)(entry->pe_pid & 0xff);
+          samples->ps_pid[1] = (uint8_t)((entry->pe_pid >> 8) & 0xff);
+          samples->ps_cpu    = (uint8_t)cpu;
+
+          /* The entry may now be reused by the writer */
+
+          PROFILE_DMB();
+          info->pi_tail = profile_next(tail);
+
+          samples++;
+          count++;
+          more = true;
+        }
+    }
+
+  profile_unlock();
+  return count;
+}
+
+/****************************************************************************
+ * Name: sched_profile_dropped
+ *
+ * Description:
+ *   Return the number of samples that were discarded because a sample
+ *   buffer was full.
+ *
+ ****************************************************************************/
+
+unsigned long sched_profile_dropped(void)
+{
+  unsigned long dropped = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < PROFILE_NBUFFERS; cpu++)
+    {
+      dropped += g_profile_info[cpu].pi_dropped;
+    }
+
+  return dropped;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
@@ -48,7 +48,8 @@
 #include "sched/sched.h"
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
-    defined(CONFIG_SCHED_INSTRUMENTATION)
+    defined(CONFIG_SCHED_INSTRUMENTATION) || defined(CONFIG_SCHED_SWITCHCOUNT) || \
+    defined(CONFIG_SCHED_LATENCY) || defined(CONFIG_SCHED_CPUTIME)
 
 /****************************************************************************
  * Public Functions
@@ -95,6 +96,24 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
     }
 #endif
 
+#ifdef CONFIG_SCHED_SWITCHCOUNT
+  /* Count the context switch */
+
+  tcb->nswitches++;
+#endif
+
+#ifdef CONFIG_SCHED_LATENCY
+  /* Measure the latency since the task was made ready-to-run */
+
+  sched_latency_resume(tcb);
+#endif
+
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Start charging CPU time to the task */
+
+  sched_cputime_resume(tcb);
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   /* Inidicate the task has been resumed */
 
@@ -104,4 +123,5 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
 }
 
 #endif /* CONFIG_RR_INTERVAL > 0 || CONFIG_SCHED_SPORADIC || \
-        * CONFIG_SCHED_INSTRUMENTATION */
+        * CONFIG_SCHED_INSTRUMENTATION || CONFIG_SCHED_SWITCHCOUNT || \
+        * CONFIG_SCHED_LATENCY || CONFIG_SCHED_CPUTIME */
@@ -50,7 +50,8 @@
 #include "clock/clock.h"
 #include "sched/sched.h"
 
-#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION)
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_LATENCY) || defined(CONFIG_SCHED_CPUTIME)
 
 /****************************************************************************
  * Public Functions
@@ -88,6 +89,21 @@ void sched_suspend_scheduler(FAR struct tcb_s *tcb)
 
   sched_note_suspend(tcb);
 #endif
+
+#ifdef CONFIG_SCHED_LATENCY
+  /* A thread that is switched out before it was measured (such as a
+   * running thread that was re-prioritized) has no wake-up latency.
+   */
+
+  sched_latency_suspend(tcb);
+#endif
+
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Charge the CPU time used since the task was switched in */
+
+  sched_cputime_suspend(tcb);
+#endif
 }
 
-#endif /* CONFIG_SCHED_SPORADIC || CONFIG_SCHED_INSTRUMENTATION */
+#endif /* CONFIG_SCHED_SPORADIC || CONFIG_SCHED_INSTRUMENTATION || \
+        * CONFIG_SCHED_LATENCY || CONFIG_SCHED_CPUTIME */
@@ -346,6 +346,12 @@ static unsigned int sched_timer_process(unsigned int ticks, bool noswitches)
   unsigned int rettime  = 0;
   unsigned int tmp;
 
+#ifdef CONFIG_SCHED_CPUTIME
+  /* Charge CPU time to the running threads */
+
+  sched_process_cputime();
+#endif
+
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   /* Process wall time */
 
@@ -0,0 +1,171 @@
+/****************************************************************************
+ * sched/semaphore/sem_futex.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_SEM_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_futexwait
+ *
+ * Description:
+ *   The kernel slow path of the user-space sem_wait().  The user-space
+ *   logic was unable to take a count with compare-and-exchange so the
+ *   caller must (probably) block.  The semaphore's own wait list is the
+ *   wait queue associated with the user address 'sem'.
+ *
+ *   NOTE:  A sem_post() may have given a count after the user-space test
+ *   but before this system call.  So the count is re-examined with
+ *   nxsem_trywait() and, only if that fails, the caller blocks in
+ *   nxsem_wait().  Both happen inside of one critical section.  On a
+ *   single CPU, the user-space compare-and-exchange cannot run while the
+ *   critical section is held, so the count cannot change between the
+ *   re-check and the decision to block and no wakeup can be lost.
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   See sem_wait().
+ *
+ ****************************************************************************/
+
+int sem_futexwait(FAR sem_t *sem)
+{
+  irqstate_t flags;
+  int errcode;
+  int ret;
+
+  /* sem_futexwait() is a cancellation point */
+
+  if (enter_cancellation_point())
+    {
+#ifdef CONFIG_CANCELLATION_POINTS
+      /* If there is a pending cancellation, then do not perform
+       * the wait.  Exit now with ECANCELED.
+       */
+
+      errcode = ECANCELED;
+      goto errout_with_cancelpt;
+#endif
+    }
+
+  /* Re-check the count, then block if it is still not available */
+
+  flags = enter_critical_section();
+
+  ret = nxsem_trywait(sem);
+  if (ret == -EAGAIN)
+    {
+      ret = nxsem_wait(sem);
+    }
+
+  leave_critical_section(flags);
+
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_cancelpt;
+    }
+
+  leave_cancellation_point();
+  return OK;
+
+errout_with_cancelpt:
+  set_errno(errcode);
+  leave_cancellation_point();
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: sem_futextrywait
+ *
+ * Description:
+ *   The kernel slow path of the user-space sem_trywait().  This is used
+ *   when the semaphore does not appear to be available (so that the
+ *   errno value is set by the OS) or when the semaphore participates in
+ *   priority inheritance (so that the holder is recorded).
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   See sem_trywait().
+ *
+ ****************************************************************************/
+
+int sem_futextrywait(FAR sem_t *sem)
+{
+  return sem_trywait(sem);
+}
+
+/****************************************************************************
+ * Name: sem_futexwake
+ *
+ * Description:
+ *   The kernel slow path of the user-space sem_post().  This is used when
+ *   the semaphore count is negative, i.e., when there is at least one
+ *   thread waiting on the semaphore that must be awakened, or when the
+ *   semaphore participates in priority inheritance.
+ *
+ * Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Return Value:
+ *   See sem_post().
+ *
+ ****************************************************************************/
+
+int sem_futexwake(FAR sem_t *sem)
+{
+  return sem_post(sem);
+}
+
+#endif /* CONFIG_SEM_FASTPATH */
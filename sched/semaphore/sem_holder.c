@@ -39,11 +39,17 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <semaphore.h>
 #include <sched.h>
 #include <assert.h>
 #include <debug.h>
+
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -60,6 +66,24 @@
 #  define CONFIG_SEM_PREALLOCHOLDERS 0
 #endif
 
+/* When the number of free holder containers falls below SEM_HOLDER_RESERVE,
+ * work is queued to allocate SEM_HOLDER_NALLOC more from the heap.  The
+ * reserve guarantees that the heap semaphore itself can be taken while the
+ * holders are being allocated.  Without a work queue, the pool cannot grow.
+ */
+
+#if CONFIG_SEM_PREALLOCHOLDERS > 0 && defined(CONFIG_SCHED_WORKQUEUE)
+#  define SEM_HOLDER_GROW    1
+#  define SEM_HOLDER_RESERVE 4
+#  define SEM_HOLDER_NALLOC  8
+
+#  ifdef CONFIG_SCHED_LPWORK
+#    define SEM_HOLDER_WORK  LPWORK
+#  else
+#    define SEM_HOLDER_WORK  HPWORK
+#  endif
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -76,13 +100,66 @@ typedef int (*holderhandler_t)(FAR struct semholder_s *pholder,
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
 static FAR struct semholder_s *g_freeholders;
+static int g_nfreeholders;
+#endif
+
+/* Used to refill the holder pool from the work queue */
+
+#ifdef SEM_HOLDER_GROW
+static struct work_s g_holderwork;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_growholders
+ *
+ * Description:
+ *   Runs on the work queue when the number of free holder containers is
+ *   low and allocates more from the heap.  Holder containers allocated in
+ *   this way are never returned to the heap; the pool only grows to its
+ *   high water mark.
+ *
+ ****************************************************************************/
+
+#ifdef SEM_HOLDER_GROW
+static void nxsem_growholders(FAR void *arg)
+{
+  FAR struct semholder_s *alloc;
+  irqstate_t flags;
+  int i;
+
+  /* kmm_zalloc() will take the heap semaphore.  If that must wait, then
+   * the holder container will be taken from the reserve.
+   */
+
+  alloc = (FAR struct semholder_s *)
+    kmm_zalloc(SEM_HOLDER_NALLOC * sizeof(struct semholder_s));
+
+  if (alloc != NULL)
+    {
+      for (i = 0; i < (SEM_HOLDER_NALLOC - 1); i++)
+        {
+          alloc[i].flink = &alloc[i + 1];
+        }
+
+      flags = enter_critical_section();
+      alloc[SEM_HOLDER_NALLOC - 1].flink = g_freeholders;
+      g_freeholders   = alloc;
+      g_nfreeholders += SEM_HOLDER_NALLOC;
+      leave_critical_section(flags);
+    }
+}
 #endif
 
 /****************************************************************************
  * Name: nxsem_allocholder
  ****************************************************************************/
 
-static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
+static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem,
+                                                        FAR struct tcb_s *htcb)
 {
   FAR struct semholder_s *pholder;
 
@@ -100,23 +177,29 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
        */
 
       g_freeholders    = pholder->flink;
+      g_nfreeholders--;
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
 
-      /* Make sure the initial count is zero */
+#ifdef SEM_HOLDER_GROW
+      /* Refill the pool from the work queue if it is running low */
 
-      pholder->counts  = 0;
+      if (g_nfreeholders < SEM_HOLDER_RESERVE &&
+          work_available(&g_holderwork))
+        {
+          (void)work_queue(SEM_HOLDER_WORK, &g_holderwork,
+                           nxsem_growholders, NULL, 0);
+        }
+#endif
     }
 #else
   if (sem->holder[0].htcb == NULL)
     {
       pholder          = &sem->holder[0];
-      pholder->counts  = 0;
     }
   else if (sem->holder[1].htcb == NULL)
     {
       pholder          = &sem->holder[1];
-      pholder->counts  = 0;
     }
 #endif
   else
@@ -126,6 +209,21 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
     }
 
   DEBUGASSERT(pholder != NULL);
+  if (pholder != NULL)
+    {
+      /* Make sure the initial count is zero and add the holder to the
+       * head of list of semaphores held by the thread.  Semaphores are
+       * usually released in the reverse order that they were taken so the
+       * holder will usually still be at the head of list when it is freed.
+       */
+
+      pholder->htcb     = htcb;
+      pholder->counts   = 0;
+      pholder->waitprio = 0;
+      pholder->tlink    = htcb->holdsem;
+      htcb->holdsem     = pholder;
+    }
+
   return pholder;
 }
 
@@ -185,7 +283,7 @@ nxsem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
   FAR struct semholder_s *pholder = nxsem_findholder(sem, htcb);
   if (!pholder)
     {
-      pholder = nxsem_allocholder(sem);
+      pholder = nxsem_allocholder(sem, htcb);
     }
 
   return pholder;
@@ -198,15 +296,39 @@ nxsem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
 static inline void nxsem_freeholder(sem_t *sem,
                                     FAR struct semholder_s *pholder)
 {
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
+  FAR struct tcb_s *htcb = pholder->htcb;
   FAR struct semholder_s *curr;
   FAR struct semholder_s *prev;
-#endif
+
+  /* Remove the holder from the list of semaphores held by the thread.  That
+   * list can be accessed only if the thread still exists.
+   */
+
+  if (htcb != NULL && sched_verifytcb(htcb))
+    {
+      for (prev = NULL, curr = htcb->holdsem;
+           curr && curr != pholder;
+           prev = curr, curr = curr->tlink);
+
+      if (curr != NULL)
+        {
+          if (prev != NULL)
+            {
+              prev->tlink = pholder->tlink;
+            }
+          else
+            {
+              htcb->holdsem = pholder->tlink;
+            }
+        }
+    }
 
   /* Release the holder and counts */
 
-  pholder->htcb   = NULL;
-  pholder->counts = 0;
+  pholder->tlink    = NULL;
+  pholder->htcb     = NULL;
+  pholder->counts   = 0;
+  pholder->waitprio = 0;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   /* Search the list for the matching holder */
@@ -232,6 +354,7 @@ static inline void nxsem_freeholder(sem_t *sem,
 
       pholder->flink = g_freeholders;
       g_freeholders  = pholder;
+      g_nfreeholders++;
     }
 #endif
 }
@@ -289,7 +412,7 @@ static int nxsem_foreachholder(FAR sem_t *sem, holderhandler_t handler,
 
   /* We have two hard-allocated holder structures in sem_t */
 
-  for (i = 0; i < 2; i++)
+  for (i = 0; i < 2 && ret == 0; i++)
     {
       pholder = &sem->holder[i];
 
@@ -320,6 +443,131 @@ static int nxsem_recoverholders(FAR struct semholder_s *pholder,
 }
 #endif
 
+/****************************************************************************
+ * Name: nxsem_remwaiter
+ *
+ * Description:
+ *   Remove a thread from the list of threads waiting for the semaphore.
+ *
+ ****************************************************************************/
+
+static void nxsem_remwaiter(FAR sem_t *sem, FAR struct tcb_s *wtcb)
+{
+  FAR struct tcb_s *curr;
+  FAR struct tcb_s *prev;
+
+  for (prev = NULL, curr = sem->whead;
+       curr != NULL && curr != wtcb;
+       prev = curr, curr = curr->semwlink);
+
+  if (curr != NULL)
+    {
+      if (prev != NULL)
+        {
+          prev->semwlink = wtcb->semwlink;
+        }
+      else
+        {
+          sem->whead = wtcb->semwlink;
+        }
+    }
+
+  wtcb->semwlink = NULL;
+}
+
+/****************************************************************************
+ * Name: nxsem_waiterprio
+ *
+ * Description:
+ *   Return the priority of the highest priority thread waiting for a count
+ *   from the semaphore, or zero if there is no such thread.  Only the
+ *   threads waiting for this semaphore are examined.
+ *
+ ****************************************************************************/
+
+static int nxsem_waiterprio(FAR sem_t *sem)
+{
+  FAR struct tcb_s *wtcb;
+  int priority = 0;
+
+  for (wtcb = sem->whead; wtcb != NULL; wtcb = wtcb->semwlink)
+    {
+      if (wtcb->sched_priority > priority)
+        {
+          priority = wtcb->sched_priority;
+        }
+    }
+
+  return priority;
+}
+
+/****************************************************************************
+ * Name: nxsem_holderprio
+ *
+ * Description:
+ *   Return the priority that the holder thread should have:  The higher of
+ *   its base priority and the priority of the highest priority thread
+ *   waiting for any of the semaphores that it holds.  The cost is
+ *   proportional only to the number of semaphores held by the thread.
+ *
+ ****************************************************************************/
+
+static int nxsem_holderprio(FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+  int priority = htcb->base_priority;
+
+  for (pholder = htcb->holdsem; pholder != NULL; pholder = pholder->tlink)
+    {
+      if (pholder->waitprio > priority)
+        {
+          priority = pholder->waitprio;
+        }
+    }
+
+  return priority;
+}
+
+/****************************************************************************
+ * Name: nxsem_restoreprio
+ *
+ * Description:
+ *   Drop the priority of a boosted holder thread to the highest priority
+ *   still required by the semaphores that it holds.
+ *
+ ****************************************************************************/
+
+static void nxsem_restoreprio(FAR struct tcb_s *htcb)
+{
+  int rpriority;
+
+  /* Was the priority of the holder thread boosted? If so, then drop its
+   * priority back to the correct level.
+   */
+
+  if (htcb->sched_priority != htcb->base_priority)
+    {
+      rpriority = nxsem_holderprio(htcb);
+      if (rpriority == htcb->base_priority)
+        {
+          /* No other waiters are pending.  Reset the holder's priority back
+           * to the base priority.
+           */
+
+          sched_reprioritize(htcb, htcb->base_priority);
+        }
+      else if (rpriority < htcb->sched_priority)
+        {
+          /* The holder must remain boosted because of a waiter on another
+           * semaphore that it holds.  Apply that priority to the thread
+           * (while retaining the base_priority).
+           */
+
+          sched_setpriority(htcb, rpriority);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: nxsem_boostholderprio
  ****************************************************************************/
@@ -341,83 +589,25 @@ static int nxsem_boostholderprio(FAR struct semholder_s *pholder,
       serr("ERROR: TCB 0x%08x is a stale handle, counts lost\n", htcb);
       DEBUGPANIC();
       nxsem_freeholder(sem, pholder);
+      return 0;
     }
 
-#if CONFIG_SEM_NNESTPRIO > 0
-  /* If the priority of the thread that is waiting for a count is greater
-   * than the base priority of the thread holding a count, then we may need
-   * to adjust the holder's priority now or later to that priority.
+  /* Remember the priority of the highest priority waiter.  This is what
+   * will allow the holder's priority to be restored later without
+   * recording the history of boosts.
    */
 
-  else if (rtcb->sched_priority > htcb->base_priority)
+  if (rtcb->sched_priority > pholder->waitprio)
     {
-      /* If the new priority is greater than the current, possibly already
-       * boosted priority of the holder thread, then we will have to raise
-       * the holder's priority now.
-       */
-
-      if (rtcb->sched_priority > htcb->sched_priority)
-        {
-          /* If the current priority of holder thread has already been
-           * boosted, then add the boost priority to the list of restoration
-           * priorities.  When the higher priority waiter thread gets its
-           * count, then we need to revert the holder thread to this saved
-           * priority (not to its base priority).
-           */
-
-          if (htcb->sched_priority > htcb->base_priority)
-            {
-              /* Save the current, boosted priority of the holder thread. */
-
-              if (htcb->npend_reprio < CONFIG_SEM_NNESTPRIO)
-                {
-                  htcb->pend_reprios[htcb->npend_reprio] = htcb->sched_priority;
-                  htcb->npend_reprio++;
-                }
-              else
-                {
-                  serr("ERROR: CONFIG_SEM_NNESTPRIO exceeded\n");
-                  DEBUGASSERT(htcb->npend_reprio < CONFIG_SEM_NNESTPRIO);
-                }
-            }
-
-          /* Raise the priority of the thread holding of the semaphore.
-           * This cannot cause a context switch because we have preemption
-           * disabled.  The holder thread may be marked "pending" and the
-           * switch may occur during up_block_task() processing.
-           */
-
-          (void)sched_setpriority(htcb, rtcb->sched_priority);
-        }
-      else
-        {
-          /* The new priority is above the base priority of the holder,
-           * but not as high as its current working priority.  Just put it
-           * in the list of pending restoration priorities so that when the
-           * higher priority thread gets its count, we can revert to this
-           * saved priority and not to the base priority.
-           */
-
-          if (htcb->npend_reprio < CONFIG_SEM_NNESTPRIO)
-            {
-              htcb->pend_reprios[htcb->npend_reprio] = rtcb->sched_priority;
-              htcb->npend_reprio++;
-            }
-          else
-            {
-              serr("ERROR: CONFIG_SEM_NNESTPRIO exceeded\n");
-              DEBUGASSERT(htcb->npend_reprio < CONFIG_SEM_NNESTPRIO);
-            }
-        }
+      pholder->waitprio = rtcb->sched_priority;
     }
 
-#else
   /* If the priority of the thread that is waiting for a count is less than
    * of equal to the priority of the thread holding a count, then do nothing
    * because the thread is already running at a sufficient priority.
    */
 
-  else if (rtcb->sched_priority > htcb->sched_priority)
+  if (rtcb->sched_priority > htcb->sched_priority)
     {
       /* Raise the priority of the holder of the semaphore.  This
        * cannot cause a context switch because we have preemption
@@ -427,7 +617,6 @@ static int nxsem_boostholderprio(FAR struct semholder_s *pholder,
 
       (void)sched_setpriority(htcb, rtcb->sched_priority);
     }
-#endif
 
   return 0;
 }
@@ -440,20 +629,11 @@ static int nxsem_boostholderprio(FAR struct semholder_s *pholder,
 static int nxsem_verifyholder(FAR struct semholder_s *pholder,
                               FAR sem_t *sem, FAR void *arg)
 {
-#if 0 /* Need to revisit this, but these assumptions seem to be untrue -- \
-       * OR there is a bug??? */
-  FAR struct tcb_s *htcb = (FAR struct tcb_s *)pholder->htcb;
-
   /* Called after a semaphore has been released (incremented), the semaphore
-   * could is non-negative, and there is no thread waiting for the count.
-   * In this case, the priority of the holder should not be boosted.
+   * count is non-negative, and there is no thread waiting for the count.
    */
 
-#if CONFIG_SEM_NNESTPRIO > 0
-  DEBUGASSERT(htcb->npend_reprio == 0);
-#endif
-  DEBUGASSERT(htcb->sched_priority == htcb->base_priority);
-#endif
+  DEBUGASSERT(pholder->waitprio == 0);
   return 0;
 }
 #endif
@@ -467,10 +647,12 @@ static int nxsem_dumpholder(FAR struct semholder_s *pholder, FAR sem_t *sem,
                             FAR void *arg)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  _info("  %08x: %08x %08x %04x\n",
-        pholder, pholder->flink, pholder->htcb, pholder->counts);
+  _info("  %08x: %08x %08x %04x %3d\n",
+        pholder, pholder->flink, pholder->htcb, pholder->counts,
+        pholder->waitprio);
 #else
-  _info("  %08x: %08x %04x\n", pholder, pholder->htcb, pholder->counts);
+  _info("  %08x: %08x %04x %3d\n", pholder, pholder->htcb, pholder->counts,
+        pholder->waitprio);
 #endif
   return 0;
 }
@@ -478,18 +660,17 @@ static int nxsem_dumpholder(FAR struct semholder_s *pholder, FAR sem_t *sem,
 
 /****************************************************************************
  * Name: nxsem_restoreholderprio
+ *
+ * Description:
+ *   Reprioritize one holder.  'arg' is the priority of the highest priority
+ *   thread still waiting for the semaphore.
+ *
  ****************************************************************************/
 
-static int nxsem_restoreholderprio(FAR struct tcb_s *htcb,
+static int nxsem_restoreholderprio(FAR struct semholder_s *pholder,
                                    FAR sem_t *sem, FAR void *arg)
 {
-  FAR struct semholder_s *pholder = 0;
-#if CONFIG_SEM_NNESTPRIO > 0
-  FAR struct tcb_s *stcb = (FAR struct tcb_s *)arg;
-  int rpriority;
-  int i;
-  int j;
-#endif
+  FAR struct tcb_s *htcb = pholder->htcb;
 
   /* Make sure that the holder thread is still active.  If it exited without
    * releasing its counts, then that would be a bad thing.  But we can take
@@ -501,143 +682,17 @@ static int nxsem_restoreholderprio(FAR struct tcb_s *htcb,
     {
       serr("ERROR: TCB 0x%08x is a stale handle, counts lost\n", htcb);
       DEBUGPANIC();
-      pholder = nxsem_findholder(sem, htcb);
-      if (pholder != NULL)
-        {
-          nxsem_freeholder(sem, pholder);
-        }
+      nxsem_freeholder(sem, pholder);
     }
-
-  /* Was the priority of the holder thread boosted? If so, then drop its
-   * priority back to the correct level.  What is the correct level?
-   */
-
-  else if (htcb->sched_priority != htcb->base_priority)
+  else
     {
-#if CONFIG_SEM_NNESTPRIO > 0
-      /* Are there other, pending priority levels to revert to? */
-
-      if (htcb->npend_reprio < 1)
-        {
-          /* No... the holder thread has only been boosted once.
-           * npend_reprio should be 0 and the boosted priority should be the
-           * priority of the task that just got the semaphore
-           * (stcb->sched_priority)
-           *
-           * That latter assumption may not be true if the stcb's priority
-           * was also boosted so that it no longer matches the htcb's
-           * sched_priority.  Or if CONFIG_SEM_NNESTPRIO is too small (so
-           * that we do not have a proper record of the reprioritizations).
-           */
-
-          DEBUGASSERT(/* htcb->sched_priority == stcb->sched_priority && */
-            htcb->npend_reprio == 0);
-
-          /* Reset the holder's priority back to the base priority. */
-
-          sched_reprioritize(htcb, htcb->base_priority);
-        }
-
-      /* There are multiple pending priority levels. The holder thread's
-       * "boosted" priority could greater than or equal to
-       * "stcb->sched_priority" (it could be greater if its priority we
-       * boosted because it also holds another semaphore).
-       */
-
-      else if (htcb->sched_priority <= stcb->sched_priority)
-        {
-          /* The holder thread has been boosted to the same priority as the
-           * waiter thread that just received the count.  We will simply
-           * reprioritize to the next highest priority that we have in
-           * rpriority.
-           */
-
-          /* Find the highest pending priority and remove it from the list */
-
-          for (i = 1, j = 0; i < htcb->npend_reprio; i++)
-            {
-              if (htcb->pend_reprios[i] > htcb->pend_reprios[j])
-                {
-                  j = i;
-                }
-            }
-
-          /* Remove the highest priority pending priority from the list */
-
-          rpriority = htcb->pend_reprios[j];
-          i = htcb->npend_reprio - 1;
-          if (i > 0)
-            {
-              htcb->pend_reprios[j] = htcb->pend_reprios[i];
-            }
-
-          htcb->npend_reprio = i;
-
-          /* And apply that priority to the thread (while retaining the
-           * base_priority)
-           */
-
-          sched_setpriority(htcb, rpriority);
-        }
-      else
-        {
-          /* The holder thread has been boosted to a higher priority than the
-           * waiter task.  The pending priority should be in the list (unless
-           * it was lost because of of list overflow or because the holder
-           * was reprioritized again unbeknownst to the priority inheritance
-           * logic).
-           *
-           * Search the list for the matching priority.
-           */
-
-          for (i = 0; i < htcb->npend_reprio; i++)
-            {
-              /* Does this pending priority match the priority of the thread
-               * that just received the count?
-               */
-
-              if (htcb->pend_reprios[i] == stcb->sched_priority)
-                {
-                  /* Yes, remove it from the list */
-
-                  j = htcb->npend_reprio - 1;
-                  if (j > 0)
-                    {
-                      htcb->pend_reprios[i] = htcb->pend_reprios[j];
-                    }
-
-                  htcb->npend_reprio = j;
-                  break;
-                }
-            }
-        }
-#else
-      /* There is no alternative restore priorities, drop the priority
-       * of the holder thread all the way back to the threads "base"
-       * priority.
-       */
-
-      sched_reprioritize(htcb, htcb->base_priority);
-#endif
+      pholder->waitprio = (uint8_t)(uintptr_t)arg;
+      nxsem_restoreprio(htcb);
     }
 
   return 0;
 }
 
-/****************************************************************************
- * Name: nxsem_restoreholderprioall
- *
- * Description:
- *   Reprioritize all holders
- *
- ****************************************************************************/
-
-static int nxsem_restoreholderprioall(FAR struct semholder_s *pholder,
-                                      FAR sem_t *sem, FAR void *arg)
-{
-  return nxsem_restoreholderprio(pholder->htcb, sem, arg);
-}
-
 /****************************************************************************
  * Name: nxsem_restoreholderprioA
  *
@@ -652,7 +707,7 @@ static int nxsem_restoreholderprioA(FAR struct semholder_s *pholder,
   FAR struct tcb_s *rtcb = this_task();
   if (pholder->htcb != rtcb)
     {
-      return nxsem_restoreholderprio(pholder->htcb, sem, arg);
+      return nxsem_restoreholderprio(pholder, sem, arg);
     }
 
   return 0;
@@ -673,19 +728,18 @@ static int nxsem_restoreholderprioB(FAR struct semholder_s *pholder,
 
   if (pholder->htcb == rtcb)
     {
-
-      /* The running task has given up a count on the semaphore */
-
-#if CONFIG_SEM_PREALLOCHOLDERS == 0
-      /* In the case where there are only 2 holders. This step
-       * is necessary to insure we have space. Release the holder
-       * if all counts have been given up. before reprioritizing
-       * causes a context switch.
+      /* The running task has given up a count on the semaphore.  If it
+       * no longer holds any counts, release the holder now so that the
+       * waiters on this semaphore no longer contribute to its priority.
        */
 
-      nxsem_findandfreeholder(sem, rtcb);
-#endif
-      (void)nxsem_restoreholderprio(rtcb, sem, arg);
+      pholder->waitprio = (uint8_t)(uintptr_t)arg;
+      if (pholder->counts <= 0)
+        {
+          nxsem_freeholder(sem, pholder);
+        }
+
+      nxsem_restoreprio(rtcb);
       return 1;
     }
 
@@ -727,18 +781,22 @@ static int nxsem_restoreholderprioB(FAR struct semholder_s *pholder,
 static inline void nxsem_restorebaseprio_irq(FAR struct tcb_s *stcb,
                                              FAR sem_t *sem)
 {
+  uintptr_t waitprio;
+
   /* Perform the following actions only if a new thread was given a count.
    * The thread that received the count should be the highest priority
    * of all threads waiting for a count from the semaphore.  So in that
    * case, the priority of all holder threads should be dropped to the
-   * next highest pending priority.
+   * priority of the next highest priority waiter.
    */
 
   if (stcb != NULL)
     {
       /* Drop the priority of all holder threads */
 
-      (void)nxsem_foreachholder(sem, nxsem_restoreholderprioall, stcb);
+      waitprio = nxsem_waiterprio(sem);
+      (void)nxsem_foreachholder(sem, nxsem_restoreholderprio,
+                                (FAR void *)waitprio);
     }
 
   /* If there are no tasks waiting for available counts, then all holders
@@ -789,16 +847,19 @@ static inline void nxsem_restorebaseprio_task(FAR struct tcb_s *stcb,
                                               FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
+  uintptr_t waitprio;
 
   /* Perform the following actions only if a new thread was given a count.
    * The thread that received the count should be the highest priority
    * of all threads waiting for a count from the semaphore.  So in that
    * case, the priority of all holder threads should be dropped to the
-   * next highest pending priority.
+   * priority of the next highest priority waiter.
    */
 
   if (stcb != NULL)
     {
+      waitprio = nxsem_waiterprio(sem);
+
       /* The currently executed thread should be the lower priority
        * thread that just posted the count and caused this action.
        * However, we cannot drop the priority of the currently running
@@ -808,11 +869,13 @@ static inline void nxsem_restorebaseprio_task(FAR struct tcb_s *stcb,
        * except for the running thread.
        */
 
-      (void)nxsem_foreachholder(sem, nxsem_restoreholderprioA, stcb);
+      (void)nxsem_foreachholder(sem, nxsem_restoreholderprioA,
+                                (FAR void *)waitprio);
 
       /* Now, find an reprioritize only the ready to run task */
 
-      (void)nxsem_foreachholder(sem, nxsem_restoreholderprioB, stcb);
+      (void)nxsem_foreachholder(sem, nxsem_restoreholderprioB,
+                                (FAR void *)waitprio);
     }
 
   /* If there are no tasks waiting for available counts, then all holders
@@ -868,6 +931,7 @@ void nxsem_initholders(void)
     }
 
   g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS - 1].flink = NULL;
+  g_nfreeholders = CONFIG_SEM_PREALLOCHOLDERS;
 #endif
 }
 
@@ -916,8 +980,15 @@ void nxsem_destroyholder(FAR sem_t *sem)
       DEBUGPANIC();
     }
 
-  sem->holder[0].htcb = NULL;
-  sem->holder[1].htcb = NULL;
+  if (sem->holder[0].htcb != NULL)
+    {
+      nxsem_freeholder(sem, &sem->holder[0]);
+    }
+
+  if (sem->holder[1].htcb != NULL)
+    {
+      nxsem_freeholder(sem, &sem->holder[1]);
+    }
 #endif
 }
 
@@ -956,11 +1027,8 @@ void nxsem_addholder_tcb(FAR struct tcb_s *htcb, FAR sem_t *sem)
       pholder = nxsem_findorallocateholder(sem, htcb);
       if (pholder != NULL)
         {
-          /* Then set the holder and increment the number of counts held by this
-           * holder
-           */
+          /* Then increment the number of counts held by this holder */
 
-          pholder->htcb = htcb;
           pholder->counts++;
         }
     }
@@ -992,13 +1060,15 @@ void nxsem_addholder(FAR sem_t *sem)
  * Name: void nxsem_boostpriority(sem_t *sem)
  *
  * Description:
- *
+ *   Called from nxsem_wait() before the running thread blocks waiting for
+ *   a count on the semaphore.  Boost the priority of every holder of the
+ *   semaphore with a lower priority than the running thread.
  *
  * Parameters:
- *   None
+ *   sem - A reference to the semaphore that the thread will wait for
  *
  * Return Value:
- *   0 (OK) or -1 (ERROR) if unsuccessful
+ *   None
  *
  * Assumptions:
  *
@@ -1008,6 +1078,11 @@ void nxsem_boostpriority(FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
 
+  /* Add the thread to the list of threads waiting for this semaphore */
+
+  rtcb->semwlink = sem->whead;
+  sem->whead     = rtcb;
+
   /* Boost the priority of every thread holding counts on this semaphore
    * that are lower in priority than the new thread that is waiting for a
    * count.
@@ -1091,6 +1166,13 @@ void nxsem_restorebaseprio(FAR struct tcb_s *stcb, FAR sem_t *sem)
   DEBUGASSERT((sem->semcount > 0  && stcb == NULL) ||
               (sem->semcount <= 0 && stcb != NULL));
 
+  /* The thread that received the count is no longer waiting */
+
+  if (stcb != NULL)
+    {
+      nxsem_remwaiter(sem, stcb);
+    }
+
   /* Handler semaphore counts posed from an interrupt handler differently
    * from interrupts posted from threads.  The primary difference is that
    * if the semaphore is posted from a thread, then the poster thread is
@@ -1128,18 +1210,23 @@ void nxsem_restorebaseprio(FAR struct tcb_s *stcb, FAR sem_t *sem)
  *
  ****************************************************************************/
 
-#ifndef CONFIG_DISABLE_SIGNALS
 void nxsem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem)
 {
+  uintptr_t waitprio;
+
   /* Check our assumptions */
 
   DEBUGASSERT(sem->semcount <= 0);
 
-  /* Adjust the priority of every holder as necessary */
+  /* The canceled thread is no longer waiting for the semaphore.  Then
+   * adjust the priority of every holder as necessary.
+   */
 
-  (void)nxsem_foreachholder(sem, nxsem_restoreholderprioall, stcb);
+  nxsem_remwaiter(sem, stcb);
+  waitprio = nxsem_waiterprio(sem);
+  (void)nxsem_foreachholder(sem, nxsem_restoreholderprio,
+                            (FAR void *)waitprio);
 }
-#endif
 
 /****************************************************************************
  * Name: sem_enumholders
@@ -1187,15 +1274,7 @@ void sem_enumholders(FAR sem_t *sem)
 int nxsem_nfreeholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *pholder;
-  int n;
-
-  for (pholder = g_freeholders, n = 0; pholder; pholder = pholder->flink)
-    {
-      n++;
-    }
-
-  return n;
+  return g_nfreeholders;
 #else
   return 0;
 #endif
@@ -49,6 +49,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/semaphore.h>
 
@@ -56,6 +57,84 @@
 #include "clock/clock.h"
 #include "semaphore/semaphore.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_hrtimeout
+ *
+ * Description:
+ *   The high resolution timer expired before the semaphore was acquired.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+static void nxsem_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  nxsem_timeout(1, (wdparm_t)(uintptr_t)hrtimer->arg);
+}
+
+/****************************************************************************
+ * Name: nxsem_hrtimedwait
+ *
+ * Description:
+ *   Wait for the semaphore with the timeout provided by a high resolution
+ *   timer.
+ *
+ * Returned Value:
+ *   The result of the wait as for nxsem_timedwait().  -ENODEV is returned
+ *   without waiting if high resolution timers are not available; a
+ *   watchdog must then be used.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static int nxsem_hrtimedwait(FAR sem_t *sem,
+                             FAR const struct timespec *abstime)
+{
+  struct hrtimer_s hrtimer;
+  struct timespec reltime;
+  struct timespec now;
+  uint64_t expired;
+  int ret;
+
+  /* Convert the absolute CLOCK_REALTIME time to a monotonic hrtimer
+   * expiration time.  If the time has already expired return immediately.
+   */
+
+  (void)clock_gettime(CLOCK_REALTIME, &now);
+  clock_timespec_subtract(abstime, &now, &reltime);
+
+  if (reltime.tv_sec == 0 && reltime.tv_nsec == 0)
+    {
+      return -ETIMEDOUT;
+    }
+
+  expired = hrtimer_gettime() +
+            (uint64_t)reltime.tv_sec * NSEC_PER_SEC +
+            (uint64_t)reltime.tv_nsec;
+
+  hrtimer_init(&hrtimer);
+  ret = hrtimer_start(&hrtimer, nxsem_hrtimeout,
+                      (FAR void *)(uintptr_t)this_task()->pid, expired);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Now perform the blocking wait, then make sure that the timer (which is
+   * on our stack) is gone.
+   */
+
+  ret = nxsem_wait(sem);
+  (void)hrtimer_cancel(&hrtimer);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -165,6 +244,16 @@ int nxsem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
       goto errout_with_irqdisabled;
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Use a high resolution timer if one is available */
+
+  ret = nxsem_hrtimedwait(sem, abstime);
+  if (ret != -ENODEV)
+    {
+      goto errout_with_irqdisabled;
+    }
+#endif
+
   /* Convert the timespec to clock ticks.  We must have interrupts
    * disabled here so that this time stays valid until the wait begins.
    *
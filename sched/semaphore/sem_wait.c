@@ -122,6 +122,9 @@ int nxsem_wait(FAR sem_t *sem)
 
       else
         {
+#ifdef CONFIG_SCHED_LATENCY
+          uint32_t start;
+#endif
           int saved_errno;
 
           /* First, verify that the task is not already waiting on a
@@ -163,10 +166,20 @@ int nxsem_wait(FAR sem_t *sem)
           saved_errno   = rtcb->pterrno;
           rtcb->pterrno = OK;
 
+#ifdef CONFIG_SCHED_LATENCY
+          /* Note when the wait started for the wait time histograms */
+
+          start = up_perf_gettime();
+#endif
+
           /* Add the TCB to the prioritized semaphore wait queue */
 
           up_block_task(rtcb, TSTATE_WAIT_SEM);
 
+#ifdef CONFIG_SCHED_LATENCY
+          sched_latency_semwait(rtcb, start);
+#endif
+
           /* When we resume at this point, either (1) the semaphore has been
            * assigned to this thread of execution, or (2) the semaphore wait
            * has been interrupted by a signal or a timeout.  We can detect these
@@ -41,7 +41,9 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <string.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
@@ -66,6 +68,20 @@
 
 #undef CONFIG_SPINLOCK_LOCKDOWN /* Feature not yet available */
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* The table of registered spinlocks.  Entries are only added. */
+
+static struct spinlock_stats_s g_spinlock_stats[CONFIG_SPINLOCK_NSTATS];
+
+/* Serializes registration.  This must not be a monitored lock. */
+
+static volatile spinlock_t g_spinlock_statslock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -88,7 +104,7 @@ void spin_initializer(FAR struct spinlock_s *lock)
 {
   DEBUGASSERT(lock != NULL);
 
-  lock->sp_lock  = SP_UNLOCKED;
+  kspin_initialize(&lock->sp_lock);
 #ifdef CONFIG_SMP
   lock->sp_cpu   = IMPOSSIBLE_CPU;
   lock->sp_count = 0;
@@ -120,6 +136,10 @@ void spin_initializer(FAR struct spinlock_s *lock)
 
 void spin_lock(FAR volatile spinlock_t *lock)
 {
+#ifdef CONFIG_SPINLOCK_STATS
+  uint32_t nspins = 0;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are waiting for a spinlock */
 
@@ -128,7 +148,18 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
+      /* Spin reading the lock (which can be satisfied from the local
+       * cache) rather than repeating the test-and-set (which requires
+       * exclusive ownership of the cache line).
+       */
+
+      while (*lock == SP_LOCKED)
+        {
+#ifdef CONFIG_SPINLOCK_STATS
+          nspins++;
+#endif
+          SP_DSB();
+        }
     }
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
@@ -137,6 +168,10 @@ void spin_lock(FAR volatile spinlock_t *lock)
   sched_note_spinlocked(this_task(), lock);
 #endif
   SP_DMB();
+
+  /* Account for the acquisition (if this lock is monitored) */
+
+  spin_stats_update(lock, nspins);
 }
 
 /****************************************************************************
@@ -212,7 +247,7 @@ void spin_lockr(FAR struct spinlock_s *lock)
       /* Yes... just increment the number of references we have on the lock */
 
       lock->sp_count++;
-      DEBUGASSERT(lock->sp_lock = SP_LOCKED && lock->sp_count > 0);
+      DEBUGASSERT(spin_islockedr(lock) && lock->sp_count > 0);
     }
   else
     {
@@ -238,6 +273,13 @@ void spin_lockr(FAR struct spinlock_s *lock)
        * some scheduling actions?
        */
 
+#ifdef CONFIG_SPINLOCK_KERNEL_TICKET
+      /* A drawn ticket cannot be given back, so wait for it without
+       * yielding.
+       */
+
+      spin_ticket_lock(&lock->sp_lock);
+#else
       while (up_testset(&lock->sp_lock) == SP_LOCKED)
         {
           up_irq_restore(flags);
@@ -245,6 +287,7 @@ void spin_lockr(FAR struct spinlock_s *lock)
           flags = up_irq_save();
           SP_DSB();
         }
+#endif
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
       /* Notify that we have thespinlock */
@@ -275,11 +318,15 @@ void spin_lockr(FAR struct spinlock_s *lock)
    * scheduling actions?
    */
 
+#ifdef CONFIG_SPINLOCK_KERNEL_TICKET
+  spin_ticket_lock(&lock->sp_lock);
+#else
   while (up_testset(&lock->sp_lock) == SP_LOCKED)
     {
       sched_yield();
       SP_DSB()
     }
+#endif
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have thespinlock */
@@ -328,7 +375,7 @@ void spin_unlockr(FAR struct spinlock_s *lock)
    * CPU and avoids such complexities.
    */
 
-  DEBUGASSERT(lock != NULL && lock->sp_lock == SP_LOCKED &&
+  DEBUGASSERT(lock != NULL && spin_islockedr(lock) &&
               lock->sp_cpu == this_cpu() && lock->sp_count > 0);
 
   /* Do we already hold the lock? */
@@ -337,7 +384,7 @@ void spin_unlockr(FAR struct spinlock_s *lock)
 #else
   /* The alternative is to allow the lock to be released from any CPU */
 
-  DEBUGASSERT(lock != NULL && lock->sp_lock == SP_LOCKED &&
+  DEBUGASSERT(lock != NULL && spin_islockedr(lock) &&
               lock->sp_count > 0);
 #endif
 
@@ -355,7 +402,11 @@ void spin_unlockr(FAR struct spinlock_s *lock)
 
           lock->sp_count = 0;
           lock->sp_cpu   = IMPOSSIBLE_CPU;
+#ifdef CONFIG_SPINLOCK_KERNEL_TICKET
+          spin_ticket_unlock(&lock->sp_lock);
+#else
           lock->sp_lock  = SP_UNLOCKED;
+#endif
         }
       else
         {
@@ -375,8 +426,12 @@ void spin_unlockr(FAR struct spinlock_s *lock)
 
   /* Just mark the spinlock unlocked */
 
-  DEBUGASSERT(lock != NULL && lock->sp_lock == SP_LOCKED);
+  DEBUGASSERT(lock != NULL && spin_islockedr(lock));
+#ifdef CONFIG_SPINLOCK_KERNEL_TICKET
+  spin_ticket_unlock(&lock->sp_lock);
+#else
   lock->sp_lock  = SP_UNLOCKED;
+#endif
 
 #endif /* CONFIG_SMP */
 }
@@ -501,4 +556,155 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
   up_irq_restore(flags);
 }
 
+/****************************************************************************
+ * Name: spin_stats_register
+ *
+ * Description:
+ *   Register a spinlock so that contention statistics are collected for it.
+ *   At most CONFIG_SPINLOCK_NSTATS spinlocks may be registered.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock to be monitored (spinlock_t or
+ *          struct spin_ticket_s).
+ *   name - A name for the spinlock.  The string must persist.
+ *
+ * Returned Value:
+ *   None.  If there is no free statistics entry, the lock is not monitored.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_stats_register(FAR volatile void *lock, FAR const char *name)
+{
+  FAR struct spinlock_stats_s *stats;
+  irqstate_t flags;
+  int i;
+
+  /* Use up_testset() directly:  spin_lock() would recurse into the
+   * statistics logic.
+   */
+
+  flags = up_irq_save();
+  while (up_testset(&g_spinlock_statslock) == SP_LOCKED)
+    {
+      SP_DSB();
+    }
+
+  SP_DMB();
+
+  for (i = 0; i < CONFIG_SPINLOCK_NSTATS; i++)
+    {
+      stats = &g_spinlock_stats[i];
+      if (stats->ss_lock == lock)
+        {
+          break;
+        }
+      else if (stats->ss_lock == NULL)
+        {
+          /* Publish the lock pointer last so that spin_stats_update()
+           * never sees a partially initialized entry.
+           */
+
+          stats->ss_name = name;
+          SP_DMB();
+          stats->ss_lock = lock;
+          break;
+        }
+    }
+
+  g_spinlock_statslock = SP_UNLOCKED;
+  SP_DMB();
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_stats_update
+ *
+ * Description:
+ *   Account for one acquisition of a spinlock.  Has no effect if the
+ *   spinlock is not registered.
+ *
+ * Input Parameters:
+ *   lock   - A reference to the spinlock that was just taken.
+ *   nspins - The number of failed attempts before the lock was taken.
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   The caller holds the spinlock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_stats_update(FAR volatile void *lock, uint32_t nspins)
+{
+  FAR struct spinlock_stats_s *stats;
+  int i;
+
+  for (i = 0; i < CONFIG_SPINLOCK_NSTATS; i++)
+    {
+      stats = &g_spinlock_stats[i];
+      if (stats->ss_lock == lock)
+        {
+          /* We hold the lock so nothing else can modify these counts */
+
+          stats->ss_acquired++;
+          if (nspins > 0)
+            {
+              stats->ss_contended++;
+              stats->ss_spins += nspins;
+
+              if (nspins > stats->ss_maxspins)
+                {
+                  stats->ss_maxspins = nspins;
+                }
+            }
+
+          break;
+        }
+      else if (stats->ss_lock == NULL)
+        {
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_stats_get
+ *
+ * Description:
+ *   Return a snapshot of the statistics for one registered spinlock.
+ *
+ * Input Parameters:
+ *   ndx   - The index of the statistics entry, 0..CONFIG_SPINLOCK_NSTATS-1
+ *   stats - The location to return the statistics.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the index is not in use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+int spin_stats_get(int ndx, FAR struct spinlock_stats_s *stats)
+{
+  DEBUGASSERT(stats != NULL);
+
+  if (ndx < 0 || ndx >= CONFIG_SPINLOCK_NSTATS ||
+      g_spinlock_stats[ndx].ss_lock == NULL)
+    {
+      return -ENOENT;
+    }
+
+  /* The counts may be updated concurrently; a slightly inconsistent
+   * snapshot is acceptable.
+   */
+
+  memcpy(stats, &g_spinlock_stats[ndx], sizeof(struct spinlock_stats_s));
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_SPINLOCK */
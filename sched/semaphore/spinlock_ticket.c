@@ -0,0 +1,231 @@
+/****************************************************************************
+ * sched/semaphore/spinlock_ticket.c
+ *
+ *   Copyright (C) 2026 agent. All rights reserved.
+ *   Author: agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <sys/types.h>
+#include <assert.h>
+
+#include <nuttx/spinlock.h>
+#include <arch/irq.h>
+
+#ifdef CONFIG_SPINLOCK_TICKET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_ticket_guard
+ *
+ * Description:
+ *   Take the guard that serializes access to st_next.  The guard is held
+ *   only for a few instructions and so is not worth monitoring.
+ *
+ ****************************************************************************/
+
+static inline void spin_ticket_guard(FAR struct spin_ticket_s *lock)
+{
+  while (up_testset(&lock->st_guard) == SP_LOCKED)
+    {
+      while (lock->st_guard == SP_LOCKED)
+        {
+          SP_DSB();
+        }
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: spin_ticket_unguard
+ ****************************************************************************/
+
+static inline void spin_ticket_unguard(FAR struct spin_ticket_s *lock)
+{
+  SP_DMB();
+  lock->st_guard = SP_UNLOCKED;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_ticket_initialize
+ *
+ * Description:
+ *   Initialize a ticket spinlock object to its initial, unlocked state.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to be initialized.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void spin_ticket_initialize(FAR struct spin_ticket_s *lock)
+{
+  DEBUGASSERT(lock != NULL);
+
+  lock->st_next  = 0;
+  lock->st_owner = 0;
+  lock->st_guard = SP_UNLOCKED;
+}
+
+/****************************************************************************
+ * Name: spin_ticket_lock
+ *
+ * Description:
+ *   Draw a ticket and wait until that ticket is served.  Contending CPUs
+ *   acquire the lock in the order in which they arrived.
+ *
+ *   Like spin_lock(), this implementation is non-reentrant.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+void spin_ticket_lock(FAR struct spin_ticket_s *lock)
+{
+  uint32_t nspins = 0;
+  uint16_t ticket;
+
+  DEBUGASSERT(lock != NULL);
+
+  /* Draw the next ticket.  The architecture only provides test-and-set so
+   * the increment must be protected by the guard.
+   */
+
+  spin_ticket_guard(lock);
+  ticket = lock->st_next++;
+  spin_ticket_unguard(lock);
+
+  /* Wait for our turn.  This only reads st_owner so the cache line is not
+   * bounced between the waiting CPUs.
+   */
+
+  while (lock->st_owner != ticket)
+    {
+      nspins++;
+      SP_DSB();
+    }
+
+  SP_DMB();
+
+  /* Account for the acquisition (if this lock is monitored) */
+
+  spin_stats_update(lock, nspins);
+  UNUSED(nspins);
+}
+
+/****************************************************************************
+ * Name: spin_ticket_trylock
+ *
+ * Description:
+ *   Take the ticket spinlock only if it is available and nobody is waiting
+ *   for it.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+spinlock_t spin_ticket_trylock(FAR struct spin_ticket_s *lock)
+{
+  spinlock_t ret = SP_LOCKED;
+
+  DEBUGASSERT(lock != NULL);
+
+  /* The lock is free only if no ticket is outstanding */
+
+  spin_ticket_guard(lock);
+  if (lock->st_next == lock->st_owner)
+    {
+      lock->st_next++;
+      ret = SP_UNLOCKED;
+    }
+
+  spin_ticket_unguard(lock);
+
+  if (ret == SP_UNLOCKED)
+    {
+      spin_stats_update(lock, 0);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spin_ticket_unlock
+ *
+ * Description:
+ *   Release a ticket spinlock, passing it to the next waiter (if any).
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void spin_ticket_unlock(FAR struct spin_ticket_s *lock)
+{
+  DEBUGASSERT(lock != NULL && lock->st_owner != lock->st_next);
+
+  /* Only the holder modifies st_owner so no guard is needed */
+
+  SP_DMB();
+  lock->st_owner++;
+  SP_DSB();
+}
+
+#endif /* CONFIG_SPINLOCK_TICKET */
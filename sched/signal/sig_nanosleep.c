@@ -46,6 +46,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/irq.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
 
@@ -107,7 +108,11 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
                     FAR struct timespec *rmtp)
 {
   irqstate_t flags;
+#ifdef CONFIG_HRTIMER
+  uint64_t starttime;
+#else
   systime_t starttick;
+#endif
   sigset_t set;
   int ret;
 
@@ -124,7 +129,11 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
    */
 
   flags     = enter_critical_section();
+#ifdef CONFIG_HRTIMER
+  starttime = hrtimer_gettime();
+#else
   starttick = clock_systimer();
+#endif
 
   /* Set up for the sleep.  Using the empty set means that we are not
    * waiting for any particular signal.  However, any unmasked signal can
@@ -158,6 +167,21 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
 
   if (rmtp)
     {
+#ifdef CONFIG_HRTIMER
+      uint64_t requested;
+      uint64_t elapsed;
+      uint64_t remaining;
+
+      /* Compare the requested and the elapsed time in nanoseconds */
+
+      requested = (uint64_t)rqtp->tv_sec * NSEC_PER_SEC +
+                  (uint64_t)rqtp->tv_nsec;
+      elapsed   = hrtimer_gettime() - starttime;
+      remaining = elapsed >= requested ? 0 : requested - elapsed;
+
+      rmtp->tv_sec  = (time_t)(remaining / NSEC_PER_SEC);
+      rmtp->tv_nsec = (long)(remaining % NSEC_PER_SEC);
+#else
       systime_t elapsed;
       systime_t remaining;
       ssystime_t ticks;
@@ -192,6 +216,7 @@ int nxsig_nanosleep(FAR const struct timespec *rqtp,
         }
 
       (void)clock_ticks2time((ssystime_t)remaining, rmtp);
+#endif
     }
 
   leave_critical_section(flags);
@@ -52,6 +52,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
 
@@ -76,10 +77,11 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: nxsig_timeout
+ * Name: nxsig_waketimeout
  *
  * Description:
- *   A timeout elapsed while waiting for signals to be queued.
+ *   A timeout elapsed while waiting for signals to be queued.  Wake up the
+ *   waiting task if it is still waiting.
  *
  * Assumptions:
  *   This function executes in the context of the timer interrupt handler.
@@ -87,26 +89,13 @@
  *
  ****************************************************************************/
 
-static void nxsig_timeout(int argc, wdparm_t itcb)
+static void nxsig_waketimeout(FAR struct tcb_s *wtcb)
 {
 #ifdef CONFIG_SMP
   irqstate_t flags;
 #endif
 
-  /* On many small machines, pointers are encoded and cannot be simply cast
-   * from uint32_t to struct tcb_s *.  The following union works around this
-   * (see wdogparm_t).  This odd logic could be conditioned on
-   * CONFIG_CAN_CAST_POINTERS, but it is not too bad in any case.
-   */
-
-  union
-  {
-    FAR struct tcb_s *wtcb;
-    wdparm_t itcb;
-  } u;
-
-  u.itcb = itcb;
-  DEBUGASSERT(u.wtcb);
+  DEBUGASSERT(wtcb);
 
 #ifdef CONFIG_SMP
   /* We must be in a critical section in order to call up_unblock_task()
@@ -125,17 +114,17 @@ static void nxsig_timeout(int argc, wdparm_t itcb)
    * still waiting for a signal
    */
 
-  if (u.wtcb->task_state == TSTATE_WAIT_SIG)
+  if (wtcb->task_state == TSTATE_WAIT_SIG)
     {
-      u.wtcb->sigunbinfo.si_signo           = SIG_WAIT_TIMEOUT;
-      u.wtcb->sigunbinfo.si_code            = SI_TIMER;
-      u.wtcb->sigunbinfo.si_errno           = ETIMEDOUT;
-      u.wtcb->sigunbinfo.si_value.sival_int = 0;
+      wtcb->sigunbinfo.si_signo           = SIG_WAIT_TIMEOUT;
+      wtcb->sigunbinfo.si_code            = SI_TIMER;
+      wtcb->sigunbinfo.si_errno           = ETIMEDOUT;
+      wtcb->sigunbinfo.si_value.sival_int = 0;
 #ifdef CONFIG_SCHED_HAVE_PARENT
-      u.wtcb->sigunbinfo.si_pid             = 0;  /* Not applicable */
-      u.wtcb->sigunbinfo.si_status          = OK;
+      wtcb->sigunbinfo.si_pid             = 0;  /* Not applicable */
+      wtcb->sigunbinfo.si_status          = OK;
 #endif
-      up_unblock_task(u.wtcb);
+      up_unblock_task(wtcb);
     }
 
 #ifdef CONFIG_SMP
@@ -143,6 +132,100 @@ static void nxsig_timeout(int argc, wdparm_t itcb)
 #endif
 }
 
+/****************************************************************************
+ * Name: nxsig_timeout
+ *
+ * Description:
+ *   The watchdog timeout elapsed while waiting for signals to be queued.
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt handler.
+ *   Local interrupts are assumed to be disabled on entry.
+ *
+ ****************************************************************************/
+
+static void nxsig_timeout(int argc, wdparm_t itcb)
+{
+  /* On many small machines, pointers are encoded and cannot be simply cast
+   * from uint32_t to struct tcb_s *.  The following union works around this
+   * (see wdogparm_t).  This odd logic could be conditioned on
+   * CONFIG_CAN_CAST_POINTERS, but it is not too bad in any case.
+   */
+
+  union
+  {
+    FAR struct tcb_s *wtcb;
+    wdparm_t itcb;
+  } u;
+
+  u.itcb = itcb;
+  nxsig_waketimeout(u.wtcb);
+}
+
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   The high resolution timer expired while waiting for signals to be
+ *   queued.
+ *
+ * Assumptions:
+ *   This function executes in the context of the oneshot timer interrupt
+ *   handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+static void nxsig_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  nxsig_waketimeout((FAR struct tcb_s *)hrtimer->arg);
+}
+
+/****************************************************************************
+ * Name: nxsig_hrblock
+ *
+ * Description:
+ *   Block the task waiting for a signal with the timeout provided by a
+ *   high resolution timer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned after the task has been awakened (by a signal or
+ *   by the timeout).  -ENODEV is returned without blocking if high
+ *   resolution timers are not available; a watchdog must then be used.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static int nxsig_hrblock(FAR struct tcb_s *rtcb,
+                         FAR const struct timespec *timeout)
+{
+  struct hrtimer_s hrtimer;
+  uint64_t expired;
+  int ret;
+
+  expired = hrtimer_gettime() +
+            (uint64_t)timeout->tv_sec * NSEC_PER_SEC +
+            (uint64_t)timeout->tv_nsec;
+
+  hrtimer_init(&hrtimer);
+  ret = hrtimer_start(&hrtimer, nxsig_hrtimeout, rtcb, expired);
+  if (ret == OK)
+    {
+      /* Now wait for either the signal or the timer */
+
+      up_block_task(rtcb, TSTATE_WAIT_SIG);
+
+      /* The timer is on our stack, so make sure that it is gone */
+
+      (void)hrtimer_cancel(&hrtimer);
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -315,8 +398,17 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       rtcb->sigwaitmask = *set;
 
-      /* Check if we should wait for the timeout */
+      /* Check if we should wait for the timeout.  Use a high resolution
+       * timer if one is available.
+       */
 
+#ifdef CONFIG_HRTIMER
+      if (timeout != NULL && nxsig_hrblock(rtcb, timeout) == OK)
+        {
+          /* Awakened by a signal or by the timeout.  See below. */
+        }
+      else
+#endif
       if (timeout != NULL)
         {
           /* Convert the timespec to system clock ticks, making sure that
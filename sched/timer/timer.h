@@ -48,6 +48,7 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -71,6 +72,11 @@ struct posix_timer_s
   int             pt_delay;        /* If non-zero, used to reset repetitive timers */
   int             pt_last;         /* Last value used to set watchdog */
   WDOG_ID         pt_wdog;         /* The watchdog that provides the timing */
+#ifdef CONFIG_HRTIMER
+  struct hrtimer_s pt_hrtimer;     /* High resolution timer (if available) */
+  uint64_t        pt_interval;     /* Reload value of the hrtimer (ns) */
+  int             pt_overrun;      /* Periods skipped at the last expiration */
+#endif
   struct sigevent pt_event;        /* Notification information */
 };
 
@@ -72,6 +72,10 @@
  *   Realtime Signals Extension is not supported, the return value of
  *   timer_getoverrun() is unspecified.
  *
+ *   Overruns are counted only for timers that run on the high resolution
+ *   timer.  They are the periods that were skipped when a periodic timer
+ *   was re-armed late.
+ *
  * Parameters:
  *   timerid - The pre-thread timer, previously created by the call to
  *   timer_create(), whose overrun count will be returned..
@@ -90,8 +94,20 @@
 
 int timer_getoverrun(timer_t timerid)
 {
+#ifdef CONFIG_HRTIMER
+  FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)timerid;
+
+  if (timer == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  return timer->pt_overrun;
+#else
   set_errno(ENOSYS);
   return ERROR;
+#endif
 }
 
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
@@ -94,6 +94,25 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
       return ERROR;
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Is the timer running on the high resolution timer? */
+
+  if (hrtimer_isactive(&timer->pt_hrtimer))
+    {
+      uint64_t now = hrtimer_gettime();
+      uint64_t remaining;
+
+      remaining = timer->pt_hrtimer.expired > now ?
+                  timer->pt_hrtimer.expired - now : 0;
+
+      value->it_value.tv_sec     = (time_t)(remaining / NSEC_PER_SEC);
+      value->it_value.tv_nsec    = (long)(remaining % NSEC_PER_SEC);
+      value->it_interval.tv_sec  = (time_t)(timer->pt_interval / NSEC_PER_SEC);
+      value->it_interval.tv_nsec = (long)(timer->pt_interval % NSEC_PER_SEC);
+      return OK;
+    }
+#endif
+
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(timer->pt_wdog);
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <limits.h>
 #include <time.h>
 #include <string.h>
 #include <errno.h>
@@ -61,6 +62,11 @@ static inline void timer_signotify(FAR struct posix_timer_s *timer);
 static inline void timer_restart(FAR struct posix_timer_s *timer,
                                  wdparm_t itimer);
 static void timer_timeout(int argc, wdparm_t itimer);
+#ifdef CONFIG_HRTIMER
+static void timer_hrtimeout(FAR struct hrtimer_s *hrtimer);
+static int timer_hrsettime(FAR struct posix_timer_s *timer, int flags,
+                           FAR const struct itimerspec *value);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -230,6 +236,129 @@ static void timer_timeout(int argc, wdparm_t itimer)
 #endif
 }
 
+/****************************************************************************
+ * Name: timer_hrtimeout
+ *
+ * Description:
+ *   This function is called when the high resolution timer expires.
+ *
+ * Parameters:
+ *   hrtimer - The expired high resolution timer of the POSIX timer
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   This function executes in the context of the oneshot timer interrupt.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+static void timer_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)hrtimer->arg;
+  uint64_t expired = 0;
+  uint64_t missed  = 0;
+  uint64_t now;
+
+  if (timer->pt_interval > 0)
+    {
+      /* The next expiration is relative to the last one so that the period
+       * does not drift with interrupt latency.  If we were delayed by more
+       * than a period, skip the periods that have already passed rather
+       * than expiring back-to-back to catch up.  They are reported as
+       * overruns of this expiration.
+       */
+
+      expired = hrtimer->expired + timer->pt_interval;
+      now     = hrtimer_gettime();
+      if (expired <= now)
+        {
+          missed   = (now - expired) / timer->pt_interval + 1;
+          expired += missed * timer->pt_interval;
+        }
+    }
+
+  timer->pt_overrun = missed < DELAYTIMER_MAX ? (int)missed : DELAYTIMER_MAX;
+
+  /* Send the specified signal to the specified task.   Increment the
+   * reference count on the timer first so that will not be deleted until
+   * after the signal handler returns.
+   */
+
+  timer->pt_crefs++;
+  timer_signotify(timer);
+
+  /* Release the reference.  timer_release will return nonzero if the timer
+   * was not deleted.
+   */
+
+  if (timer_release(timer) && timer->pt_interval > 0)
+    {
+      /* If this is a repetitive timer, then restart the hrtimer */
+
+      (void)hrtimer_start(hrtimer, timer_hrtimeout, timer, expired);
+    }
+}
+
+/****************************************************************************
+ * Name: timer_hrsettime
+ *
+ * Description:
+ *   Arm the timer using the high resolution timer.
+ *
+ * Parameters:
+ *   timer - The POSIX timer to arm
+ *   flags - Specifie characteristics of the timer (see timer_settime())
+ *   value - Specifies the timer value to set
+ *
+ * Return Value:
+ *   Zero (OK) on success; -ENODEV if high resolution timers are not
+ *   available and a watchdog must be used instead.
+ *
+ ****************************************************************************/
+
+static int timer_hrsettime(FAR struct posix_timer_s *timer, int flags,
+                           FAR const struct itimerspec *value)
+{
+  struct timespec reltime;
+  struct timespec now;
+  irqstate_t intflags;
+  uint64_t expired;
+  int ret;
+
+  timer->pt_interval = (uint64_t)value->it_interval.tv_sec * NSEC_PER_SEC +
+                       (uint64_t)value->it_interval.tv_nsec;
+  timer->pt_overrun  = 0;
+
+  intflags = enter_critical_section();
+
+  /* Check if abstime is selected */
+
+  if ((flags & TIMER_ABSTIME) != 0)
+    {
+      /* Calculate a delay corresponding to the absolute time in 'value'.
+       * If the time is in the past, the timer will expire immediately.
+       */
+
+      (void)clock_gettime(CLOCK_REALTIME, &now);
+      clock_timespec_subtract(&value->it_value, &now, &reltime);
+    }
+  else
+    {
+      reltime = value->it_value;
+    }
+
+  expired = hrtimer_gettime() +
+            (uint64_t)reltime.tv_sec * NSEC_PER_SEC +
+            (uint64_t)reltime.tv_nsec;
+
+  ret = hrtimer_start(&timer->pt_hrtimer, timer_hrtimeout, timer, expired);
+  leave_critical_section(intflags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -320,6 +449,9 @@ int timer_settime(timer_t timerid, int flags,
    */
 
   (void)wd_cancel(timer->pt_wdog);
+#ifdef CONFIG_HRTIMER
+  (void)hrtimer_cancel(&timer->pt_hrtimer);
+#endif
 
   /* If the it_value member of value is zero, the timer will not be re-armed */
 
@@ -328,6 +460,15 @@ int timer_settime(timer_t timerid, int flags,
       return OK;
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Use a high resolution timer if one is available */
+
+  if (timer_hrsettime(timer, flags, value) == OK)
+    {
+      return OK;
+    }
+#endif
+
   /* Setup up any repititive timer */
 
   if (value->it_interval.tv_sec > 0 || value->it_interval.tv_nsec > 0)
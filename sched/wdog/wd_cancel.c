@@ -55,100 +55,141 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: wd_cancel
+ * Name: wd_remove
  *
  * Description:
- *   This function cancels a currently running watchdog timer. Watchdog
- *   timers may be cancelled from the interrupt level.
+ *   Remove an active watchdog from g_wdactivelist and mark it inactive.
+ *   The following watchdog inherits the remaining ticks.
  *
  * Parameters:
- *   wdog - ID of the watchdog to cancel.
+ *   wdog - The active watchdog to remove
  *
  * Return Value:
- *   Zero (OK) is returned on success;  A negated errno value is returned to
- *   indicate the nature of any failure.
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the active list lock (wd_lock()).
  *
  ****************************************************************************/
 
-int wd_cancel(WDOG_ID wdog)
+void wd_remove(FAR struct wdog_s *wdog)
 {
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
-  irqstate_t flags;
-  int ret = -EINVAL;
 
-  /* Prohibit timer interactions with the timer queue until the
-   * cancellation is complete
+  /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
+   * to do this because there are additional operations that need to be
+   * done.
    */
 
-  flags = enter_critical_section();
+  prev = NULL;
+  curr = (FAR struct wdog_s *)g_wdactivelist.head;
 
-  /* Make sure that the watchdog is initialized (non-NULL) and is still
-   * active.
+  while ((curr) && (curr != wdog))
+    {
+      prev = curr;
+      curr = curr->next;
+    }
+
+  /* Check if the watchdog was found in the list.  If not, then an OS
+   * error has occurred because the watchdog is marked active!
    */
 
-  if (wdog != NULL && WDOG_ISACTIVE(wdog))
+  ASSERT(curr);
+
+  /* If there is a watchdog in the timer queue after the one that
+   * is being cancelled, then it inherits the remaining ticks.
+   */
+
+  if (curr->next)
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
-       */
+      curr->next->lag += curr->lag;
+    }
 
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
+  /* Now, remove the watchdog from the timer queue */
 
-      while ((curr) && (curr != wdog))
-        {
-          prev = curr;
-          curr = curr->next;
-        }
+  if (prev)
+    {
+      /* Remove the watchdog from mid- or end-of-queue */
 
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
+      (void)sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
+    }
+  else
+    {
+      /* Remove the watchdog at the head of the queue */
 
-      ASSERT(curr);
+      (void)sq_remfirst(&g_wdactivelist);
 
-      /* If there is a watchdog in the timer queue after the one that
-       * is being cancelled, then it inherits the remaining ticks.
+      /* Reassess the interval timer that will generate the next
+       * interval event.
        */
 
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
+      sched_timer_reassess();
+    }
 
-      /* Now, remove the watchdog from the timer queue */
+  /* Mark the watchdog inactive */
 
-      if (prev)
-        {
-          /* Remove the watchdog from mid- or end-of-queue */
+  wdog->next = NULL;
+  WDOG_CLRACTIVE(wdog);
+}
 
-          (void)sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
-        {
-          /* Remove the watchdog at the head of the queue */
+/****************************************************************************
+ * Name: wd_cancel
+ *
+ * Description:
+ *   This function cancels a currently running watchdog timer. Watchdog
+ *   timers may be cancelled from the interrupt level.
+ *
+ *   If the watchdog has just expired and its function is running on
+ *   another CPU, wd_cancel() waits for the function to return.
+ *
+ * Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
 
-          (void)sq_remfirst(&g_wdactivelist);
+int wd_cancel(WDOG_ID wdog)
+{
+  irqstate_t flags;
+  int ret = -EINVAL;
 
-          /* Reassess the interval timer that will generate the next
-           * interval event.
-           */
+  /* Prohibit timer interactions with the timer queue until the
+   * cancellation is complete
+   */
 
-          sched_timer_reassess();
-        }
+  flags = wd_lock();
 
-      /* Mark the watchdog inactive */
+  /* Make sure that the watchdog is initialized (non-NULL) and is still
+   * active.
+   */
 
-      wdog->next = NULL;
-      WDOG_CLRACTIVE(wdog);
+  if (wdog != NULL && WDOG_ISACTIVE(wdog))
+    {
+      wd_remove(wdog);
+      ret = OK;
+    }
 
-      /* Return success */
+#ifdef WDOG_ACTIVELOCK
+  else if (wdog != NULL && wdog == g_wdrunning)
+    {
+      /* The watchdog function is running inside of the critical section,
+       * either on another CPU or, if the function cancels its own
+       * watchdog, on this one.  Entering the critical section waits until
+       * the function has returned.
+       */
 
-      ret = OK;
+      wd_unlock(flags);
+
+      flags = enter_critical_section();
+      leave_critical_section(flags);
+      return ret;
     }
+#endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return ret;
 }
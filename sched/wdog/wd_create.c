@@ -79,7 +79,7 @@ WDOG_ID wd_create (void)
    * timers.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&g_wdfreelock);
 
   /* If we are in an interrupt handler -OR- if the number of pre-allocated
    * timer structures exceeds the reserve, then take the next timer from
@@ -115,7 +115,7 @@ WDOG_ID wd_create (void)
           DEBUGASSERT(g_wdnfree == 0);
         }
 
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_wdfreelock, flags);
     }
 
   /* We are in a normal tasking context AND there are not enough unreserved,
@@ -127,7 +127,7 @@ WDOG_ID wd_create (void)
     {
       /* We do not require that interrupts be disabled to do this. */
 
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_wdfreelock, flags);
       wdog = (FAR struct wdog_s *)kmm_malloc(sizeof(struct wdog_s));
 
       /* Did we get one? */
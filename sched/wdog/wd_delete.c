@@ -95,6 +95,12 @@ int wd_delete(WDOG_ID wdog)
       wd_cancel(wdog);
     }
 
+  /* The active list is no longer involved.  Only the free list remains,
+   * and that has its own lock.
+   */
+
+  leave_critical_section(flags);
+
   /* Did this watchdog come from the pool of pre-allocated timers?  Or, was
    * it allocated from the heap?
    */
@@ -109,7 +115,6 @@ int wd_delete(WDOG_ID wdog)
        * We don't need interrupts disabled to do this.
        */
 
-      leave_critical_section(flags);
       sched_kfree(wdog);
     }
 
@@ -123,10 +128,11 @@ int wd_delete(WDOG_ID wdog)
        * timers, all with interrupts disabled.
        */
 
+      flags = spin_lock_irqsave(&g_wdfreelock);
       sq_addlast((FAR sq_entry_t *)wdog, &g_wdfreelist);
       g_wdnfree++;
       DEBUGASSERT(g_wdnfree <= CONFIG_PREALLOC_WDOGS);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&g_wdfreelock, flags);
     }
 
   /* Return success */
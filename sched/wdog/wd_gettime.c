@@ -71,7 +71,7 @@ int wd_gettime(WDOG_ID wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
       /* Traverse the watchdog list accumulating lag times until we find the
@@ -88,12 +88,12 @@ int wd_gettime(WDOG_ID wdog)
           delay += curr->lag;
           if (curr == wdog)
             {
-              leave_critical_section(flags);
+              wd_unlock(flags);
               return delay;
             }
         }
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return 0;
 }
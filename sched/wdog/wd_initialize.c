@@ -41,6 +41,8 @@
 
 #include <queue.h>
 
+#include <nuttx/spinlock.h>
+
 #include "wdog/wdog.h"
 
 /****************************************************************************
@@ -67,6 +69,22 @@ sq_queue_t g_wdactivelist;
 
 uint16_t g_wdnfree;
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+/* This spinlock protects g_wdfreelist and g_wdnfree */
+
+kspinlock_t g_wdfreelock SP_SECTION = KSPINLOCK_INITIALIZER;
+#endif
+
+#ifdef WDOG_ACTIVELOCK
+/* This spinlock protects g_wdactivelist */
+
+kspinlock_t g_wdactivelock SP_SECTION = KSPINLOCK_INITIALIZER;
+
+/* The watchdog whose function is running now, if any */
+
+FAR struct wdog_s *volatile g_wdrunning;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -122,4 +140,11 @@ void wd_initialize(void)
   /* All watchdogs are free */
 
   g_wdnfree = CONFIG_PREALLOC_WDOGS;
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+  spin_stats_register(&g_wdfreelock, "wdog");
+#endif
+#ifdef WDOG_ACTIVELOCK
+  spin_stats_register(&g_wdactivelock, "wdactive");
+#endif
 }
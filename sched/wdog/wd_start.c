@@ -104,82 +104,124 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  *   None
  *
  * Assumptions:
+ *   The watchdog functions run inside of the critical section.  With
+ *   WDOG_ACTIVELOCK, the active list lock is not held while a function
+ *   runs so that the function may start or cancel watchdogs.
  *
  ****************************************************************************/
 
 static inline void wd_expiration(void)
 {
   FAR struct wdog_s *wdog;
+  wdparm_t parm[CONFIG_MAX_WDOGPARMS > 0 ? CONFIG_MAX_WDOGPARMS : 1];
+  wdentry_t func;
+  int argc;
+  int i;
+#ifdef WDOG_ACTIVELOCK
+  irqstate_t flags;
+  irqstate_t lflags;
 
-  /* Check if the watchdog at the head of the list is ready to run */
+  flags = enter_critical_section();
+#endif
+
+  /* Process the watchdog at the head of the list as well as any other
+   * watchdogs that became ready to run at this time
+   */
 
-  if (((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0)
+  for (; ; )
     {
-      /* Process the watchdog at the head of the list as well as any
-       * other watchdogs that became ready to run at this time
+#ifdef WDOG_ACTIVELOCK
+      lflags = wd_lock();
+#endif
+
+      /* Check if the watchdog at the head of the list is ready to run */
+
+      wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+      if (wdog == NULL || wdog->lag > 0)
+        {
+#ifdef WDOG_ACTIVELOCK
+          wd_unlock(lflags);
+#endif
+          break;
+        }
+
+      /* Remove the watchdog from the head of the list */
+
+      (void)sq_remfirst(&g_wdactivelist);
+
+      /* If there is another watchdog behind this one, update its
+       * its lag (this shouldn't be necessary).
        */
 
-      while (g_wdactivelist.head &&
-             ((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0)
+      if (g_wdactivelist.head)
         {
-          /* Remove the watchdog from the head of the list */
+          ((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
+        }
 
-          wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdactivelist);
+      /* Indicate that the watchdog is no longer active. */
 
-          /* If there is another watchdog behind this one, update its
-           * its lag (this shouldn't be necessary).
-           */
+      WDOG_CLRACTIVE(wdog);
 
-          if (g_wdactivelist.head)
-            {
-              ((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
-            }
+      /* Take a copy of the function and its parameters.  The watchdog may
+       * be restarted as soon as the list is unlocked.
+       */
+
+      func = wdog->func;
+      argc = wdog->argc;
+      for (i = 0; i < argc && i < CONFIG_MAX_WDOGPARMS; i++)
+        {
+          parm[i] = wdog->parm[i];
+        }
 
-          /* Indicate that the watchdog is no longer active. */
+      up_setpicbase(wdog->picbase);
 
-          WDOG_CLRACTIVE(wdog);
+#ifdef WDOG_ACTIVELOCK
+      g_wdrunning = wdog;
+      wd_unlock(lflags);
+#endif
 
-          /* Execute the watchdog function */
+      /* Execute the watchdog function */
 
-          up_setpicbase(wdog->picbase);
-          switch (wdog->argc)
-            {
-              default:
-                DEBUGPANIC();
-                break;
+      switch (argc)
+        {
+          default:
+            DEBUGPANIC();
+            break;
 
-              case 0:
-                (*((wdentry0_t)(wdog->func)))(0);
-                break;
+          case 0:
+            (*((wdentry0_t)(func)))(0);
+            break;
 
 #if CONFIG_MAX_WDOGPARMS > 0
-              case 1:
-                (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-                break;
+          case 1:
+            (*((wdentry1_t)(func)))(1, parm[0]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 1
-              case 2:
-                (*((wdentry2_t)(wdog->func)))(2,
-                                wdog->parm[0], wdog->parm[1]);
-                break;
+          case 2:
+            (*((wdentry2_t)(func)))(2, parm[0], parm[1]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 2
-              case 3:
-                (*((wdentry3_t)(wdog->func)))(3,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2]);
-                break;
+          case 3:
+            (*((wdentry3_t)(func)))(3, parm[0], parm[1], parm[2]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 3
-              case 4:
-                (*((wdentry4_t)(wdog->func)))(4,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2], wdog->parm[3]);
-                break;
+          case 4:
+            (*((wdentry4_t)(func)))(4, parm[0], parm[1], parm[2], parm[3]);
+            break;
 #endif
-            }
         }
+
+#ifdef WDOG_ACTIVELOCK
+      g_wdrunning = NULL;
+#endif
     }
+
+#ifdef WDOG_ACTIVELOCK
+  leave_critical_section(flags);
+#endif
 }
 
 /****************************************************************************
@@ -243,10 +285,10 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
    * the critical section is established.
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (WDOG_ISACTIVE(wdog))
     {
-      wd_cancel(wdog);
+      wd_remove(wdog);
     }
 
   /* Save the data in the watchdog structure */
@@ -388,7 +430,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   sched_timer_resume();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
@@ -487,36 +529,38 @@ unsigned int wd_timer(int ticks)
 #else
 void wd_timer(void)
 {
-#ifdef CONFIG_SMP
+  FAR struct wdog_s *wdog;
   irqstate_t flags;
+  bool expired = false;
 
   /* We are in an interrupt handler as, as a consequence, interrupts are
    * disabled.  But in the SMP case, interrupst MAY be disabled only on
    * the local CPU since most architectures do not permit disabling
    * interrupts on other CPUS.
    *
-   * Hence, we must follow rules for critical sections even here in the
-   * SMP case.
+   * Hence, we must lock the active list even here in the SMP case.
    */
 
-  flags = enter_critical_section();
-#endif
+  flags = wd_lock();
 
   /* Check if there are any active watchdogs to process */
 
-  if (g_wdactivelist.head)
+  wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+  if (wdog != NULL)
     {
       /* There are.  Decrement the lag counter */
 
-      --(((FAR struct wdog_s *)g_wdactivelist.head)->lag);
+      --(wdog->lag);
+      expired = (wdog->lag <= 0);
+    }
 
-      /* Check if the watchdog at the head of the list is ready to run */
+  wd_unlock(flags);
 
+  /* Check if the watchdog at the head of the list is ready to run */
+
+  if (expired)
+    {
       wd_expiration();
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
 }
 #endif /* CONFIG_SCHED_TICKLESS */
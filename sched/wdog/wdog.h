@@ -46,7 +46,35 @@
 #include <stdbool.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/irq.h>
 #include <nuttx/wdog.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* In SMP mode, g_wdactivelist has its own spinlock so that starting,
+ * cancelling and counting down watchdogs does not take the global critical
+ * section.  The watchdog functions still run inside of the critical
+ * section; wd_cancel() waits for a function that is running on another CPU.
+ *
+ * In tickless mode, wd_start() and wd_cancel() call back into wd_timer()
+ * through the interval timer logic, and that logic also manipulates the
+ * ready-to-run lists.  g_wdactivelist remains under the critical section
+ * in that case.
+ */
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ) && \
+    !defined(CONFIG_SCHED_TICKLESS)
+#  define WDOG_ACTIVELOCK 1
+#  define wd_lock()         spin_lock_irqsave(&g_wdactivelock)
+#  define wd_unlock(flags)  spin_unlock_irqrestore(&g_wdactivelock, (flags))
+#else
+#  undef  WDOG_ACTIVELOCK
+#  define wd_lock()         enter_critical_section()
+#  define wd_unlock(flags)  leave_critical_section(flags)
+#endif
 
 /****************************************************************************
  * Public Data
@@ -80,6 +108,28 @@ extern sq_queue_t g_wdactivelist;
 
 extern uint16_t g_wdnfree;
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_IRQ)
+/* This spinlock protects g_wdfreelist and g_wdnfree in place of the global
+ * critical section.
+ */
+
+extern kspinlock_t g_wdfreelock;
+#endif
+
+#ifdef WDOG_ACTIVELOCK
+/* This spinlock protects g_wdactivelist and the lag of each active
+ * watchdog in place of the global critical section.
+ */
+
+extern kspinlock_t g_wdactivelock;
+
+/* The watchdog whose function is running now, if any.  It is set and
+ * cleared inside of the critical section.
+ */
+
+extern FAR struct wdog_s *volatile g_wdrunning;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -136,6 +186,26 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from g_wdactivelist and mark it inactive.
+ *   The following watchdog inherits the remaining ticks.
+ *
+ * Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the active list lock (wd_lock()).
+ *
+ ****************************************************************************/
+
+void wd_remove(FAR struct wdog_s *wdog);
+
 /****************************************************************************
  * Name: wd_recover
  *
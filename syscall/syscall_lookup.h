@@ -62,10 +62,17 @@ SYSCALL_LOOKUP(uname,                      1, STUB_uname)
 /* Semaphores */
 
 SYSCALL_LOOKUP(sem_destroy,                1, STUB_sem_destroy)
+#ifdef CONFIG_SEM_FASTPATH
+SYSCALL_LOOKUP(sem_futexwake,              1, STUB_sem_futexwake)
+SYSCALL_LOOKUP(sem_timedwait,              2, STUB_sem_timedwait)
+SYSCALL_LOOKUP(sem_futextrywait,           1, STUB_sem_futextrywait)
+SYSCALL_LOOKUP(sem_futexwait,              1, STUB_sem_futexwait)
+#else
 SYSCALL_LOOKUP(sem_post,                   1, STUB_sem_post)
 SYSCALL_LOOKUP(sem_timedwait,              2, STUB_sem_timedwait)
 SYSCALL_LOOKUP(sem_trywait,                1, STUB_sem_trywait)
 SYSCALL_LOOKUP(sem_wait,                   1, STUB_sem_wait)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 SYSCALL_LOOKUP(sem_setprotocol,            2, STUB_sem_setprotocol)
@@ -82,6 +82,9 @@ uintptr_t STUB_uname(int nbr, uintptr_t parm1);
 
 uintptr_t STUB_sem_close(int nbr, uintptr_t parm1);
 uintptr_t STUB_sem_destroy(int nbr, uintptr_t parm1);
+uintptr_t STUB_sem_futextrywait(int nbr, uintptr_t parm1);
+uintptr_t STUB_sem_futexwait(int nbr, uintptr_t parm1);
+uintptr_t STUB_sem_futexwake(int nbr, uintptr_t parm1);
 uintptr_t STUB_sem_open(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5, uintptr_t parm6);
 uintptr_t STUB_sem_post(int nbr, uintptr_t parm1);
@@ -0,0 +1,343 @@
+#!/usr/bin/env python
+############################################################################
+# tools/note2trace.py
+#
+#   Copyright (C) 2026 agent. All rights reserved.
+#   Author: agent <agent@local>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name NuttX nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+# Convert the scheduler instrumentation notes read from /dev/note into a
+# Chrome trace (JSON) file that can be loaded into chrome://tracing or
+# https://ui.perfetto.dev.  The trace shows:
+#
+#   - One track per CPU with the task running on that CPU, the interrupt
+#     handlers (CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER), and the time
+#     spent spinning for spinlocks (CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS).
+#   - One track per task with the intervals when the task was suspended,
+#     labeled with the task state (for example, waiting for a semaphore).
+#   - Instant events for task start/stop, critical sections and pre-
+#     emption locks.
+#
+# Usage:
+#
+#   note2trace.py [-s] [-p ptrsize] [-f freq | -t usec] <note-file> [<json-file>]
+#
+# Where <note-file> is a copy of the data read from /dev/note and:
+#
+#   -s          The target is an SMP configuration (the common note header
+#               then includes the CPU index).
+#   -p ptrsize  The size of a pointer on the target (default 4).
+#   -f freq     The timestamps are CONFIG_SCHED_NOTE_PERFTIME counter values
+#               incrementing at freq Hz.
+#   -t usec     The timestamps are system timer ticks of usec microseconds
+#               (CONFIG_USEC_PER_TICK, default 10000).
+#
+# The JSON is written to stdout if no <json-file> is given.
+
+import getopt
+import json
+import struct
+import sys
+
+NOTE_START           = 0
+NOTE_STOP            = 1
+NOTE_SUSPEND         = 2
+NOTE_RESUME          = 3
+NOTE_CPU_START       = 4
+NOTE_CPU_STARTED     = 5
+NOTE_CPU_PAUSE       = 6
+NOTE_CPU_PAUSED      = 7
+NOTE_CPU_RESUME      = 8
+NOTE_CPU_RESUMED     = 9
+NOTE_PREEMPT_LOCK    = 10
+NOTE_PREEMPT_UNLOCK  = 11
+NOTE_CSECTION_ENTER  = 12
+NOTE_CSECTION_LEAVE  = 13
+NOTE_SPINLOCK_LOCK   = 14
+NOTE_SPINLOCK_LOCKED = 15
+NOTE_SPINLOCK_UNLOCK = 16
+NOTE_SPINLOCK_ABORT  = 17
+NOTE_BPRINTF         = 18
+NOTE_IRQ_ENTER       = 19
+NOTE_IRQ_LEAVE       = 20
+
+CPU_PID  = 0
+TASK_PID = 1
+
+class Note:
+    pass
+
+class Timebase:
+    # Convert the 32-bit timestamps into monotonic microseconds, undoing
+    # the wrap-around.  The notes from all CPUs are merged in time order by
+    # sched_note_get().
+
+    def __init__(self, freq, usec):
+        self.freq = freq
+        self.usec = usec
+        self.last = None
+        self.high = 0
+
+    def convert(self, raw):
+        if self.last is not None and raw < self.last and \
+           self.last - raw > 0x80000000:
+            self.high += 0x100000000
+        self.last = raw
+        count = self.high + raw
+        if self.freq:
+            return count * 1000000.0 / self.freq
+        return float(count * self.usec)
+
+def parse(notes, smp, ptrsize):
+    cmnsize = 10 if smp else 9
+    pos = 0
+
+    while pos < len(notes):
+        length = ord(notes[pos:pos + 1])
+        if length < cmnsize or pos + length > len(notes):
+            sys.stderr.write('Bad note at offset %d\n' % pos)
+            return
+
+        raw = notes[pos:pos + length]
+        pos += length
+
+        note = Note()
+        note.type = ord(raw[1:2])
+        note.priority = ord(raw[2:3])
+        note.cpu = ord(raw[3:4]) if smp else 0
+        note.pid, note.systime = struct.unpack_from('<HI', raw, cmnsize - 6)
+        note.data = raw[cmnsize:]
+        note.cmnsize = cmnsize
+        note.raw = raw
+        yield note
+
+def pointer(note, offset, ptrsize):
+    fmt = '<Q' if ptrsize == 8 else '<I'
+    if offset + ptrsize > len(note.raw):
+        return 0
+    value, = struct.unpack_from(fmt, note.raw, offset)
+    return value
+
+class Converter:
+    def __init__(self, timebase, ptrsize):
+        self.timebase = timebase
+        self.ptrsize = ptrsize
+        self.events = []
+        self.names = {}
+        self.running = {}
+        self.suspended = {}
+        self.spinning = {}
+        self.cpus = set()
+        self.tasks = set()
+
+    def name(self, pid):
+        return self.names.get(pid, 'pid %d' % pid)
+
+    def slice(self, name, cat, start, end, pid, tid, args=None):
+        event = { 'name': name, 'cat': cat, 'ph': 'X', 'ts': start,
+                  'dur': max(end - start, 0), 'pid': pid, 'tid': tid }
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def instant(self, name, cat, ts, pid, tid, args=None):
+        event = { 'name': name, 'cat': cat, 'ph': 'i', 's': 't', 'ts': ts,
+                  'pid': pid, 'tid': tid }
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def stop_running(self, cpu, ts):
+        if cpu in self.running:
+            pid, prio, start = self.running.pop(cpu)
+            self.slice(self.name(pid), 'sched', start, ts, CPU_PID, cpu,
+                       { 'pid': pid, 'priority': prio })
+
+    def note(self, note):
+        ts = self.timebase.convert(note.systime)
+        cpu = note.cpu
+        pid = note.pid
+        self.cpus.add(cpu)
+
+        if note.type == NOTE_START:
+            name = note.data.split(b'\0')[0].decode('latin-1')
+            if name:
+                self.names[pid] = name
+            self.tasks.add(pid)
+            self.instant('start ' + self.name(pid), 'sched', ts, TASK_PID,
+                         pid)
+
+        elif note.type == NOTE_STOP:
+            self.instant('stop', 'sched', ts, TASK_PID, pid)
+
+        elif note.type == NOTE_SUSPEND:
+            state = ord(note.data[0:1]) if note.data else 0
+            running = self.running.get(cpu)
+            if running is not None and running[0] == pid:
+                self.stop_running(cpu, ts)
+            self.suspended[pid] = (state, ts)
+            self.tasks.add(pid)
+
+        elif note.type == NOTE_RESUME:
+            self.stop_running(cpu, ts)
+            self.running[cpu] = (pid, note.priority, ts)
+            if pid in self.suspended:
+                state, start = self.suspended.pop(pid)
+                self.slice('suspended (state %d)' % state, 'sched', start,
+                           ts, TASK_PID, pid, { 'state': state })
+            self.tasks.add(pid)
+
+        elif note.type in (NOTE_CPU_START, NOTE_CPU_PAUSE, NOTE_CPU_RESUME):
+            target = ord(note.data[0:1]) if note.data else 0
+            names = { NOTE_CPU_START: 'cpu start',
+                      NOTE_CPU_PAUSE: 'cpu pause',
+                      NOTE_CPU_RESUME: 'cpu resume' }
+            self.instant('%s %d' % (names[note.type], target), 'cpu', ts,
+                         CPU_PID, cpu)
+
+        elif note.type in (NOTE_CPU_STARTED, NOTE_CPU_PAUSED,
+                           NOTE_CPU_RESUMED):
+            names = { NOTE_CPU_STARTED: 'cpu started',
+                      NOTE_CPU_PAUSED: 'cpu paused',
+                      NOTE_CPU_RESUMED: 'cpu resumed' }
+            self.instant(names[note.type], 'cpu', ts, CPU_PID, cpu)
+
+        elif note.type in (NOTE_PREEMPT_LOCK, NOTE_PREEMPT_UNLOCK):
+            count, = struct.unpack_from('<H', note.raw, note.cmnsize)
+            name = 'sched_lock' if note.type == NOTE_PREEMPT_LOCK else \
+                   'sched_unlock'
+            self.instant(name, 'preempt', ts, CPU_PID, cpu,
+                         { 'pid': pid, 'count': count })
+
+        elif note.type in (NOTE_CSECTION_ENTER, NOTE_CSECTION_LEAVE):
+            name = 'csection enter' if note.type == NOTE_CSECTION_ENTER \
+                   else 'csection leave'
+            self.instant(name, 'csection', ts, CPU_PID, cpu, { 'pid': pid })
+
+        elif note.type in (NOTE_SPINLOCK_LOCK, NOTE_SPINLOCK_LOCKED,
+                           NOTE_SPINLOCK_ABORT):
+            # The spinlock address is aligned after the common header
+
+            offset = (note.cmnsize + self.ptrsize - 1) & ~(self.ptrsize - 1)
+            lock = pointer(note, offset, self.ptrsize)
+            key = (cpu, lock)
+
+            if note.type == NOTE_SPINLOCK_LOCK:
+                self.spinning[key] = ts
+            elif key in self.spinning:
+                start = self.spinning.pop(key)
+                result = 'locked' if note.type == NOTE_SPINLOCK_LOCKED \
+                         else 'aborted'
+                self.slice('spin %#x' % lock, 'lock', start, ts, CPU_PID,
+                           cpu, { 'pid': pid, 'result': result })
+
+        elif note.type in (NOTE_IRQ_ENTER, NOTE_IRQ_LEAVE):
+            handler = pointer(note, note.cmnsize, self.ptrsize)
+            irq = ord(note.raw[note.cmnsize + self.ptrsize:
+                               note.cmnsize + self.ptrsize + 1] or b'\0')
+            phase = 'B' if note.type == NOTE_IRQ_ENTER else 'E'
+            self.events.append({ 'name': 'irq %d' % irq, 'cat': 'irq',
+                                 'ph': phase, 'ts': ts, 'pid': CPU_PID,
+                                 'tid': cpu,
+                                 'args': { 'handler': '%#x' % handler } })
+
+    def finish(self):
+        # Close the intervals that were still open at the end of the trace
+
+        if self.events:
+            end = max(e['ts'] for e in self.events)
+            for cpu in list(self.running):
+                self.stop_running(cpu, end)
+
+        meta = [ { 'name': 'process_name', 'ph': 'M', 'pid': CPU_PID,
+                   'args': { 'name': 'CPUs' } },
+                 { 'name': 'process_name', 'ph': 'M', 'pid': TASK_PID,
+                   'args': { 'name': 'Tasks' } } ]
+
+        for cpu in sorted(self.cpus):
+            meta.append({ 'name': 'thread_name', 'ph': 'M', 'pid': CPU_PID,
+                          'tid': cpu, 'args': { 'name': 'CPU%d' % cpu } })
+
+        for pid in sorted(self.tasks):
+            meta.append({ 'name': 'thread_name', 'ph': 'M', 'pid': TASK_PID,
+                          'tid': pid,
+                          'args': { 'name': '%s (%d)' % (self.name(pid),
+                                                         pid) } })
+
+        return { 'traceEvents': meta + self.events,
+                 'displayTimeUnit': 'ns' }
+
+def usage():
+    sys.stderr.write('Usage: %s [-s] [-p ptrsize] [-f freq | -t usec] '
+                     '<note-file> [<json-file>]\n' % sys.argv[0])
+    sys.exit(1)
+
+if __name__ == '__main__':
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], 'sp:f:t:h')
+    except getopt.GetoptError:
+        usage()
+
+    smp = False
+    ptrsize = 4
+    freq = 0
+    usec = 10000
+
+    for opt, value in opts:
+        if opt == '-s':
+            smp = True
+        elif opt == '-p':
+            ptrsize = int(value, 0)
+        elif opt == '-f':
+            freq = int(value, 0)
+        elif opt == '-t':
+            usec = int(value, 0)
+        else:
+            usage()
+
+    if len(args) < 1 or len(args) > 2 or ptrsize not in (4, 8):
+        usage()
+
+    with open(args[0], 'rb') as f:
+        notes = f.read()
+
+    converter = Converter(Timebase(freq, usec), ptrsize)
+    for note in parse(notes, smp, ptrsize):
+        converter.note(note)
+
+    trace = converter.finish()
+
+    if len(args) == 2:
+        with open(args[1], 'w') as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write('\n')
@@ -0,0 +1,270 @@
+#!/usr/bin/env python
+############################################################################
+# tools/notedecode.py
+#
+#   Copyright (C) 2026 agent. All rights reserved.
+#   Author: agent <agent@local>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name NuttX nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+# Decode the binary printf notes (NOTE_BPRINTF) generated by
+# sched_note_bprintf() and by syslog() when CONFIG_SYSLOG_BINARY is
+# selected.  The notes hold only the address of the format string and the
+# raw argument values; the format strings are recovered from the nuttx ELF
+# file.
+#
+# Usage:
+#
+#   notedecode.py [-s] [-b bias] <nuttx-elf> <note-file>
+#
+# Where <note-file> is a copy of the data read from /dev/note and:
+#
+#   -s       The target is an SMP configuration (the common note header
+#            then includes the CPU index).
+#   -b bias  Subtract bias from each format string address before looking
+#            it up in the ELF file.  Needed for position independent
+#            executables such as some simulator builds.
+#
+# Other types of notes are skipped.
+
+import getopt
+import re
+import struct
+import sys
+
+NOTE_BPRINTF = 18
+
+LEVELS = [ "EMERG", "ALERT", "CRIT", "ERR", "WARNING", "NOTICE", "INFO",
+           "DEBUG" ]
+
+# This must match the scan performed by note_bprintf_args() in
+# sched/sched/sched_note.c
+
+CONVERSION = re.compile(r'%([-+ #0-9.*]*)([hlzjtL]*)([a-zA-Z%])')
+
+class ElfImage:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        if self.data[0:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        self.is64 = ord(self.data[4:5]) == 2
+        self.endian = '<' if ord(self.data[5:6]) == 1 else '>'
+        self.ptrsize = 8 if self.is64 else 4
+
+        # Collect the allocated sections that have file content
+
+        if self.is64:
+            shoff, = struct.unpack_from(self.endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH',
+                                                  self.data, 0x3a)
+            shfmt = self.endian + 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(self.endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH',
+                                                  self.data, 0x2e)
+            shfmt = self.endian + 'IIIIII'
+
+        self.sections = []
+        for i in range(shnum):
+            name, type, flags, addr, offset, size = \
+                struct.unpack_from(shfmt, self.data, shoff + i * shentsize)
+
+            # SHF_ALLOC and not SHT_NOBITS
+
+            if (flags & 0x2) != 0 and type != 8 and addr != 0:
+                self.sections.append((addr, offset, size))
+
+    def string(self, addr):
+        for base, offset, size in self.sections:
+            if addr >= base and addr < base + size:
+                start = offset + addr - base
+                end = self.data.index(b'\0', start)
+                return self.data[start:end].decode('latin-1')
+        return None
+
+class ArgReader:
+    def __init__(self, elf, data):
+        self.elf = elf
+        self.data = data
+        self.pos = 0
+
+    def integer(self, size, signed):
+        code = { 4: 'i', 8: 'q' }[size]
+        if not signed:
+            code = code.upper()
+        if self.pos + size > len(self.data):
+            raise IndexError
+        value, = struct.unpack_from(self.elf.endian + code, self.data,
+                                    self.pos)
+        self.pos += size
+        return value
+
+    def double(self):
+        if self.pos + 8 > len(self.data):
+            raise IndexError
+        value, = struct.unpack_from(self.elf.endian + 'd', self.data,
+                                    self.pos)
+        self.pos += 8
+        return value
+
+    def string(self):
+        end = self.data.find(b'\0', self.pos)
+        if end < 0:
+            raise IndexError
+        value = self.data[self.pos:end].decode('latin-1')
+        self.pos = end + 1
+        return value
+
+def format_note(elf, fmt, data):
+    args = ArgReader(elf, data)
+    longsize = elf.ptrsize
+
+    def convert(match):
+        flags, length, conv = match.groups()
+        if conv == '%':
+            return '%'
+
+        try:
+            # A '*' width or precision is passed as an int
+
+            flags = re.sub(r'\*', lambda m: str(args.integer(4, True)), flags)
+
+            if length.count('l') >= 2 or 'j' in length:
+                size = 8
+            elif 'l' in length or 'z' in length or 't' in length:
+                size = longsize
+            else:
+                size = 4
+
+            if conv in 'di':
+                return ('%' + flags + 'd') % args.integer(size, True)
+            elif conv in 'uoxX':
+                pyconv = 'd' if conv == 'u' else conv
+                return ('%' + flags + pyconv) % args.integer(size, False)
+            elif conv == 'c':
+                return ('%' + flags + 'c') % (args.integer(size, False) & 0xff)
+            elif conv == 'p':
+                return '%#x' % args.integer(elf.ptrsize, False)
+            elif conv in 'eEfFgG':
+                return ('%' + flags + conv) % args.double()
+            elif conv in 'aA':
+                return args.double().hex()
+            elif conv == 's':
+                return ('%' + flags + 's') % args.string()
+            elif conv == 'n':
+                return ''
+        except IndexError:
+            pass
+
+        # The argument was not recorded (or the conversion is unsupported)
+
+        return '<?>'
+
+    return CONVERSION.sub(convert, fmt)
+
+def decode(elf, notes, smp, bias):
+    # The common note header:  length, type, priority, [cpu], pid[2],
+    # systime[4]
+
+    cmnsize = 10 if smp else 9
+    pos = 0
+
+    while pos < len(notes):
+        length = ord(notes[pos:pos + 1])
+        if length < cmnsize or pos + length > len(notes):
+            sys.stderr.write('Bad note at offset %d\n' % pos)
+            return
+
+        note = notes[pos:pos + length]
+        pos += length
+
+        if ord(note[1:2]) != NOTE_BPRINTF:
+            continue
+
+        cpu = ord(note[3:4]) if smp else 0
+        pid, systime = struct.unpack_from('<HI', note, cmnsize - 6)
+        level = ord(note[cmnsize:cmnsize + 1])
+        fmtaddr, = struct.unpack_from('<Q' if elf.ptrsize == 8 else '<I',
+                                      note, cmnsize + 1)
+        data = note[cmnsize + 1 + elf.ptrsize:]
+
+        fmt = elf.string(fmtaddr - bias)
+        if fmt is None:
+            text = '<unknown format string at %#x>\n' % fmtaddr
+        else:
+            text = format_note(elf, fmt, data)
+
+        if level < len(LEVELS):
+            levelname = LEVELS[level]
+        else:
+            levelname = str(level)
+
+        prefix = '[%10u] ' % systime
+        if smp:
+            prefix += 'CPU%d ' % cpu
+        prefix += 'pid %d %s: ' % (pid, levelname)
+
+        sys.stdout.write(prefix + text)
+        if not text.endswith('\n'):
+            sys.stdout.write('\n')
+
+def usage():
+    sys.stderr.write('Usage: %s [-s] [-b bias] <nuttx-elf> <note-file>\n' %
+                     sys.argv[0])
+    sys.exit(1)
+
+if __name__ == '__main__':
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], 'sb:h')
+    except getopt.GetoptError:
+        usage()
+
+    smp = False
+    bias = 0
+
+    for opt, value in opts:
+        if opt == '-s':
+            smp = True
+        elif opt == '-b':
+            bias = int(value, 0)
+        else:
+            usage()
+
+    if len(args) != 2:
+        usage()
+
+    elf = ElfImage(args[0])
+    with open(args[1], 'rb') as f:
+        notes = f.read()
+
+    decode(elf, notes, smp, bias)
@@ -0,0 +1,287 @@
+#!/usr/bin/env python
+############################################################################
+# tools/profile.py
+#
+#   Copyright (C) 2026 agent. All rights reserved.
+#   Author: agent <agent@local>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name NuttX nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+# Symbolize the samples collected by the sampling profiler
+# (CONFIG_SCHED_PROFILE) and print a flat profile per function and a
+# summary per task.  Optionally, a gmon.out histogram file is written so
+# that the profile can also be examined with gprof.
+#
+# Usage:
+#
+#   profile.py [-b bias] [-t usec] [-n count] [-g gmon-file] <nuttx-elf>
+#              <sample-file>
+#
+# Where <sample-file> is a copy of the data read from /dev/profile and:
+#
+#   -b bias       Subtract bias from each sampled address before looking it
+#                 up in the ELF file.  Needed for position independent
+#                 executables such as some simulator builds.
+#   -t usec       The sampling period in microseconds (CONFIG_USEC_PER_TICK,
+#                 default 10000).
+#   -n count      Show only the count most frequently sampled functions.
+#   -g gmon-file  Also write a gprof-compatible histogram to gmon-file.
+#                 Use: gprof -p -b nuttx gmon-file
+#
+# The pointer size and byte order of the samples are taken from the ELF
+# file.  Samples contain no call graph, so gprof reports the flat profile
+# only.
+
+import getopt
+import struct
+import sys
+
+STT_FUNC    = 2
+SHT_SYMTAB  = 2
+EM_ARM      = 40
+GMON_TAG_TIME_HIST = 0
+
+class ElfSymbols:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+
+        if data[0:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        self.is64 = ord(data[4:5]) == 2
+        self.endian = '<' if ord(data[5:6]) == 1 else '>'
+        self.ptrsize = 8 if self.is64 else 4
+
+        machine, = struct.unpack_from(self.endian + 'H', data, 0x12)
+
+        if self.is64:
+            shoff, = struct.unpack_from(self.endian + 'Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH',
+                                                  data, 0x3a)
+            shfmt = self.endian + 'IIQQQQII'
+        else:
+            shoff, = struct.unpack_from(self.endian + 'I', data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH',
+                                                  data, 0x2e)
+            shfmt = self.endian + 'IIIIIIII'
+
+        sections = [ struct.unpack_from(shfmt, data, shoff + i * shentsize)
+                     for i in range(shnum) ]
+
+        # Collect the function symbols from the symbol table.  The low bit
+        # of ARM function addresses only marks Thumb code.
+
+        symbols = {}
+        for name, type, flags, addr, offset, size, link, info in sections:
+            if type != SHT_SYMTAB:
+                continue
+
+            stroff = sections[link][4]
+            entsize = 24 if self.is64 else 16
+
+            for pos in range(offset, offset + size, entsize):
+                if self.is64:
+                    stname, stinfo, other, shndx, value, stsize = \
+                        struct.unpack_from(self.endian + 'IBBHQQ', data, pos)
+                else:
+                    stname, value, stsize, stinfo, other, shndx = \
+                        struct.unpack_from(self.endian + 'IIIBBH', data, pos)
+
+                if (stinfo & 0xf) != STT_FUNC or value == 0:
+                    continue
+
+                if machine == EM_ARM:
+                    value &= ~1
+
+                end = data.index(b'\0', stroff + stname)
+                symname = data[stroff + stname:end].decode('latin-1')
+                if value not in symbols or stsize > symbols[value][1]:
+                    symbols[value] = (symname, stsize)
+
+        self.addrs = sorted(symbols)
+        self.symbols = [ (addr,) + symbols[addr] for addr in self.addrs ]
+
+    def lookup(self, addr):
+        # Binary search for the last symbol at or below addr
+
+        lo = 0
+        hi = len(self.addrs)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self.addrs[mid] <= addr:
+                lo = mid + 1
+            else:
+                hi = mid
+
+        if lo == 0:
+            return None
+
+        start, name, size = self.symbols[lo - 1]
+        if size != 0 and addr >= start + size:
+            return None
+        return name
+
+def read_samples(path, elf):
+    size = elf.ptrsize + 3
+    fmt = elf.ptrsize == 8 and '<QHB' or '<IHB'
+
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if len(data) % size != 0:
+        sys.stderr.write('Warning: %d trailing bytes ignored\n' %
+                         (len(data) % size))
+
+    # The samples are always little-endian (see include/nuttx/sched_profile.h)
+
+    return [ struct.unpack_from(fmt, data, pos)
+             for pos in range(0, len(data) - size + 1, size) ]
+
+def write_gmon(path, elf, pcs, usec):
+    # Write a single histogram covering the sampled addresses with four
+    # bytes per bin.
+
+    lowpc = min(pcs) & ~3
+    highpc = (max(pcs) + 4) & ~3
+    nbins = (highpc - lowpc) // 4
+    bins = [0] * nbins
+
+    for pc in pcs:
+        ndx = (pc - lowpc) // 4
+        if bins[ndx] < 0xffff:
+            bins[ndx] += 1
+
+    ptr = elf.ptrsize == 8 and 'Q' or 'I'
+
+    with open(path, 'wb') as f:
+        f.write(b'gmon' + struct.pack(elf.endian + 'I', 1) + b'\0' * 12)
+        f.write(struct.pack(elf.endian + 'B' + ptr + ptr + 'ii',
+                            GMON_TAG_TIME_HIST, lowpc, highpc, nbins,
+                            1000000 // usec))
+        f.write(b'seconds'.ljust(15, b'\0') + b's')
+        f.write(struct.pack(elf.endian + '%dH' % nbins, *bins))
+
+def usage():
+    sys.stderr.write('Usage: %s [-b bias] [-t usec] [-n count] '
+                     '[-g gmon-file] <nuttx-elf> <sample-file>\n' %
+                     sys.argv[0])
+    sys.exit(1)
+
+if __name__ == '__main__':
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], 'b:t:n:g:h')
+    except getopt.GetoptError:
+        usage()
+
+    bias = 0
+    usec = 10000
+    count = 0
+    gmon = None
+
+    for opt, value in opts:
+        if opt == '-b':
+            bias = int(value, 0)
+        elif opt == '-t':
+            usec = int(value, 0)
+        elif opt == '-n':
+            count = int(value, 0)
+        elif opt == '-g':
+            gmon = value
+        else:
+            usage()
+
+    if len(args) != 2 or usec <= 0:
+        usage()
+
+    elf = ElfSymbols(args[0])
+    samples = read_samples(args[1], elf)
+    if not samples:
+        sys.stderr.write('No samples\n')
+        sys.exit(1)
+
+    total = len(samples)
+    funcs = {}
+    tasks = {}
+    cpus = {}
+    pcs = []
+
+    for pc, pid, cpu in samples:
+        pc -= bias
+        pcs.append(pc)
+        name = elf.lookup(pc) or '<unknown>'
+        funcs[name] = funcs.get(name, 0) + 1
+        tasks.setdefault(pid, {})
+        tasks[pid][name] = tasks[pid].get(name, 0) + 1
+        cpus[cpu] = cpus.get(cpu, 0) + 1
+
+    # Flat profile, in the same layout as gprof -p
+
+    print('Flat profile: %d samples, each sample counts as %g seconds.' %
+          (total, usec / 1000000.0))
+    print('')
+    print('  %   cumulative   self')
+    print(' time   seconds   seconds  samples  name')
+
+    cumulative = 0
+    ranked = sorted(funcs.items(), key=lambda item: (-item[1], item[0]))
+    if count > 0:
+        ranked = ranked[:count]
+
+    for name, hits in ranked:
+        cumulative += hits
+        print('%6.2f %9.2f %9.2f %8d  %s' %
+              (100.0 * hits / total, cumulative * usec / 1000000.0,
+               hits * usec / 1000000.0, hits, name))
+
+    # Samples per task, with the function most often seen in each
+
+    print('')
+    print('Per task:')
+    print('')
+    print('  %    samples    pid  top function')
+
+    for pid, names in sorted(tasks.items(),
+                             key=lambda item: -sum(item[1].values())):
+        hits = sum(names.values())
+        top = max(names.items(), key=lambda item: item[1])
+        print('%6.2f %8d %6d  %s (%d)' %
+              (100.0 * hits / total, hits, pid, top[0], top[1]))
+
+    if len(cpus) > 1:
+        print('')
+        print('Per CPU:')
+        print('')
+        for cpu in sorted(cpus):
+            print('  CPU%d: %d samples (%.2f%%)' %
+                  (cpu, cpus[cpu], 100.0 * cpus[cpu] / total))
+
+    if gmon is not None:
+        write_gmon(gmon, elf, pcs, usec)